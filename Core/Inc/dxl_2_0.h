@@ -5,47 +5,136 @@
 #define INC_DXL_2_0_H_
 
 #include "main.h"
+#include "dxl_sched.h"
+#include "dxl_model.h"
+#include "robot_topology.h" // LEG_COUNT, JOINT_COUNT, 모터 ID 배열
 
 // 로봇 시스템 관련 설정값
-#define LEG_COUNT 4      // 다리 개수
 #define MX_DATA_LEN 4    // MX 시리즈 목표 위치 데이터 길이 (4바이트)
 #define AX_DATA_LEN 2    // AX 시리즈 목표 속도 데이터 길이 (2바이트)
+#define JOINT_STATE_LEN 10 // Present Current(2) + Velocity(4) + Position(4)
+#define JOINT_CMD_LEN   14 // Indirect 명령 블록: Goal Position(4) + Profile Velocity(4) + Profile Acceleration(4) + Goal Current(2)
+#define JOINT_BLOCK_LEN 14 // Indirect 상태 블록: 상태(10) + Hardware Error Status(1) + Input Voltage(2) + Temperature(1)
+#define JOINT_CHECK_LEN 7  // 복구 확인 읽기: Torque Enable(64) ~ Hardware Error Status(70)
 
-// 다이나믹셀 프로토콜 2.0 주소 (MX-106, MX-64 관절용)
-enum Dxl_2_0_Addr {
-    DXL_2_Torque_Enable = 64,   // 토크 온/오프 (1: 사용, 0: 해제)
-    DXL_2_LED           = 65,   // LED 제어
-    DXL_2_Goal_Position = 116,  // 목표 위치 제어 (0 ~ 4095)
-};
-
-// 다이나믹셀 프로토콜 1.0 주소 (AX-12 바퀴용)
-enum Dxl_1_0_Addr {
-    DXL_1_Torque_Enable = 24,   // 토크 온/오프
-    DXL_1_LED           = 25,   // LED 제어
-    DXL_1_Goal_Position = 30,   // 위치 제어 시 사용
-    DXL_1_MOVING_SPEED  = 32,   // 바퀴 모드 속도 제어 (0~1023: CCW, 1024~2047: CW)
-};
-
-// 다리별 모터 구성을 관리하는 구조체
+// 4바이트 값이 이보다 작으면 리틀 엔디안 바이트열에 FF FF FD가 나올 수 없음 (바이트 스터핑 불필요)
+#define DXL_STUFF_FREE_LIMIT 0x00FDFFFFu
+
+// Fast Sync Read(0x8A) 사용 여부 (MX 펌웨어 v45 이상 필요, 응답이 없으면 일반 Sync Read로 자동 전환)
+#ifndef DXL_USE_FAST_SYNC_READ
+#define DXL_USE_FAST_SYNC_READ 1
+#endif
+
+// 모터 모델 (컨트롤 테이블 주소/크기는 dxl_model.c 등록부에서 조회)
+// MX-106(고관절)과 MX-64(무릎)는 같은 표를 쓰므로 관절 Sync Write에는 고관절 모델의 항목을 사용
+#define DXL_JOINT_MODEL DXL_MODEL_MX106
+#define DXL_WHEEL_MODEL DXL_MODEL_AX12
+#define DXL_JOINT_ADDR(f) DXL_Model_Addr(DXL_JOINT_MODEL, DXL_FIELD_##f) // 예: DXL_JOINT_ADDR(GOAL_POSITION)
+#define DXL_WHEEL_ADDR(f) DXL_Model_Addr(DXL_WHEEL_MODEL, DXL_FIELD_##f)
+
+#define DXL_DRIVE_MODE_TIME_BASED 0x04 // Drive Mode bit2: Profile Velocity/Acceleration을 시간(ms)으로 해석
+
+// 관절 모터 상태 (Sync Read 응답으로 갱신)
+typedef struct {
+    int32_t position; // Present Position
+    int32_t velocity; // Present Velocity
+    int16_t current;  // Present Current
+    uint8_t error;    // 상태 패킷 Error 필드
+    uint8_t valid;    // 1: 한 번 이상 응답 수신
+    uint8_t hw_error; // Hardware Error Status (진단 슬롯에서 순환 갱신, Indirect 매핑 시 매 주기)
+    uint16_t voltage; // 입력 전압 (0.1V, Indirect 매핑 시에만 갱신)
+    uint8_t temperature; // 온도 (섭씨, Indirect 매핑 시에만 갱신)
+    uint32_t stamp;   // 마지막 갱신 시각 (HAL_GetTick)
+} DXL_Joint_State_t;
+
+// 관절 1개의 복합 명령 (Indirect 매핑 후 Sync Write 1개로 송신)
 typedef struct {
-    uint8_t hip;   // 고관절 모터 ID
-    uint8_t knee;  // 무릎관절 모터 ID
-    uint8_t wheel; // 바퀴 모터 ID
-} LegMotors;
+    uint32_t position;             // Goal Position
+    uint32_t profile_velocity;     // Profile Velocity (0: 최대 속도)
+    uint32_t profile_acceleration; // Profile Acceleration (0: 최대 가속도)
+    int16_t goal_current;          // Goal Current (전류 기반 위치 제어 모드에서 유효)
+} DXL_Joint_Command_t;
 
-// 외부에서 참조할 전역 변수
-extern LegMotors legs[5];
+// 관절 1개의 복구 확인 결과 (진단 슬롯의 확인 읽기/Write 응답으로 갱신)
+typedef struct {
+    uint8_t torque;      // Torque Enable
+    uint8_t hw_error;    // Hardware Error Status
+    uint8_t fresh;       // 1: 마지막 send_joint_check 이후 응답 수신
+    uint8_t write_error; // 1: 마지막 Reboot 이후 Write 응답 Error 필드에 실패 비트가 있었음
+} DXL_Joint_Check_t;
 
 // 모터 제어 및 통신 관련 함수 선언
+void DXL_Init(void); // robot_topology.h 구성으로 Sync Write 패킷 템플릿 생성 (송신 함수 사용 전 1회 호출)
+// (send_sync_* 함수는 송신 큐에 패킷을 추가만 함 - DXL_Bus_Flush() 호출 시 한 버스트로 송신)
 void dxl_torque_set(uint8_t on_hip, uint8_t on_knee, uint8_t on_wheel); // 전체 모터 토크 제어
-void DXL_Emergency_All_Off(void);                                      // 비상 정지 (모든 토크 해제)
-void send_sync_write_1_wheel(int16_t *wheel_speeds);                  // 바퀴 4개 동시 속도 제어
-void send_sync_write_2_joints(uint32_t *hip_pos, uint32_t *knee_pos); // 관절 8개 동시 위치 제어
-void dxl_write_1_0(uint8_t id, uint8_t addr, uint8_t data_len, uint16_t data); // 개별 AX-12 제어
+void DXL_Emergency_All_Off(void);                                      // 비상 정지 (모든 토크 해제, dxl_estop 잠금)
+uint16_t DXL_Build_Torque_Off_Frames(uint8_t *buf, uint16_t max);     // 비상 정지용 토크 OFF 패킷 (관절 2.0 + 바퀴 1.0)
+void send_sync_write_1_wheel(int16_t *wheel_speeds);                  // 바퀴 전체 동시 속도 제어
+void send_sync_write_joints(const uint32_t *goals);                   // 관절 전체 동시 위치 제어 (관절 인덱스 순서)
+void send_sync_torque_mx(uint8_t on_off);                             // 관절 전체 토크 ON/OFF
+void send_sync_write_joints_subset(const uint8_t *joints, const uint32_t *pos, uint8_t count); // 일부 관절 위치
+void send_sync_write_wheels_subset(const uint8_t *wheels, const int16_t *speeds, uint8_t count); // 일부 바퀴 속도
+void send_sync_torque_ax(uint8_t on_off);                             // 바퀴 전체 토크 ON/OFF
 uint16_t clc_speed_1(int16_t wheel_speed);                            // 바퀴 속도 값 변환 함수
 
+// 관절 상태 피드백 (Sync Read / Fast Sync Read)
+void send_sync_read_joint_state(void);       // 관절 전체 상태 읽기 요청을 송신 큐에 추가
+uint8_t DXL_Poll_Joint_State(void);          // 수신된 응답을 해석하여 상태 배열 갱신 (갱신된 관절 수 반환)
+const DXL_Joint_State_t* DXL_Get_Joint_State(uint8_t joint); // joint: 관절 인덱스 (robot_topology.h)
+uint8_t DXL_Is_Fast_Sync_Read(void);         // 1: Fast Sync Read 사용 중
+void send_diag_read_next(void);              // 관절 1개씩 돌아가며 Hardware Error Status 읽기 요청
+
+// Indirect Address 매핑 (부팅 시 토크 OFF 상태에서 1회, 성공하면 상태 읽기도 확장 블록으로 전환)
+HAL_StatusTypeDef DXL_Indirect_Setup(void);
+uint8_t DXL_Indirect_Is_Ready(void);
+void send_sync_write_joint_commands(const DXL_Joint_Command_t *cmd); // 관절 전체 위치+프로파일+전류 Sync Write 1개
+void send_sync_write_joint_commands_subset(const uint8_t *joints, const DXL_Joint_Command_t *cmd, uint8_t count);
+const DXL_Joint_Command_t* DXL_Get_Joint_Boot_Command(uint8_t joint); // 매핑 시 모터에서 읽은 프로파일/전류 초기값
+
+// 프로파일 (Indirect 매핑이 없을 때 프로파일만 따로 송신) 및 Drive Mode (부팅 설정용, 토크 OFF 상태에서 호출)
+void send_sync_write_joint_profiles_subset(const uint8_t *joints, const DXL_Joint_Command_t *cmd, uint8_t count);
+HAL_StatusTypeDef DXL_Set_Drive_Mode(uint8_t time_based); // 1: 시간 기준 프로파일, 0: 속도 기준 프로파일
+
+// 하드웨어 오류 복구용 (dxl_recovery가 진단 슬롯에서 요청 1개씩 송신 큐에 추가, 응답은 DXL_Poll_Joint_State에서 해석)
+void DXL_Set_Joint_Read_Mask(uint8_t mask); // 상태 읽기/진단 대상 관절 (비트 j = 관절 j, 복구 중인 관절 제외용)
+uint8_t DXL_Get_Joint_Read_Mask(void);
+HAL_StatusTypeDef send_joint_reboot(uint8_t joint);                 // Reboot(0x08)
+HAL_StatusTypeDef send_joint_indirect_map(uint8_t joint, uint8_t block); // Indirect Address 재설정 (0: 명령, 1: 상태 블록)
+HAL_StatusTypeDef send_joint_torque(uint8_t joint, uint8_t on);     // 관절 1개 토크 ON/OFF (응답 확인용 단일 Write)
+HAL_StatusTypeDef send_joint_check(uint8_t joint);                  // Torque Enable ~ Hardware Error Status 읽기
+const DXL_Joint_Check_t* DXL_Get_Joint_Check(uint8_t joint);
+
+// 진단 스윕용 (dxl_diag가 채움 슬롯에서 요청 1개씩 송신 큐에 추가, 응답은 DXL_Poll_Joint_State에서 DXL_Diag_Store로 전달)
+HAL_StatusTypeDef send_sweep_read_joints(uint16_t addr, uint16_t len); // 상태 읽기 대상 관절 전체 Sync Read
+HAL_StatusTypeDef send_sweep_read_wheel(uint8_t wheel, uint8_t addr, uint8_t len, uint32_t window_us); // 바퀴 1개 Read
+
+// 등록부 기반 범용 Sync Write / Sync Read (항목 크기와 프로토콜은 모델 표에서 결정)
+// sync_write: 송신 큐에 추가만 함 (DXL_Bus_Flush 시 송신), values는 원시값
+// sync_read: 응답까지 대기 (부팅 설정용), 1.0 모델은 Sync Read가 없으므로 모터마다 Read
+HAL_StatusTypeDef dxl_sync_write(DXL_Model_t model, DXL_Field_t field, const uint8_t *ids,
+        const int32_t *values, uint8_t count);
+HAL_StatusTypeDef dxl_sync_read(DXL_Model_t model, DXL_Field_t field, const uint8_t *ids,
+        uint8_t count, int32_t *values);
+
+// 단일 모터 요청/응답 (응답까지 대기하는 함수 - 부팅 설정용, 버스 스케줄러 실행 중에는 사용 금지)
+HAL_StatusTypeDef dxl_ping_2_0(uint8_t id, uint16_t *model);
+uint8_t dxl_broadcast_ping_2_0(const uint8_t *wait_ids, uint8_t wait_count, uint8_t *ids,
+        uint16_t *models, uint8_t max); // 응답한 모터 수 반환 (wait_ids가 모두 응답하면 바로 종료)
+HAL_StatusTypeDef dxl_read_2_0(uint8_t id, uint16_t addr, uint8_t *data, uint16_t len);
+HAL_StatusTypeDef dxl_write_2_0(uint8_t id, uint16_t addr, const uint8_t *data, uint16_t len);
+HAL_StatusTypeDef dxl_ping_1_0(uint8_t id);
+HAL_StatusTypeDef dxl_read_1_0(uint8_t id, uint8_t addr, uint8_t *data, uint8_t len);
+HAL_StatusTypeDef dxl_write_1_0(uint8_t id, uint8_t addr, uint8_t data_len, uint16_t data); // 개별 AX-12 제어
+
+// 버스 스케줄러용 슬롯 비용 (패킷 길이, 응답 수)
+DXL_Frame_Cost_t DXL_Get_Joint_Write_Cost(void);
+DXL_Frame_Cost_t DXL_Get_Wheel_Write_Cost(void);
+DXL_Frame_Cost_t DXL_Get_Joint_Read_Cost(void);
+DXL_Frame_Cost_t DXL_Get_Diag_Cost(void);
+
 // 통신 프로토콜 무결성 검사 함수
 unsigned short update_crc(unsigned short crc_accum, unsigned char *data_blk_ptr, unsigned short data_blk_size);
 uint8_t calculate_checksum_1_0(uint8_t *data, uint16_t length);
+uint16_t dxl_stuff_copy(uint8_t *dst, const uint8_t *src, uint16_t len); // 2.0 바이트 스터핑 복사
 
 #endif
@@ -0,0 +1,105 @@
+/*
+ * dxl_bus.h
+ * Description: 다이나믹셀 RS-485 버스(USART3) 비동기 송신 엔진
+ * DMA로 패킷을 내보내고, USART TC 인터럽트에서 RS-485 방향 핀을 수신 모드로 되돌림
+ * 수정사항: 여러 패킷을 슬롯에 쌓아두었다가 한 번의 DMA 버스트로 연속 송신하는 큐 추가
+ * 수정사항: RX DMA 순환 버퍼로 모터 상태 패킷 수신 (DMA 쓰기 위치 기준으로 새 바이트만 읽음)
+ * 수정사항: 비상 정지 송신 (DMA 중단 후 CPU가 직접 송신, 이후 큐 송신 잠금)
+ */
+
+#ifndef INC_DXL_BUS_H_
+#define INC_DXL_BUS_H_
+
+#include "main.h"
+
+#define DXL_BUS_BANK_SIZE   256 // 버스트 1회 분량 버퍼 크기 (관절+바퀴 Sync Write 합계의 여유분)
+#define DXL_BUS_MAX_SLOTS   8   // 버스트 1회에 담을 수 있는 최대 패킷 수
+#define DXL_BUS_TIMEOUT_MS  5   // 버스 유휴 대기 최대 시간 (1Mbps 기준 256바이트 = 약 2.6ms)
+#define DXL_BUS_RX_RING_SIZE 512 // RX DMA 순환 버퍼 크기 (1Mbps 기준 약 5ms 분량)
+#define DXL_BUS_BAUD_TOL_PERMILLE 20 // 보레이트 변경 시 허용 오차 (2%)
+
+// 버스 송신 상태
+typedef enum {
+	DXL_BUS_IDLE = 0, // 송신 완료, 방향 핀 수신 모드
+	DXL_BUS_BUSY,     // DMA 송신 중 (방향 핀 송신 모드)
+	DXL_BUS_ERROR     // UART/DMA 오류 발생 (다음 송신 시 자동 복구)
+} DXL_Bus_State_t;
+
+// 송신 완료 알림 콜백 (ISR 컨텍스트에서 호출 - 가볍게 유지)
+typedef void (*DXL_Bus_TxDone_Cb)(void);
+
+// 송신 통계 (디버깅 모니터링용)
+typedef struct {
+	uint32_t tx_frames;   // 송신 완료된 패킷 수
+	uint32_t tx_bursts;   // 송신 완료된 버스트 수 (방향 핀 전환 횟수)
+	uint32_t tx_bytes;    // 송신 완료된 바이트 수
+	uint32_t tx_errors;   // UART/DMA 오류 횟수
+	uint32_t tx_timeouts; // 유휴 대기 시간 초과 횟수
+	uint32_t tx_dropped;  // 슬롯 부족으로 버려진 패킷 수
+	uint32_t rx_bytes;    // 수신 후 소비된 바이트 수
+	uint32_t rx_errors;   // 수신 오류(노이즈/프레이밍/오버런) 횟수
+	uint32_t estop_blocked; // 비상 정지 잠금 중 버려진 송신 요청 수
+} DXL_Bus_Stats_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 버스 초기화: 사용할 UART 핸들 등록 (TX DMA가 링크되어 있어야 함)
+void DXL_Bus_Init(UART_HandleTypeDef *huart);
+
+// [큐] 슬롯 확보: 최대 max_size 바이트를 직접 쓸 수 있는 버퍼 포인터 반환 (실패 시 NULL)
+uint8_t* DXL_Bus_Slot_Acquire(uint16_t max_size);
+
+// [큐] 슬롯 확정: Acquire로 받은 버퍼에 실제로 쓴 길이를 등록
+void DXL_Bus_Slot_Commit(uint16_t size);
+
+// [큐] 완성된 패킷을 복사하여 슬롯에 추가 (송신은 Flush 시점에 시작)
+HAL_StatusTypeDef DXL_Bus_Enqueue(const uint8_t *data, uint16_t size);
+
+// [큐] 쌓인 패킷들을 하나의 버스트로 송신 시작 (송신 중이면 끝나는 즉시 이어서 송신)
+HAL_StatusTypeDef DXL_Bus_Flush(void);
+
+// 패킷 1개 즉시 송신 (Enqueue + Flush)
+HAL_StatusTypeDef DXL_Bus_Transmit(const uint8_t *data, uint16_t size);
+
+// 쌓인 패킷이 모두 송신될 때까지 대기 (ISR 안에서 호출되어도 동작)
+HAL_StatusTypeDef DXL_Bus_Wait_Idle(uint32_t timeout_ms);
+
+// 현재 송신 상태 조회
+DXL_Bus_State_t DXL_Bus_Get_State(void);
+uint8_t DXL_Bus_Is_Busy(void);
+
+// 송신 완료 콜백 등록 (버스트마다 호출, NULL이면 해제)
+void DXL_Bus_Set_TxDone_Callback(DXL_Bus_TxDone_Cb cb);
+
+// 송신 통계 조회
+DXL_Bus_Stats_t DXL_Bus_Get_Stats(void);
+
+// 현재 버스 보레이트 조회 (초기화 전이면 0)
+uint32_t DXL_Bus_Get_Baud(void);
+
+// 보레이트 변경 (송신 완료 대기 후 UART 재설정, 수신 버퍼는 비워짐)
+HAL_StatusTypeDef DXL_Bus_Set_Baud(uint32_t baud);
+
+// 현재 UART 클럭으로 허용 오차 안에서 낼 수 있는 보레이트인지 확인
+uint8_t DXL_Bus_Baud_Supported(uint32_t baud);
+
+// [비상 정지] 송신 중인 DMA를 끊고, 선로에 나가던 패킷의 나머지와 frames를 CPU가 직접 송신 (ISR에서 호출 가능)
+// 이후에는 큐 송신을 모두 막음 (해제 없음 - 리셋으로만 복귀). 소요 시간 = 끊긴 패킷의 나머지 + frames의 선로 시간
+// tail: 마무리한 끊긴 패킷의 바이트 수 (NULL 가능)
+HAL_StatusTypeDef DXL_Bus_Estop(const uint8_t *frames, uint16_t len, uint16_t *tail);
+uint8_t DXL_Bus_Is_Estopped(void);
+
+// [수신] 아직 읽지 않은 연속 구간의 시작 포인터와 길이 반환 (복사 없음, 끝에서 잘리면 두 번 호출)
+uint16_t DXL_Bus_Rx_Peek(const uint8_t **data);
+
+// [수신] Peek로 확인한 바이트 중 n바이트 소비
+void DXL_Bus_Rx_Consume(uint16_t n);
+
+// [수신] 지금까지 들어온 바이트를 모두 버림
+void DXL_Bus_Rx_Discard(void);
+
+// [인터럽트] HAL_UART_TxCpltCallback / HAL_UART_ErrorCallback에서 호출
+void DXL_Bus_TxCplt_Callback(void);
+void DXL_Bus_Error_Callback(void);
+
+#endif /* INC_DXL_BUS_H_ */
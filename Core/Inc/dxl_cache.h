@@ -0,0 +1,52 @@
+/*
+ * dxl_cache.h
+ * Description: 모터 명령 캐시 (제어기와 dxl_2_0 사이)
+ * 모터별로 마지막으로 송신한 값을 기억하고, 불감대 안의 변화는 건너뛰어
+ * 값이 바뀐 모터만 담은 Sync Write를 만듦 (일정 주기마다 전체 재송신)
+ * 수정사항: 관절 프로파일 속도/가속도를 함께 관리 (Indirect 매핑 시 위치와 한 Sync Write로 송신)
+ * 수정사항: 관절별 송신 제외/복귀 (하드웨어 오류 복구 중인 관절은 Sync Write에서 뺌)
+ */
+
+#ifndef INC_DXL_CACHE_H_
+#define INC_DXL_CACHE_H_
+
+#include "main.h"
+
+#define DXL_CACHE_POS_DEADBAND   1   // 관절 목표 위치 불감대 (틱, 1틱 = 0.088도)
+#define DXL_CACHE_SPEED_DEADBAND 0   // 바퀴 속도 불감대 (0 = 값이 같을 때만 생략)
+#define DXL_CACHE_REFRESH_MS     200 // 값이 그대로여도 이 시간이 지나면 다시 송신 (모터 재부팅/노이즈 대비)
+
+// 캐시 통계 (디버깅 모니터링용)
+typedef struct {
+	uint32_t frames_sent;    // 송신한 Sync Write 수
+	uint32_t frames_skipped; // 바뀐 모터가 없어 통째로 생략한 Sync Write 수
+	uint32_t motors_sent;    // Sync Write에 담긴 모터 항목 수
+	uint32_t motors_skipped; // 생략한 모터 항목 수
+	uint32_t bytes_sent;     // 송신한 바이트 (스터핑 제외)
+	uint32_t bytes_saved;    // 전체 Sync Write 대비 절약한 바이트
+	uint32_t refreshes;      // 주기적 재송신으로 포함된 모터 항목 수
+	uint32_t invalidations;  // 버스 송신 오류로 캐시를 비운 횟수
+} DXL_Cache_Stats_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 캐시 비우기 (다음 쓰기 때 모든 모터 송신 - 모터 재부팅, 토크 재설정 후 호출)
+void DXL_Cache_Invalidate(void);
+
+// 관절 전체 목표 위치 (관절 인덱스 순 배열): 바뀐 관절만 Sync Write 큐에 추가
+void DXL_Cache_Write_Joints(const uint32_t *goals);
+
+// 관절 프로파일 설정 (joint >= JOINT_COUNT이면 전체, 다음 관절 쓰기 때 바뀐 관절에 함께 송신)
+// Drive Mode가 시간 기준이면 velocity = 이동 시간(ms), acceleration = 가속 시간(ms)
+void DXL_Cache_Set_Joint_Profile(uint8_t joint, uint32_t velocity, uint32_t acceleration);
+
+// 관절을 Sync Write에서 제외(0)/복귀(1) - 복귀 시 다음 관절 쓰기 때 위치와 프로파일을 다시 송신
+void DXL_Cache_Set_Joint_Active(uint8_t joint, uint8_t active);
+
+// 바퀴 전체 목표 속도 (다리 순): 바뀐 바퀴만 Sync Write 큐에 추가
+void DXL_Cache_Write_Wheels(const int16_t *wheel_speeds);
+
+// 통계 조회
+DXL_Cache_Stats_t DXL_Cache_Get_Stats(void);
+
+#endif /* INC_DXL_CACHE_H_ */
@@ -0,0 +1,61 @@
+/*
+ * dxl_crc.h
+ * Description: 다이나믹셀 프로토콜 2.0 CRC16 (다항식 0x8005, 초기값 0, 비반사) 계산 모듈
+ * 테이블은 다항식으로부터 컴파일 시점에 생성되므로 손으로 붙여넣은 값이 없음
+ * 수정사항: STM32H7 CRC 주변장치 백엔드 추가 (사용 중이면 소프트웨어 테이블로 대체)
+ */
+
+#ifndef INC_DXL_CRC_H_
+#define INC_DXL_CRC_H_
+
+#include "main.h"
+
+#define DXL_CRC_POLY 0x8005u // DYNAMIXEL 2.0 CRC16 다항식
+
+// CRC 계산 백엔드
+typedef enum {
+	DXL_CRC_BACKEND_SW = 0, // 소프트웨어 slice-by-8
+	DXL_CRC_BACKEND_HW      // CRC 주변장치 (자체 검증 통과 시)
+} DXL_CRC_Backend_t;
+
+// 백엔드 사용 통계
+typedef struct {
+	uint32_t hw_calls;     // 주변장치로 계산한 횟수
+	uint32_t sw_fallbacks; // 주변장치 사용 중(또는 자체 검증 실패)이라 소프트웨어로 대체한 횟수
+} DXL_CRC_Stats_t;
+
+// 슬라이스 테이블: dxl_crc_table[k][v] = 바이트 v 뒤에 0x00이 k개 이어질 때의 CRC
+extern const uint16_t dxl_crc_table[8][256];
+
+// CRC 엔진별 벤치마크 결과 (패킷 1개당 CPU 사이클)
+typedef struct {
+	uint16_t frame_len;      // 측정에 사용한 패킷 길이 (관절 8개 Sync Write 기준)
+	uint32_t cycles_byte;    // 바이트 단위 테이블 조회
+	uint32_t cycles_slice4;  // slice-by-4
+	uint32_t cycles_slice8;  // slice-by-8
+	uint32_t cycles_hw;      // CRC 주변장치 (백엔드가 SW이면 0)
+	uint8_t match;           // 1: 모든 엔진의 결과가 같음
+} DXL_CRC_Bench_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// CRC 주변장치 초기화 및 소프트웨어 엔진과의 일치 여부 자체 검증
+DXL_CRC_Backend_t DXL_CRC_Init(void);
+DXL_CRC_Backend_t DXL_CRC_Get_Backend(void);
+DXL_CRC_Stats_t DXL_CRC_Get_Stats(void);
+
+// 기본 CRC 계산 (주변장치가 사용 가능하면 하드웨어, 아니면 slice-by-8)
+uint16_t DXL_CRC_Update(uint16_t crc, const uint8_t *data, uint16_t len);
+
+// CRC 주변장치로 계산 (사용 중이면 소프트웨어로 대체)
+uint16_t DXL_CRC_HW_Update(uint16_t crc, const uint8_t *data, uint16_t len);
+
+// 엔진별 CRC 계산 (결과는 모두 동일)
+uint16_t DXL_CRC_Update_Byte(uint16_t crc, const uint8_t *data, uint16_t len);
+uint16_t DXL_CRC_Update_Slice4(uint16_t crc, const uint8_t *data, uint16_t len);
+uint16_t DXL_CRC_Update_Slice8(uint16_t crc, const uint8_t *data, uint16_t len);
+
+// DWT 사이클 카운터로 엔진별 속도 측정 (iterations회 평균, Debug 빌드는 부팅 시 main.c가 호출 -> crc_bench)
+void DXL_CRC_Benchmark(DXL_CRC_Bench_t *result, uint32_t iterations);
+
+#endif /* INC_DXL_CRC_H_ */
@@ -0,0 +1,69 @@
+/*
+ * dxl_diag.h
+ * Description: 모터 전체 진단 표 (온도, 입력 전압, 부하, Moving/Moving Status, 하드웨어 오류)와 항목별 갱신 시각
+ * 버스 스케줄러의 채움 슬롯(고정 슬롯이 쓰고 남은 버스 시간)에서 요청을 1개씩 보내 표를 순환 갱신하므로
+ * 제어 패킷을 밀어내지 않고, 로봇을 세우고 PC 도구를 버스에 연결하지 않아도 상태를 볼 수 있음
+ * Note: 관절은 항목 묶음마다 Sync Read 1개, 바퀴(AX-12, 프로토콜 1.0)는 Sync Read가 없어 모터마다 Read 1개
+ *       매 주기 상태 읽기에 이미 들어 있는 항목(관절 전류, Indirect 매핑 시 오류/전압/온도)은 버스를 쓰지 않고 복사
+ */
+
+#ifndef INC_DXL_DIAG_H_
+#define INC_DXL_DIAG_H_
+
+#include "main.h"
+#include "dxl_sched.h"
+#include "robot_topology.h"
+
+#define DXL_DIAG_MOTORS (JOINT_COUNT + LEG_COUNT) // 관절 인덱스 순서 다음 바퀴 순서 (dxl_health와 같음)
+#define DXL_DIAG_NEVER  0xFFFFFFFFu               // DXL_Diag_Age_Ms(): 아직 읽지 못한 항목
+
+// 진단 항목 (갱신 시각 배열 인덱스)
+typedef enum {
+	DXL_DIAG_TEMPERATURE = 0,
+	DXL_DIAG_VOLTAGE,
+	DXL_DIAG_LOAD,
+	DXL_DIAG_MOVING,   // Moving + Moving Status
+	DXL_DIAG_HW_ERROR,
+	DXL_DIAG_ITEM_COUNT
+} DXL_Diag_Item_t;
+
+// 모터 1개의 진단 값 (디버깅 모니터링 / 텔레메트리용)
+typedef struct {
+	uint8_t id;            // 모터 ID
+	uint8_t temperature;   // 온도 (섭씨)
+	uint16_t voltage;      // 입력 전압 (0.1V)
+	int16_t load;          // 관절: Present Current 원시값 (3.36mA), 바퀴: Present Load (0.1%, 부호 = 방향)
+	uint8_t moving;        // Moving (1: 이동 중)
+	uint8_t moving_status; // Moving Status (관절만, 바퀴는 0)
+	uint8_t hw_error;      // 관절: Hardware Error Status, 바퀴: 상태 패킷 Error의 하드웨어 오류 비트
+	uint8_t valid;         // 비트 k: 항목 k(DXL_Diag_Item_t)를 한 번 이상 읽음
+	uint32_t stamp[DXL_DIAG_ITEM_COUNT]; // 항목별 마지막 갱신 시각 (HAL_GetTick)
+} DXL_Diag_Motor_t;
+
+// 스윕 진행 상태 (채움 슬롯 실행/미룸 횟수는 DXL_Sched_Get_Report()의 fill_runs/fill_deferred)
+typedef struct {
+	uint32_t requests; // 송신한 스윕 요청 수
+	uint32_t rounds;   // 모든 단계를 한 바퀴 돈 횟수
+	uint32_t round_ms; // 마지막 한 바퀴에 걸린 시간
+	uint8_t step;      // 다음 단계 (관절 묶음 3개 다음 바퀴 순서)
+} DXL_Diag_Report_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 표 초기화 (DXL_Init 이후 호출)
+void DXL_Diag_Init(void);
+
+// 채움 슬롯 함수/비용 (DXL_Sched_Set_Fill에 등록)
+void DXL_Diag_Sweep_Slot(void);
+DXL_Frame_Cost_t DXL_Diag_Sweep_Cost(void);
+
+// 스윕 응답 기록 (DXL_Poll_Joint_State에서 호출, motor: 진단 표 인덱스)
+// error: 관절은 상태 패킷 Error 필드, 바퀴는 Error의 하드웨어 오류 비트
+void DXL_Diag_Store(uint8_t motor, uint8_t error, const uint8_t *data, uint16_t len);
+
+// 조회 (motor: 0 ~ DXL_DIAG_MOTORS-1, 범위 밖이면 NULL / DXL_DIAG_NEVER)
+const DXL_Diag_Motor_t* DXL_Diag_Get(uint8_t motor);
+uint32_t DXL_Diag_Age_Ms(uint8_t motor, DXL_Diag_Item_t item);
+const DXL_Diag_Report_t* DXL_Diag_Get_Report(void);
+
+#endif /* INC_DXL_DIAG_H_ */
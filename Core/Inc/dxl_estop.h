@@ -0,0 +1,49 @@
+/*
+ * dxl_estop.h
+ * Description: 모터 버스 비상 정지 (버튼 EXTI 인터럽트에서 호출)
+ * 부팅 시 만들어 둔 토크 OFF 패킷(관절 2.0 + 바퀴 1.0 Sync Write)을 송신 큐를 거치지 않고
+ * 송신 중인 DMA를 끊은 뒤 바로 내보내고, 정지 상태를 잠가 이후 제어 루프의 송신을 막음
+ * Note: 소요 시간 상한 = 끊긴 패킷의 나머지(최대 관절 쓰기 1개) + 토크 OFF 패킷의 선로 시간
+ *       HAL_Delay/HAL_GetTick을 쓰지 않으므로 SysTick과 같은 우선순위의 ISR에서도 멈추지 않음
+ */
+
+#ifndef INC_DXL_ESTOP_H_
+#define INC_DXL_ESTOP_H_
+
+#include "main.h"
+
+#define DXL_ESTOP_FRAME_MAX  64  // 토크 OFF 패킷 버퍼 (관절 8개 2.0 30바이트 + 바퀴 4개 1.0 16바이트)
+#define DXL_ESTOP_RESENDS    3   // 잠금 후 제어 루프에서 토크 OFF를 다시 보내는 횟수 (첫 송신을 놓친 모터 대비)
+#define DXL_ESTOP_RESEND_MS  20  // 재송신 간격
+
+// 비상 정지 결과 (디버깅 모니터링용)
+typedef struct {
+	uint8_t latched;        // 1: 정지 잠금 (리셋 전까지 유지)
+	uint16_t frame_len;     // 토크 OFF 패킷 길이 합계
+	uint32_t triggers;      // 트리거 횟수 (잠금 후 다시 눌린 것 포함)
+	uint32_t resends;       // 제어 루프에서 다시 보낸 횟수
+	uint32_t failures;      // 송신 대기 시간 초과 (UART가 응답하지 않음)
+	uint16_t tail_bytes;    // 첫 송신 때 마무리한 끊긴 패킷의 바이트 수
+	uint32_t latency_us;    // 첫 송신의 버튼 인터럽트 진입 ~ 마지막 바이트 송신 완료 시간
+	uint32_t latency_max_us; // 측정한 최대 시간 (재송신 포함)
+	uint32_t bound_us;      // 현재 보레이트 기준 최악 시간 (끊긴 관절 쓰기 전체 + 토크 OFF 패킷 + 여유)
+} DXL_Estop_Report_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 토크 OFF 패킷 생성 (DXL_Init 이후, 보레이트가 바뀌면 상한 계산을 위해 다시 호출)
+HAL_StatusTypeDef DXL_Estop_Init(void);
+
+// [인터럽트] 비상 정지: DMA 중단 후 토크 OFF 송신, 잠금 (ISR/메인 루프 어디서나 호출 가능)
+void DXL_Estop_Trigger(void);
+
+// 잠금 여부 (1이면 제어 루프는 버스 슬롯을 실행하지 않음)
+uint8_t DXL_Estop_Is_Latched(void);
+
+// 잠금 중 제어 주기마다 호출: DXL_ESTOP_RESENDS회까지 토크 OFF 재송신
+void DXL_Estop_Service(void);
+
+// 결과 조회
+const DXL_Estop_Report_t* DXL_Estop_Get_Report(void);
+
+#endif /* INC_DXL_ESTOP_H_ */
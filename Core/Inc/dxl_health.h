@@ -0,0 +1,69 @@
+/*
+ * dxl_health.h
+ * Description: 모터별 버스 상태 카운터 (송신 패킷, 응답, CRC/체크섬 오류, 응답 없음, 하드웨어 오류)와
+ * 응답 지연 log2 히스토그램 (DWT 사이클 카운터 기준)
+ * 선로 불량이나 특정 모터 때문에 제어 주기가 늘어나는 경우 어느 ID가 원인인지 찾는 용도
+ * Note: 갱신 함수는 제어 주기마다 호출되므로 나눗셈 없이 증가/비트 연산만 사용함 (항상 켜둠)
+ *       ID -> 항목 변환은 256바이트 표 조회, 히스토그램 구간은 __CLZ 1회로 계산
+ */
+
+#ifndef INC_DXL_HEALTH_H_
+#define INC_DXL_HEALTH_H_
+
+#include "main.h"
+#include "robot_topology.h"
+
+#define DXL_HEALTH_MAX_MOTORS (JOINT_COUNT + LEG_COUNT) // 관절 인덱스 순서 다음 바퀴 순서
+#define DXL_HEALTH_HIST_BINS  16 // 응답 지연 히스토그램 구간 수
+#define DXL_HEALTH_HIST_SHIFT 8  // 구간 k: 2^(k-1+SHIFT) ~ 2^(k+SHIFT) 사이클 미만 (구간 0: 2^SHIFT 미만)
+
+// 모터 1개의 버스 상태 (디버깅 모니터링 / 텔레메트리용)
+typedef struct {
+	uint8_t id;              // 모터 ID
+	uint8_t hw_error_bits;   // 지금까지 관측한 Hardware Error Status 비트 누적 (OR)
+	uint8_t last_error;      // 마지막 상태 패킷 Error 필드
+	uint32_t frames_sent;    // 이 모터가 포함된 송신 패킷 수 (Sync Write/Read 요청, 단일 요청)
+	uint32_t replies;        // 정상 수신한 응답 수 (Fast Sync Read는 항목 1개 = 응답 1개)
+	uint32_t crc_errors;     // 이 ID로 받은 패킷 중 CRC(2.0)/체크섬(1.0) 불일치 수
+	uint32_t timeouts;       // 응답을 요청했지만 다음 요청 전까지 응답이 없던 횟수
+	uint32_t status_errors;  // Error 필드 bit0~6이 켜진 응답 수 (명령 처리 실패)
+	uint32_t alerts;         // Error 필드 bit7(Alert, 하드웨어 오류 발생 중)이 켜진 응답 수
+	uint32_t latency_max;    // 최대 응답 지연 (사이클)
+	uint32_t latency_hist[DXL_HEALTH_HIST_BINS]; // 응답 지연 분포 (요청을 큐에 넣은 시각부터 응답 해석까지)
+} DXL_Health_t;
+
+// 특정 모터로 돌릴 수 없는 이벤트
+typedef struct {
+	uint32_t unknown_replies; // 구성 표에 없는 ID의 응답 수
+	uint32_t unknown_crc;     // ID를 알 수 없는 CRC 오류 수 (Fast Sync Read 통합 응답 등)
+} DXL_Health_Bus_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 구성 표(robot_topology)로 ID -> 항목 표 생성 (DXL_Init에서 호출)
+void DXL_Health_Init(void);
+
+// 현재 시각 (DWT 사이클) - 요청 송신 시 기록해 두었다가 응답 시 지연 계산에 사용
+static inline uint32_t DXL_Health_Now(void) {
+	return DWT->CYCCNT;
+}
+
+// [갱신] 패킷 송신 / 응답 수신 / CRC 오류 / 응답 없음 / Hardware Error Status 관측
+void DXL_Health_Sent(uint8_t id);
+void DXL_Health_Reply(uint8_t id, uint8_t error, uint32_t request_stamp);
+void DXL_Health_Crc_Error(uint8_t id);
+void DXL_Health_Timeout(uint8_t id);
+void DXL_Health_Hw_Error(uint8_t id, uint8_t hw_error_status);
+
+// [조회] ID 또는 항목 번호(0 ~ DXL_HEALTH_MAX_MOTORS-1)로 조회 (없으면 NULL)
+const DXL_Health_t* DXL_Health_Get(uint8_t id);
+const DXL_Health_t* DXL_Health_Get_Index(uint8_t index);
+const DXL_Health_Bus_t* DXL_Health_Get_Bus(void);
+
+// 히스토그램 구간 상한 (us, 표시용 - 나눗셈 사용, 마지막 구간은 그 이상 전부 포함)
+uint32_t DXL_Health_Bin_Upper_Us(uint8_t bin);
+
+// 모든 카운터 초기화 (ID 표는 유지)
+void DXL_Health_Clear(void);
+
+#endif /* INC_DXL_HEALTH_H_ */
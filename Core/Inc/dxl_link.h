@@ -0,0 +1,75 @@
+/*
+ * dxl_link.h
+ * Description: 다이나믹셀 버스 링크 설정 (부팅 시 1회)
+ * robot_topology 표의 모든 모터에 Ping을 보내 응답을 확인하고, Return Delay Time을 줄인 뒤
+ * 버스에 있는 모든 모터가 지원하면 보레이트를 올리고 USART3를 맞춰 재설정함
+ * 수정사항: 부팅 시 고정 대기(HAL_Delay) 대신 모든 모터가 응답할 때까지만 기다리는 탐색 단계 추가
+ *          (2.0 브로드캐스트 Ping 1회 + AX 바퀴 1.0 모델 번호 읽기), 토크 ON 확인 대기
+ * 수정사항: 링크 설정에 탐색 결과를 넘겨 이미 응답을 확인한 모터는 Ping 생략
+ */
+
+#ifndef INC_DXL_LINK_H_
+#define INC_DXL_LINK_H_
+
+#include "main.h"
+#include "robot_topology.h"
+
+#define DXL_LINK_DEFAULT_BAUD 1000000 // 공장 설정 및 실패 시 복귀할 보레이트
+#define DXL_LINK_TARGET_BAUD  4000000 // 목표 보레이트 (MX 최대 4.5Mbps 중 32MHz/8배 오버샘플링으로 오차 없는 값)
+#define DXL_LINK_MX_MAX_BAUD  4500000 // MX-106/MX-64 최대 보레이트
+#define DXL_LINK_AX_MAX_BAUD  1000000 // AX-12 최대 보레이트
+#define DXL_LINK_RDT          0       // 목표 Return Delay Time (단위 2us, 0 = 즉시 응답)
+#define DXL_LINK_MAX_MOTORS   (JOINT_COUNT + LEG_COUNT)
+#define DXL_DISCOVERY_TIMEOUT_MS 2000 // 모터 전원 인가 후 응답까지 기다리는 최대 시간 (기존 고정 대기 합계)
+#define DXL_DISCOVERY_RETRY_MS   10   // 응답하지 않은 모터가 있을 때 다음 탐색까지 간격
+#define DXL_DISCOVERY_MAX_EXTRA  8    // 기록할 예상 밖 모터 최대 수
+#define DXL_TORQUE_TIMEOUT_MS    1000 // 토크 ON 확인 최대 대기 시간 (기존 고정 대기)
+
+// 링크 설정 결과 (디버깅 모니터링용)
+typedef struct {
+	uint8_t mx_found;      // 응답한 MX 모터 수
+	uint8_t ax_found;      // 응답한 AX 모터 수
+	uint8_t missing_count; // 응답하지 않은 모터 수
+	uint8_t missing_ids[DXL_LINK_MAX_MOTORS];
+	uint8_t model_mismatch; // Ping(또는 탐색) 응답의 모델 번호가 구성 표와 다른 MX 모터 수 (ID 중복/배선 오류 의심)
+	uint8_t ping_skipped;  // 탐색에서 응답을 확인해 Ping을 생략한 모터 수
+	uint8_t rdt_written;   // Return Delay Time을 새로 쓴 모터 수
+	uint8_t rdt_failed;    // Return Delay Time 읽기/쓰기 실패 수
+	uint32_t rdt_us;       // 버스 스케줄러에 적용한 Return Delay Time (모터 중 최댓값)
+	uint32_t max_baud;     // 버스의 모든 모터가 지원하는 최대 보레이트
+	uint32_t baud;         // 최종 버스 보레이트
+	uint8_t capped_by_ax;  // 1: AX-12 바퀴가 같은 버스에 있어 1Mbps를 넘을 수 없음
+	uint8_t baud_fallback; // 1: 새 보레이트 확인 Ping 실패로 기본 보레이트 복귀
+} DXL_Link_Report_t;
+
+// 부팅 탐색 결과 (디버깅 모니터링용)
+typedef struct {
+	uint8_t mx_found;         // 응답한 구성 표의 관절 모터 수
+	uint8_t ax_found;         // 응답한 구성 표의 바퀴 모터 수
+	uint8_t missing_count;    // 제한 시간 안에 응답하지 않은 모터 수
+	uint8_t missing_ids[DXL_LINK_MAX_MOTORS];
+	uint8_t mismatch_count;   // 응답했지만 모델 번호가 구성 표와 다른 모터 수
+	uint8_t mismatch_ids[DXL_LINK_MAX_MOTORS];
+	uint16_t mismatch_models[DXL_LINK_MAX_MOTORS]; // 실제 모델 번호
+	uint8_t unexpected_count; // 구성 표에 없는 ID로 응답한 모터 수 (브로드캐스트 Ping 기준)
+	uint8_t unexpected_ids[DXL_DISCOVERY_MAX_EXTRA];
+	uint16_t unexpected_models[DXL_DISCOVERY_MAX_EXTRA];
+	uint8_t rounds;           // 탐색 횟수
+	uint32_t elapsed_ms;      // 모든 모터가 응답하기까지 (또는 제한 시간까지) 걸린 시간
+} DXL_Discovery_Report_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 부팅 탐색: 구성 표의 모든 모터가 응답하면 바로 HAL_OK, timeout_ms 안에 응답하지 않은 모터가 있으면 HAL_TIMEOUT
+// 모델 번호가 다르거나 예상 밖 ID가 있으면 HAL_ERROR (배선/ID 설정 확인 필요)
+HAL_StatusTypeDef DXL_Link_Discover(DXL_Discovery_Report_t *report, uint32_t timeout_ms);
+
+// 모든 모터의 Torque Enable이 on 값이 될 때까지 대기 (dxl_torque_set 직후 고정 대기 대신 사용)
+HAL_StatusTypeDef DXL_Link_Wait_Torque(uint8_t on, uint32_t timeout_ms);
+
+// 링크 설정 (토크를 해제한 상태에서 EEPROM 항목을 씀 - 토크 ON 전에 호출)
+// discovery: DXL_Link_Discover 결과 (응답한 모터는 Ping 생략, 누락 모터만 다시 Ping), NULL이면 모든 모터 Ping
+// 응답하지 않은 모터가 있거나 보레이트 변경에 실패하면 HAL_ERROR
+HAL_StatusTypeDef DXL_Link_Setup(DXL_Link_Report_t *report, const DXL_Discovery_Report_t *discovery);
+
+#endif /* INC_DXL_LINK_H_ */
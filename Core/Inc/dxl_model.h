@@ -0,0 +1,95 @@
+/*
+ * dxl_model.h
+ * Description: 다이나믹셀 모델별 컨트롤 테이블 등록부
+ * 모델(MX-106, MX-64, AX-12)마다 항목의 주소, 크기, 접근 권한, 단위 배율을 상수 표로 정의하고
+ * 패킷 생성 코드는 항목 이름으로 조회함 (모델/항목 추가 시 표에 한 줄만 추가)
+ * 수정사항: Moving Status 항목 추가 (진단 스윕용)
+ */
+
+#ifndef INC_DXL_MODEL_H_
+#define INC_DXL_MODEL_H_
+
+#include <stdint.h>
+
+// 모델 (모델 번호는 DXL_Model_Info_t 참조)
+typedef enum {
+	DXL_MODEL_MX106 = 0, // MX-106 (프로토콜 2.0)
+	DXL_MODEL_MX64,      // MX-64 (프로토콜 2.0)
+	DXL_MODEL_AX12,      // AX-12 (프로토콜 1.0)
+	DXL_MODEL_COUNT
+} DXL_Model_t;
+
+// 컨트롤 테이블 항목 (모델에 없는 항목은 표에서 크기 0)
+typedef enum {
+	DXL_FIELD_MODEL_NUMBER = 0,
+	DXL_FIELD_BAUD_RATE,             // EEPROM
+	DXL_FIELD_RETURN_DELAY_TIME,     // EEPROM, 단위 2us
+	DXL_FIELD_DRIVE_MODE,            // EEPROM, bit0: 방향 반전, bit2: 시간 기준 프로파일 (MX)
+	DXL_FIELD_TORQUE_ENABLE,
+	DXL_FIELD_LED,
+	DXL_FIELD_HARDWARE_ERROR_STATUS, // MX
+	DXL_FIELD_GOAL_CURRENT,          // MX
+	DXL_FIELD_GOAL_VELOCITY,         // MX: Goal Velocity, AX: Moving Speed
+	DXL_FIELD_PROFILE_ACCELERATION,  // MX
+	DXL_FIELD_PROFILE_VELOCITY,      // MX
+	DXL_FIELD_GOAL_POSITION,
+	DXL_FIELD_MOVING,
+	DXL_FIELD_MOVING_STATUS,         // MX, bit0: 목표 도달, bit1: 프로파일 진행 중, bit3: 추종 오차
+	DXL_FIELD_PRESENT_LOAD,          // AX (MX는 Present Current 사용)
+	DXL_FIELD_PRESENT_CURRENT,       // MX
+	DXL_FIELD_PRESENT_VELOCITY,      // MX: Present Velocity, AX: Present Speed
+	DXL_FIELD_PRESENT_POSITION,
+	DXL_FIELD_PRESENT_INPUT_VOLTAGE,
+	DXL_FIELD_PRESENT_TEMPERATURE,
+	DXL_FIELD_INDIRECT_ADDRESS_1,    // MX, Indirect Address 1~28 (2바이트씩)
+	DXL_FIELD_INDIRECT_DATA_1,       // MX, Indirect Data 1~28 (1바이트씩)
+	DXL_FIELD_COUNT
+} DXL_Field_t;
+
+#define DXL_ADDR_NONE 0xFFFF // DXL_Model_Addr()의 '모델에 없는 항목' 반환값
+
+// 항목 접근 권한 (비트 조합)
+#define DXL_ACCESS_R      0x01 // 읽기
+#define DXL_ACCESS_W      0x02 // 쓰기
+#define DXL_ACCESS_EEPROM 0x04 // EEPROM 영역 (토크 OFF 상태에서만 쓰기, 쓰기 수명 주의)
+#define DXL_ACCESS_SIGNED 0x08 // 부호 있는 값 (읽을 때 부호 확장)
+#define DXL_ACCESS_RW     (DXL_ACCESS_R | DXL_ACCESS_W)
+
+// 항목 정의
+typedef struct {
+	uint16_t addr;  // 컨트롤 테이블 주소
+	uint8_t size;   // 바이트 수 (1, 2, 4 / 0: 모델에 없는 항목)
+	uint8_t access; // DXL_ACCESS_* 조합
+	float scale;    // 원시값 1당 물리 단위 (위치: 도, 속도: rpm, 전류: mA, 전압: V, 온도: 섭씨, 부하: %)
+} DXL_Field_Info_t;
+
+// 모델 정의
+typedef struct {
+	uint16_t model_number;          // 모델 번호 (Ping 응답 / 주소 0)
+	uint8_t protocol;               // 1 또는 2
+	const DXL_Field_Info_t *fields; // DXL_FIELD_COUNT개 항목 표
+} DXL_Model_Info_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 모델 정의 조회 (범위 밖이면 NULL)
+const DXL_Model_Info_t* DXL_Model_Get(DXL_Model_t model);
+
+// 항목 정의 조회 (모델에 없는 항목이면 NULL)
+const DXL_Field_Info_t* DXL_Model_Field(DXL_Model_t model, DXL_Field_t field);
+
+// 항목 주소/크기 (없는 항목이면 DXL_ADDR_NONE / 0)
+uint16_t DXL_Model_Addr(DXL_Model_t model, DXL_Field_t field);
+uint8_t DXL_Model_Size(DXL_Model_t model, DXL_Field_t field);
+
+// 모델 번호로 모델 찾기 (찾지 못하면 DXL_MODEL_COUNT)
+DXL_Model_t DXL_Model_From_Number(uint16_t model_number);
+
+// 리틀 엔디안 원시 바이트 -> 값 (부호 있는 항목은 부호 확장)
+int32_t DXL_Model_Decode(const DXL_Field_Info_t *f, const uint8_t *data);
+
+// 원시값 <-> 물리 단위 변환
+float DXL_Model_To_Unit(const DXL_Field_Info_t *f, int32_t raw);
+int32_t DXL_Model_From_Unit(const DXL_Field_Info_t *f, float value);
+
+#endif /* INC_DXL_MODEL_H_ */
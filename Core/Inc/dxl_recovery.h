@@ -0,0 +1,61 @@
+/*
+ * dxl_recovery.h
+ * Description: 하드웨어 오류(과부하, 과열, 입력 전압, 엔코더 등)로 토크가 꺼진 관절 모터 자동 복구
+ * 진단 슬롯에서 읽은 Hardware Error Status가 0이 아닌 관절을 Sync Write/Sync Read에서 빼고,
+ * Reboot -> 응답 확인 -> Indirect Address 재설정 -> 토크 ON -> 확인 후 제어에 다시 합류시킴
+ * Note: 진단 슬롯에서 한 주기에 요청 1개씩만 보내므로 나머지 모터는 원래 주기대로 계속 제어됨
+ *       바퀴(AX-12, 프로토콜 1.0)는 Reboot 명령이 없어 대상에서 제외
+ */
+
+#ifndef INC_DXL_RECOVERY_H_
+#define INC_DXL_RECOVERY_H_
+
+#include "main.h"
+#include "robot_topology.h"
+
+#define DXL_RECOVERY_BOOT_MS   500  // Reboot 후 모터 부팅 대기 시간
+#define DXL_RECOVERY_REPLY_MS  200  // 확인 읽기 응답을 기다리는 최대 시간 (부팅이 늦으면 반복 요청)
+#define DXL_RECOVERY_MAX_TRIES 3    // 관절 1개당 Reboot 최대 횟수 (넘으면 포기하고 제외 상태 유지)
+#define DXL_RECOVERY_BLEND_MS  1000 // 합류 시 현재 목표까지 이동 시간 (시간 기준 프로파일일 때만)
+
+// 복구 단계 (진단 슬롯 호출마다 한 단계씩 진행)
+typedef enum {
+	DXL_RECOVERY_IDLE = 0,  // 오류 관절 감시
+	DXL_RECOVERY_REBOOT,    // Reboot 송신 차례 (송신 큐가 가득 차면 다음 주기에 다시 시도)
+	DXL_RECOVERY_BOOT_WAIT, // Reboot 송신 후 부팅 대기
+	DXL_RECOVERY_PROBE,     // 확인 읽기 응답 대기 (응답 + 오류 해제 확인)
+	DXL_RECOVERY_MAP_STATE, // Indirect 명령 블록 재설정 완료, 상태 블록 재설정 차례
+	DXL_RECOVERY_TORQUE,    // 토크 ON 차례
+	DXL_RECOVERY_VERIFY,    // 토크 ON 확인 읽기 차례
+	DXL_RECOVERY_CONFIRM,   // 토크 ON 확인 응답 대기
+	DXL_RECOVERY_BLEND      // 제어에 합류, 복귀 프로파일로 이동 중
+} DXL_Recovery_State_t;
+
+// 복구 통계 (디버깅 모니터링용)
+typedef struct {
+	uint32_t attempts;       // 복구를 시작한 횟수 (오류 발생 1회 = 1)
+	uint32_t reboots;        // 송신한 Reboot 수 (재시도 포함)
+	uint32_t recovered;      // 토크 ON 확인 후 제어에 다시 합류한 횟수
+	uint32_t failed;         // Reboot를 DXL_RECOVERY_MAX_TRIES번 하고도 복구되지 않아 포기한 횟수
+	uint32_t no_reply;       // 재부팅 후 / 토크 ON 후 확인 읽기 응답 없음
+	uint32_t still_faulted;  // 재부팅 후에도 Hardware Error Status가 남아 있음
+	uint32_t verify_failed;  // 토크 ON 확인 실패 (토크 OFF 그대로이거나 Write 응답 오류)
+	uint8_t state;           // 현재 단계 (DXL_Recovery_State_t)
+	uint8_t joint;           // 복구 중인 관절 인덱스 (0xFF: 없음)
+	uint8_t disabled;        // 비트 j: 복구에 실패해 제어에서 빠진 관절
+	uint8_t joint_attempts[JOINT_COUNT]; // 관절별 복구 시작 횟수
+	uint8_t joint_hw_error[JOINT_COUNT]; // 관절별 마지막으로 복구를 시작하게 한 Hardware Error Status
+} DXL_Recovery_Report_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 복구 시작 허용 (토크 ON 이후 호출), 평소 관절 프로파일 (시간 기준 프로파일이 아니면 0, 0)
+void DXL_Recovery_Init(uint32_t profile_ms, uint32_t accel_ms);
+
+// 진단 슬롯 함수: 복구 요청이 있으면 1개 송신, 없으면 순환 진단 읽기 (send_diag_read_next 대신 등록)
+void DXL_Recovery_Slot(void);
+
+// 통계 조회
+const DXL_Recovery_Report_t* DXL_Recovery_Get_Report(void);
+
+#endif /* INC_DXL_RECOVERY_H_ */
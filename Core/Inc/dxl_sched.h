@@ -0,0 +1,98 @@
+/*
+ * dxl_sched.h
+ * Description: 다이나믹셀 버스(USART3) 시간 분할 스케줄러
+ * 제어 주기를 슬롯(관절 쓰기, 바퀴 쓰기, 상태 읽기, 진단)으로 나누고,
+ * 보레이트/패킷 길이/Return Delay Time으로 슬롯별 선로 점유 시간을 계산하여 정해진 시각에 송신
+ * 수정사항: 슬롯 시각/주기 시작을 기다리는 동안 호출할 대기 콜백 (응답을 도착 직후 해석)
+ * 수정사항: 채움 슬롯 - 고정 슬롯이 끝난 뒤 다음 주기 시작 전까지 남는 시간에 들어갈 때만 송신 (진단 스윕용)
+ */
+
+#ifndef INC_DXL_SCHED_H_
+#define INC_DXL_SCHED_H_
+
+#include "main.h"
+
+#define DXL_SCHED_PERIOD_US  20000 // 기본 제어 주기 (50Hz)
+#define DXL_SCHED_COMPUTE_US 500   // 주기 시작 후 IMU 파싱/역기구학에 남겨두는 시간
+#define DXL_SCHED_GUARD_US   20    // 슬롯마다 더하는 여유 (방향 핀 전환, 인터럽트 지연)
+#define DXL_SCHED_RDT_US     500   // 모터 Return Delay Time 기본값 (공장 설정 250 x 2us)
+
+// 제어 주기 안의 슬롯 (이 순서대로 송신)
+typedef enum {
+	DXL_SLOT_JOINT_WRITE = 0, // 관절 8개 목표 위치 Sync Write
+	DXL_SLOT_WHEEL_WRITE,     // 바퀴 4개 목표 속도 Sync Write
+	DXL_SLOT_SYNC_READ,       // 관절 상태 Sync Read / Fast Sync Read (응답 대기 포함)
+	DXL_SLOT_DIAG,            // 모터 1개씩 돌아가며 진단 읽기
+	DXL_SLOT_COUNT
+} DXL_Slot_t;
+
+// 슬롯 1개가 버스에 내보내는 양 (최악 기준)
+typedef struct {
+	uint16_t tx_bytes; // 송신 바이트 수
+	uint16_t rx_bytes; // 응답 바이트 수 합계
+	uint8_t replies;   // 응답 패킷 수 (Return Delay Time이 붙는 횟수)
+} DXL_Frame_Cost_t;
+
+typedef void (*DXL_Slot_Fn)(void);                // 슬롯 시각에 호출: 패킷을 송신 큐에 넣음
+typedef DXL_Frame_Cost_t (*DXL_Slot_Cost_Fn)(void); // 슬롯의 현재 비용 조회 (읽기 방식이 바뀌면 달라짐)
+
+// 슬롯별 시간 계획
+typedef struct {
+	DXL_Slot_Fn fn;
+	DXL_Slot_Cost_Fn cost_fn;
+	DXL_Frame_Cost_t cost; // 마지막으로 계산에 사용한 비용
+	uint32_t wire_us;      // 선로 점유 시간 (송신 + 응답 지연 + 응답 + 여유)
+	uint32_t offset_us;    // 버스 단계 시작 기준 슬롯 시작 시각
+} DXL_Sched_Slot_t;
+
+// 스케줄 계산 결과 및 실행 통계 (디버깅 모니터링용)
+typedef struct {
+	uint32_t period_us;    // 요청한 제어 주기
+	uint32_t active_us;    // 실제 적용 중인 주기 (예산 초과 시 늘어남)
+	uint32_t baud;         // 계산에 사용한 보레이트
+	uint32_t rdt_us;       // 계산에 사용한 Return Delay Time
+	uint32_t bus_us;       // 슬롯 선로 시간 합계
+	uint32_t over_us;      // 주기 예산 초과량 (0이면 정상)
+	uint32_t cycles;       // 실행한 주기 수
+	uint32_t late_cycles;  // 주기 시작이 늦어진 횟수 (연산이 길어진 경우)
+	uint32_t replans;      // 슬롯 비용 변경으로 다시 계산한 횟수
+	uint32_t fill_us;      // 마지막 주기에 고정 슬롯이 끝난 뒤 다음 주기 시작까지 남은 시간
+	uint32_t fill_runs;    // 채움 슬롯을 실행한 횟수
+	uint32_t fill_deferred; // 남은 시간이 모자라 채움 슬롯을 다음 주기로 미룬 횟수
+} DXL_Sched_Report_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 슬롯 등록 (fn이 NULL이면 비활성)
+void DXL_Sched_Config_Slot(DXL_Slot_t slot, DXL_Slot_Fn fn, DXL_Slot_Cost_Fn cost_fn);
+
+// 스케줄 계산: 예산을 넘으면 주기를 늘려 적용하고 HAL_ERROR 반환 (over_us에 초과량 기록)
+HAL_StatusTypeDef DXL_Sched_Init(uint32_t period_us);
+
+// Return Delay Time 변경 시 다시 계산 (보레이트는 DXL_Bus에서 읽음)
+HAL_StatusTypeDef DXL_Sched_Set_Return_Delay(uint32_t rdt_us);
+HAL_StatusTypeDef DXL_Sched_Replan(void);
+
+// 대기 콜백 등록: 슬롯 시각/주기 시작을 기다리는 동안 반복 호출 (NULL이면 해제)
+// 콜백 실행 시간만큼 슬롯 시작이 늦어질 수 있으므로 짧게 유지 (DXL_SCHED_GUARD_US 이내)
+void DXL_Sched_Set_Idle_Callback(DXL_Slot_Fn fn);
+
+// 채움 슬롯 등록 (NULL이면 해제): 주기 계획에 넣지 않고, 고정 슬롯의 선로 시간이 끝난 뒤
+// 다음 주기 시작 전까지 cost_fn의 선로 시간이 들어갈 때만 fn 호출 (고정 슬롯을 밀어내지 않음)
+void DXL_Sched_Set_Fill(DXL_Slot_Fn fn, DXL_Slot_Cost_Fn cost_fn);
+
+// 다음 주기 시작까지 대기 (HAL_Delay 대신 사용, 주기 시작 시각 기준으로 흔들림 없음)
+// 대기 중 남는 버스 시간에 채움 슬롯 실행
+void DXL_Sched_Wait_Period(void);
+
+// 버스 단계 실행: 각 슬롯 시작 시각에 맞춰 패킷을 큐에 넣고 송신
+void DXL_Sched_Run(void);
+
+// 스케줄/통계 조회
+const DXL_Sched_Report_t* DXL_Sched_Get_Report(void);
+const DXL_Sched_Slot_t* DXL_Sched_Get_Slot(DXL_Slot_t slot);
+
+// 바이트 수 -> 선로 시간(us) 변환 (8N1 = 바이트당 10비트)
+uint32_t DXL_Sched_Wire_Us(uint32_t bytes, uint32_t baud);
+
+#endif /* INC_DXL_SCHED_H_ */
@@ -0,0 +1,66 @@
+/*
+ * dxl_status.h
+ * Description: 다이나믹셀 프로토콜 2.0 상태 패킷(Status Packet) 스트리밍 디코더
+ * RX DMA 순환 버퍼의 연속 구간을 그대로 넘기면 헤더 동기화, 바이트 스터핑 해제, CRC 검사를 거쳐
+ * 완성된 상태 패킷을 돌려줌. 프레임 전체를 복사하지 않고, 파라미터도 가능하면 입력 버퍼를 직접 가리킴
+ * 수정사항: 바이트 단위 프레임 조립 방식에서 구간 단위 무복사 상태 머신으로 변경
+ * 수정사항: CRC 불일치 패킷의 ID 기록 (모터별 상태 카운터용)
+ * Note: HAL 의존성이 없으므로 (dxl_crc의 CRC 함수만 사용) PC에서 그대로 빌드하여 퍼징 가능 (Tests/fuzz_dxl_status.c)
+ */
+
+#ifndef INC_DXL_STATUS_H_
+#define INC_DXL_STATUS_H_
+
+#include <stdint.h>
+
+#define DXL_STATUS_MAX_PARAMS 160 // 파라미터 최대 길이 (Fast Sync Read 8개 응답 = 109바이트)
+#define DXL_INST_STATUS       0x55 // 상태 패킷 명령어 값
+
+// 디코딩된 상태 패킷
+// params는 입력 구간(소비 전까지 유효) 또는 디코더 내부 버퍼(다음 Parse 호출 전까지 유효)를 가리킴
+typedef struct {
+	uint8_t id;            // 응답한 모터 ID (Fast Sync Read는 0xFE)
+	uint8_t error;         // Error 필드
+	const uint8_t *params; // 스터핑이 해제된 파라미터
+	uint16_t param_len;    // 파라미터 길이
+} DXL_Status_Packet_t;
+
+// 디코더 상태 및 통계
+typedef struct {
+	uint8_t state;      // 현재 해석 위치 (dxl_status.c 내부 정의)
+	uint8_t hdr;        // 헤더 FF FF FD 00 중 일치한 바이트 수
+	uint8_t stuff;      // 본문에서 연속으로 일치한 FF FF FD 바이트 수 (스터핑 검출용)
+	uint8_t copy;       // 1: 파라미터를 내부 버퍼에 모으는 중 (구간이 끊겼거나 스터핑 해제됨)
+	uint8_t id;
+	uint8_t error;
+	uint8_t crc_rx;     // 수신한 CRC 하위 바이트
+	uint16_t remain;    // 현재 프레임에서 남은 본문 바이트 수 (스터핑 포함)
+	uint16_t crc;       // 지금까지 받은 바이트의 CRC
+	uint16_t param_len;
+	const uint8_t *zc;  // 무복사 모드에서 파라미터 시작 위치 (현재 입력 구간 안)
+	uint8_t params[DXL_STATUS_MAX_PARAMS];
+
+	uint32_t packets;    // 정상 수신한 상태 패킷 수
+	uint32_t crc_errors; // CRC 불일치로 버린 패킷 수
+	uint8_t crc_error_id; // 마지막으로 CRC 불일치로 버린 패킷의 ID (ID 바이트 자체가 깨졌을 수 있음)
+	uint32_t resyncs;    // 프레임 도중 새 헤더/잘못된 길이로 동기를 다시 잡은 횟수 (끊긴 프레임)
+	uint32_t echoes;     // 상태 패킷이 아닌 프레임(반이중 선로의 송신 에코 등) 수
+	uint32_t oversize;   // 길이 필드가 파라미터 버퍼보다 커서 버린 프레임 수
+	uint32_t unstuffed;  // 제거한 스터핑 바이트 수
+	uint32_t dropped;    // 프레임 밖에서 버린 바이트 수
+} DXL_Status_Parser_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// 디코더 초기화 (통계 포함)
+void DXL_Status_Init(DXL_Status_Parser_t *parser);
+
+// 진행 중인 프레임을 버리고 헤더 탐색부터 다시 시작 (통계 유지)
+void DXL_Status_Reset(DXL_Status_Parser_t *parser);
+
+// 입력 구간 해석: 상태 패킷이 완성되면 그 직후에서 멈추고 1 반환
+// used에는 소비한 바이트 수가 들어감 (out 사용을 마친 뒤 DXL_Bus_Rx_Consume(used) 호출)
+uint8_t DXL_Status_Parse(DXL_Status_Parser_t *parser, const uint8_t *data, uint16_t len,
+		uint16_t *used, DXL_Status_Packet_t *out);
+
+#endif /* INC_DXL_STATUS_H_ */
@@ -0,0 +1,367 @@
+/*
+ * dxl_sync.hpp
+ * Description: 다이나믹셀 Sync Write / Sync Read 패킷의 컴파일 시점 생성 (C++17, 헤더 전용)
+ * SyncWrite<Field, Ids...>는 패킷 길이, 헤더/ID 바이트, 데이터 위치와 고정 구간 CRC(체크섬)를
+ * constexpr로 계산하므로, 실행 시에는 값 기록 + 데이터 구간 CRC + 송신 큐 추가만 남음.
+ * 값은 단위 타입(Ticks, Rpm, MilliAmp)으로만 받으므로 단위를 섞으면 컴파일 오류가 남.
+ * Note: 현재 프로젝트는 C 전용이라 이 헤더는 펌웨어 빌드에 포함되지 않음 (C++ 소스에서 include할 때만 사용)
+ *       C 경로와의 바이트 비교는 Tests/test_dxl_sync.cpp (make -C Tests test), 시간 비교는 Tests/bench_dxl_sync.cpp (make -C Tests bench)
+ *       항목 주소/크기는 dxl_model.c 등록부와 같은 값 (등록부는 C 상수 표라 constexpr로 읽을 수 없음)
+ */
+
+#ifndef INC_DXL_SYNC_HPP_
+#define INC_DXL_SYNC_HPP_
+
+#ifndef __cplusplus
+#error "dxl_sync.hpp는 C++17 전용 (C 코드는 dxl_2_0.h의 send_sync_* / dxl_sync_write 사용)"
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "dxl_2_0.h"
+#include "dxl_bus.h"
+#include "dxl_crc.h"
+}
+
+namespace dxl {
+
+// ---------------------------------------------------------------------------
+// 1. 단위 타입 (암시적 변환 없음 -> Ticks 자리에 Rpm이나 정수를 넘기면 컴파일 오류)
+// ---------------------------------------------------------------------------
+
+struct Ticks { int32_t value; };   // 모터 원시 위치 단위
+struct Rpm { float value; };       // 분당 회전수
+struct MilliAmp { float value; };  // 전류 (mA)
+struct Enable { bool value; };     // 토크 ON/OFF
+
+// ---------------------------------------------------------------------------
+// 2. constexpr CRC16 (다항식 0x8005, 초기값 0) / 1.0 체크섬 합
+// ---------------------------------------------------------------------------
+
+constexpr uint16_t crc16(uint16_t crc, const uint8_t *data, std::size_t len) {
+	for (std::size_t i = 0; i < len; i++) {
+		crc ^= static_cast<uint16_t>(data[i] << 8);
+		for (int b = 0; b < 8; b++)
+			crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ DXL_CRC_POLY)
+					: static_cast<uint16_t>(crc << 1);
+	}
+	return crc;
+}
+
+constexpr uint32_t byte_sum(const uint8_t *data, std::size_t from, std::size_t to) {
+	uint32_t sum = 0;
+	for (std::size_t i = from; i < to; i++)
+		sum += data[i];
+	return sum;
+}
+
+// ---------------------------------------------------------------------------
+// 3. 항목 정의 (주소, 크기, 프로토콜, 단위 -> 원시값 변환)
+// ---------------------------------------------------------------------------
+
+// 반올림 후 정수 변환 (constexpr에서 lroundf 대신 사용)
+constexpr int32_t round_to_int(float x) {
+	return static_cast<int32_t>(x < 0.0f ? x - 0.5f : x + 0.5f);
+}
+
+// MX 목표 위치: 원시 Ticks만 받음 (관절마다 방향/영점이 다르므로 각도 -> Ticks 변환은 호출 측 역기구학에서)
+struct GoalPosition {
+	static constexpr uint8_t protocol = 2;
+	static constexpr uint16_t addr = 116;
+	static constexpr uint8_t size = 4;
+	static constexpr uint32_t raw(Ticks t) { return static_cast<uint32_t>(t.value); }
+};
+
+// MX 목표 속도 (0.229 rpm 단위, 부호 있음)
+struct GoalVelocity {
+	static constexpr uint8_t protocol = 2;
+	static constexpr uint16_t addr = 104;
+	static constexpr uint8_t size = 4;
+	static constexpr uint32_t raw(Rpm v) { return static_cast<uint32_t>(round_to_int(v.value / 0.229f)); }
+};
+
+// MX 목표 전류 (3.36 mA 단위, 부호 있음)
+struct GoalCurrent {
+	static constexpr uint8_t protocol = 2;
+	static constexpr uint16_t addr = 102;
+	static constexpr uint8_t size = 2;
+	static constexpr uint32_t raw(MilliAmp i) {
+		return static_cast<uint16_t>(round_to_int(i.value / 3.36f));
+	}
+};
+
+struct TorqueEnable {
+	static constexpr uint8_t protocol = 2;
+	static constexpr uint16_t addr = 64;
+	static constexpr uint8_t size = 1;
+	static constexpr uint32_t raw(Enable e) { return e.value ? 1 : 0; }
+};
+
+// AX 바퀴 모드 Moving Speed (0.111 rpm 단위, bit10 = 시계 방향) - clc_speed_1()과 같은 변환
+struct WheelSpeed {
+	static constexpr uint8_t protocol = 1;
+	static constexpr uint16_t addr = 32;
+	static constexpr uint8_t size = 2;
+	static constexpr uint32_t raw(Rpm v) {
+		int32_t s = round_to_int(v.value / 0.111f);
+		if (s > 1023)
+			s = 1023;
+		if (s < -1023)
+			s = -1023;
+		return (s < 0) ? static_cast<uint32_t>(-s) + 1024 : static_cast<uint32_t>(s);
+	}
+};
+
+struct WheelTorqueEnable {
+	static constexpr uint8_t protocol = 1;
+	static constexpr uint16_t addr = 24;
+	static constexpr uint8_t size = 1;
+	static constexpr uint32_t raw(Enable e) { return e.value ? 1 : 0; }
+};
+
+// 관절 상태 블록 (Present Current ~ Present Position, SyncRead 전용)
+struct JointState {
+	static constexpr uint8_t protocol = 2;
+	static constexpr uint16_t addr = 126;
+	static constexpr uint8_t size = JOINT_STATE_LEN;
+};
+
+// ---------------------------------------------------------------------------
+// 4. SyncWrite<Field, Ids...>
+// ---------------------------------------------------------------------------
+
+template<class Field, uint8_t... Ids>
+class SyncWrite {
+public:
+	static constexpr std::size_t kCount = sizeof...(Ids);
+	static constexpr std::size_t kStride = Field::size + 1; // ID + 데이터
+	static constexpr std::size_t kHeader = (Field::protocol == 2) ? 12 : 7; // 첫 번째 ID 앞까지
+	static constexpr std::size_t kDataStart = kHeader + 1;                  // 첫 번째 데이터 위치
+	static constexpr std::size_t kTail = (Field::protocol == 2) ? 2 : 1;    // CRC / 체크섬
+	static constexpr std::size_t kLen = kHeader + kCount * kStride + kTail;
+
+	static_assert(kCount > 0, "Sync Write에는 모터가 1개 이상 필요");
+	static_assert(((Ids <= 0xFC) && ...), "ID는 0~252 (0xFD 이상은 헤더/브로드캐스트와 겹침)");
+	static_assert(kLen + kCount * (Field::size / 3) <= DXL_BUS_BANK_SIZE, "패킷이 송신 버퍼보다 큼");
+	static_assert(Field::protocol == 2 || kLen - 4 <= 0xFF, "1.0 Length 필드는 1바이트");
+
+	SyncWrite() : buf_(kTemplate) {}
+
+	// i번째 모터 값 기록 (단위 타입은 Field::raw 오버로드로만 받음)
+	template<class Unit>
+	void set(std::size_t i, Unit value) {
+		uint32_t v = Field::raw(value);
+		uint8_t *d = &buf_[kDataStart + i * kStride];
+		for (std::size_t b = 0; b < Field::size; b++)
+			d[b] = static_cast<uint8_t>(v >> (8 * b));
+	}
+
+	// 모든 모터에 같은 단위의 값 배열 기록
+	template<class Unit>
+	void set_all(const Unit (&values)[kCount]) {
+		for (std::size_t i = 0; i < kCount; i++)
+			set(i, values[i]);
+	}
+
+	// 데이터 구간만 CRC(체크섬) 계산 후 송신 큐에 추가 (송신은 DXL_Bus_Flush 시점)
+	HAL_StatusTypeDef queue() {
+		HAL_StatusTypeDef st;
+		if constexpr (Field::protocol == 2) {
+			if (Field::size >= 3 && payload_or() >= DXL_STUFF_FREE_LIMIT) {
+				st = queue_stuffed();
+			} else {
+				uint16_t crc = update_crc(kPrefix, &buf_[kDataStart], kLen - 2 - kDataStart);
+				buf_[kLen - 2] = static_cast<uint8_t>(crc);
+				buf_[kLen - 1] = static_cast<uint8_t>(crc >> 8);
+				st = DXL_Bus_Enqueue(buf_.data(), kLen);
+			}
+		} else {
+			uint32_t sum = kPrefix;
+			for (std::size_t i = 0; i < kCount; i++)
+				for (std::size_t b = 0; b < Field::size; b++)
+					sum += buf_[kDataStart + i * kStride + b];
+			buf_[kLen - 1] = static_cast<uint8_t>(~sum);
+			st = DXL_Bus_Enqueue(buf_.data(), kLen);
+		}
+		return st;
+	}
+
+	const uint8_t* data() const { return buf_.data(); }
+	static constexpr std::size_t size() { return kLen; }
+
+private:
+	// 헤더, 길이, 명령어, 주소, ID까지 채운 패킷 (데이터는 0)
+	static constexpr std::array<uint8_t, kLen> make_template() {
+		std::array<uint8_t, kLen> p {};
+		constexpr uint8_t ids[kCount] = { Ids... };
+		std::size_t idx = 0;
+		if constexpr (Field::protocol == 2) {
+			uint16_t length = static_cast<uint16_t>(kLen - 7);
+			p[idx++] = 0xFF; p[idx++] = 0xFF; p[idx++] = 0xFD; p[idx++] = 0x00; // Header, Reserved
+			p[idx++] = 0xFE;                                                    // Broadcast ID
+			p[idx++] = static_cast<uint8_t>(length); p[idx++] = static_cast<uint8_t>(length >> 8);
+			p[idx++] = 0x83;                                                    // Sync Write
+			p[idx++] = static_cast<uint8_t>(Field::addr); p[idx++] = static_cast<uint8_t>(Field::addr >> 8);
+			p[idx++] = Field::size; p[idx++] = 0x00;
+		} else {
+			p[idx++] = 0xFF; p[idx++] = 0xFF; p[idx++] = 0xFE;                  // Header, Broadcast ID
+			p[idx++] = static_cast<uint8_t>(kLen - 4);                         // Length
+			p[idx++] = 0x83;                                                    // Sync Write
+			p[idx++] = static_cast<uint8_t>(Field::addr);
+			p[idx++] = Field::size;
+		}
+		for (std::size_t i = 0; i < kCount; i++) {
+			p[idx] = ids[i];
+			idx += kStride;
+		}
+		return p;
+	}
+
+	static constexpr std::array<uint8_t, kLen> kTemplate = make_template();
+
+	// 2.0: 첫 번째 데이터 직전까지의 CRC / 1.0: 데이터가 0일 때 체크섬 대상 바이트 합
+	static constexpr uint32_t make_prefix() {
+		if constexpr (Field::protocol == 2)
+			return crc16(0, kTemplate.data(), kDataStart);
+		else
+			return byte_sum(kTemplate.data(), 2, kLen - 1);
+	}
+	static constexpr uint32_t kPrefix = make_prefix();
+
+	// 버퍼에 남아 있는 모든 모터 값의 OR (이번에 set()하지 않은 모터의 이전 값도 포함)
+	// ID는 0xFC 이하라 FF FF FD가 ID에 걸칠 수 없으므로 값만 보면 됨
+	uint32_t payload_or() const {
+		uint32_t any = 0;
+		for (std::size_t i = 0; i < kCount; i++)
+			for (std::size_t b = 0; b < Field::size; b++)
+				any |= static_cast<uint32_t>(buf_[kDataStart + i * kStride + b]) << (8 * b);
+		return any;
+	}
+
+	// 데이터에 FF FF FD가 있을 수 있는 경우: 슬롯에 스터핑하며 복사 후 길이/CRC 재계산
+	HAL_StatusTypeDef queue_stuffed() {
+		uint8_t *slot = DXL_Bus_Slot_Acquire(kLen + kCount * (Field::size / 3));
+		if (slot == nullptr)
+			return HAL_ERROR;
+
+		std::memcpy(slot, buf_.data(), 7);
+		uint16_t idx = 7 + dxl_stuff_copy(&slot[7], &buf_[7], kLen - 9);
+		uint16_t length = idx - 7 + 2;
+		slot[5] = static_cast<uint8_t>(length);
+		slot[6] = static_cast<uint8_t>(length >> 8);
+
+		uint16_t crc = update_crc(0, slot, idx);
+		slot[idx++] = static_cast<uint8_t>(crc);
+		slot[idx++] = static_cast<uint8_t>(crc >> 8);
+		DXL_Bus_Slot_Commit(idx);
+		return HAL_OK;
+	}
+
+	std::array<uint8_t, kLen> buf_;
+};
+
+// ---------------------------------------------------------------------------
+// 5. SyncRead<Field, Ids...> (요청 패킷은 CRC까지 전부 컴파일 시점에 완성)
+// ---------------------------------------------------------------------------
+
+template<class Field, uint8_t... Ids>
+class SyncRead {
+public:
+	static_assert(Field::protocol == 2, "Sync Read는 프로토콜 2.0 전용 (AX-12는 모터마다 Read)");
+	static_assert(((Ids <= 0xFC) && ...), "ID는 0~252");
+
+	static constexpr std::size_t kCount = sizeof...(Ids);
+	static constexpr std::size_t kLen = 14 + kCount;
+	static constexpr std::size_t kReplyLen = kCount * (11 + Field::size); // 응답 바이트 (상태 패킷 N개)
+
+	static HAL_StatusTypeDef queue() { return DXL_Bus_Enqueue(kRequest.data(), kLen); }
+
+private:
+	static constexpr std::array<uint8_t, kLen> make_request() {
+		std::array<uint8_t, kLen> p {};
+		constexpr uint8_t ids[kCount] = { Ids... };
+		uint16_t length = static_cast<uint16_t>(7 + kCount);
+		std::size_t idx = 0;
+		p[idx++] = 0xFF; p[idx++] = 0xFF; p[idx++] = 0xFD; p[idx++] = 0x00;
+		p[idx++] = 0xFE;
+		p[idx++] = static_cast<uint8_t>(length); p[idx++] = static_cast<uint8_t>(length >> 8);
+		p[idx++] = 0x82; // Sync Read
+		p[idx++] = static_cast<uint8_t>(Field::addr); p[idx++] = static_cast<uint8_t>(Field::addr >> 8);
+		p[idx++] = static_cast<uint8_t>(Field::size); p[idx++] = static_cast<uint8_t>(Field::size >> 8);
+		for (std::size_t i = 0; i < kCount; i++)
+			p[idx++] = ids[i];
+		uint16_t crc = crc16(0, p.data(), idx);
+		p[idx++] = static_cast<uint8_t>(crc);
+		p[idx++] = static_cast<uint8_t>(crc >> 8);
+		return p;
+	}
+
+	static constexpr std::array<uint8_t, kLen> kRequest = make_request();
+};
+
+// ---------------------------------------------------------------------------
+// 6. 다리 모터 구성 (robot_topology.h 표에서 ID 목록을 전개 - 표를 바꾸면 함께 바뀜)
+// ---------------------------------------------------------------------------
+
+#define DXL_SYNC_JOINT_ID(leg, id, model, dir, zero) , id
+#define DXL_SYNC_WHEEL_ID(leg, id, model, dir) , id
+
+using JointPositionWrite = SyncWrite<GoalPosition ROBOT_JOINT_TABLE(DXL_SYNC_JOINT_ID)>; // 관절 인덱스 순
+using JointTorqueWrite   = SyncWrite<TorqueEnable ROBOT_JOINT_TABLE(DXL_SYNC_JOINT_ID)>;
+using WheelSpeedWrite    = SyncWrite<WheelSpeed ROBOT_WHEEL_TABLE(DXL_SYNC_WHEEL_ID)>;
+using WheelTorqueWrite   = SyncWrite<WheelTorqueEnable ROBOT_WHEEL_TABLE(DXL_SYNC_WHEEL_ID)>;
+using JointStateRead     = SyncRead<JointState ROBOT_JOINT_TABLE(DXL_SYNC_JOINT_ID)>;
+
+// 컴파일 시점 자체 검증: 관절 위치 Sync Write 길이 = 14 + 관절 수 * 5
+static_assert(JointPositionWrite::size() == 14 + JOINT_COUNT * 5, "관절 위치 Sync Write 길이");
+static_assert(WheelSpeedWrite::size() == 8 + LEG_COUNT * 3, "바퀴 속도 Sync Write 길이");
+static_assert(WheelSpeed::raw(Rpm { -0.111f }) == 1025, "바퀴 시계 방향 bit10");
+
+// ---------------------------------------------------------------------------
+// 7. 벤치마크 (DWT 사이클 카운터, 패킷 1개당 CPU 사이클)
+// ---------------------------------------------------------------------------
+// send_sync_write_joints()와 JointPositionWrite로 같은 값을 큐에 넣는 시간만 측정하고,
+// 측정 구간 밖에서 매번 송신 완료까지 기다림 (송신 슬롯이 넘치지 않도록). DWT는 main.c의 DWT_Cycle_Init에서 활성화.
+// 실제로 목표 위치가 송신되므로 제어기가 보낼 값(관절 인덱스 순 goals)을 그대로 넘겨야 함.
+
+struct BenchResult {
+	uint32_t cycles_c;   // send_sync_write_joints (부팅 시 만든 C 템플릿)
+	uint32_t cycles_cpp; // JointPositionWrite::set + queue
+};
+
+inline BenchResult bench_joint_write(const uint32_t *goals, uint32_t iterations) {
+	BenchResult r { 0, 0 };
+	uint32_t g[JOINT_COUNT];
+	JointPositionWrite w;
+
+	if (iterations == 0)
+		iterations = 1;
+	std::memcpy(g, goals, sizeof(g));
+
+	for (uint32_t n = 0; n < iterations; n++) {
+		uint32_t start = DWT->CYCCNT;
+		send_sync_write_joints(g);
+		r.cycles_c += DWT->CYCCNT - start;
+		DXL_Bus_Flush();
+		DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+
+		start = DWT->CYCCNT;
+		for (std::size_t i = 0; i < JOINT_COUNT; i++)
+			w.set(i, Ticks { static_cast<int32_t>(g[i]) });
+		w.queue();
+		r.cycles_cpp += DWT->CYCCNT - start;
+		DXL_Bus_Flush();
+		DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+	}
+	r.cycles_c /= iterations;
+	r.cycles_cpp /= iterations;
+	return r;
+}
+
+} // namespace dxl
+
+#endif /* INC_DXL_SYNC_HPP_ */
@@ -2,6 +2,11 @@
  * imu_driver.h
  * Description: UART DMA & IDLE 인터럽트 기반 IMU 센서(EBIMU) 데이터 수신 드라이버
  * 수정사항: 스택 오버플로우 방지를 위한 데이터 수신과 파싱 로직 분리
+ * 수정사항: DMA 쓰기 위치(NDTR) 기준 링 버퍼 소비 - 새로 들어온 바이트만 훑고, 프레임은 복사 없이 링 안에서 파싱
+ * 수정사항: 통계에 마지막 파싱 오류 종류 추가 (파서는 imu_ebimu)
+ * 수정사항: 초기화 시 EBIMU를 바이너리(HEX) 출력으로 설정, 응답이 없으면 ASCII 유지
+ * 수정사항: 부팅 시 센서 보레이트 자동 탐지 후 921600bps/출력 주기 설정, 수신 프레임 속도 측정
+ * 수정사항: 센서가 아직 부팅 중이면 IMU_BOOT_TIMEOUT_MS까지 보레이트 탐지 반복
  */
 
 #ifndef INC_IMU_DRIVER_H_
@@ -9,6 +14,14 @@
 
 #include "main.h"
 
+#define IMU_RING_SIZE 512 // DMA Circular 수신 링 크기 (2의 거듭제곱, 115200bps 기준 약 44ms 분량)
+#define IMU_FRAME_MAX 64  // '*'부터 줄바꿈까지 한 프레임 최대 길이 (넘으면 버리고 다음 '*'에서 재동기화)
+#define IMU_ACK_TIMEOUT_MS 100 // 설정 명령 1개당 "<ok>" 응답 대기 시간
+#define IMU_BOOT_TIMEOUT_MS 2000 // 센서 부팅 대기 한도 (리셋 후 HAL_GetTick 기준, 이때까지 응답이 없으면 보레이트 탐지를 반복)
+#define IMU_BAUD_TARGET 921600 // 설정할 센서/USART2 보레이트 (D2PCLK1 32MHz 기준 오차 0.8%)
+#define IMU_OUTPUT_PERIOD_MS 5 // 센서 출력 주기 (200Hz, 제어 주기마다 가장 최근 프레임 사용)
+#define IMU_RATE_WINDOW_MS 1000 // 프레임 속도 측정 구간
+
 // IMU 3축 오일러 각(Euler Angles) 데이터 구조체 정의
 typedef struct {
 	float roll;
@@ -16,18 +29,58 @@ typedef struct {
 	float yaw;
 } IMU_Data_t;
 
+// 센서 출력 형식
+typedef enum {
+	IMU_MODE_ASCII = 0, // "*roll,pitch,yaw\r\n" (바이너리 설정 실패 시)
+	IMU_MODE_BINARY     // 0x55 0x55 + int16 x3 + 체크섬 (고정 길이)
+} IMU_Mode_t;
+
+// 수신/파싱 통계 (디버깅 모니터링용)
+typedef struct {
+	uint32_t rx_bytes;     // DMA가 링에 쓴 누적 바이트 수
+	uint32_t frames;       // 줄바꿈까지 받은 완전한 프레임 수
+	uint32_t parsed;       // 파싱에 성공해 자세 값을 갱신한 프레임 수
+	uint32_t parse_errors; // 형식 오류 (숫자/콤마 누락, 허용되지 않은 문자, 범위 초과 등)
+	uint32_t oversize;     // IMU_FRAME_MAX를 넘어 버린 프레임 수
+	uint32_t overruns;     // 파싱 도중 DMA가 한 바퀴 돌아 프레임을 덮어써 버린 수
+	uint32_t skipped;      // 메인 루프가 가져가기 전에 더 새 프레임이 와서 건너뛴 수
+	uint32_t wraps;        // 링 끝을 걸쳐 있어 복사 후 파싱한 프레임 수
+	uint32_t idle_events;  // IDLE 인터럽트 수
+	uint32_t uart_errors;  // UART 수신 오류 수 (수신이 멈췄으면 재시작)
+	uint16_t max_chunk;    // 한 번에 훑은 새 바이트 수 최대값
+	uint8_t last_parse_error; // 마지막 파싱 오류 종류 (EBIMU_Result_t, 바이너리 체크섬 오류 포함)
+	uint8_t mode;             // 현재 출력 형식 (IMU_Mode_t)
+	uint8_t baud_fallback;    // 1: 목표 보레이트 전환 후 응답이 없어 탐지한 보레이트로 복귀
+	uint32_t baud;            // 현재 USART2 보레이트 (탐지/설정 결과)
+	uint32_t detected_baud;   // 부팅 시 센서가 응답한 보레이트 (0: 응답 없음)
+	uint8_t detect_sweeps;    // 부팅 시 후보 보레이트 전체를 시도한 횟수 (2 이상: 센서 부팅을 기다림)
+	uint16_t frame_hz;        // 마지막 측정 구간의 수신 프레임 속도 (IMU_RATE_WINDOW_MS마다 갱신)
+} IMU_Stats_t;
+
 // --- 함수 프로토타입 선언 ---
 
-// IMU 초기화: UART 및 DMA 수신 설정
-void IMU_Init(UART_HandleTypeDef *huart);
+// IMU 초기화: 센서 보레이트 탐지 후 목표 보레이트/출력 주기/바이너리 출력 설정 (부팅 시 1회)
+// 센서가 응답할 때까지 탐지를 반복하므로 호출 전 부팅 대기가 필요 없음 (응답이 없으면 IMU_BOOT_TIMEOUT_MS 무렵까지 대기)
+// 반환값: HAL_OK - 모두 적용, HAL_ERROR - 일부 설정 실패 (탐지한 보레이트/ASCII 등으로 계속 수신),
+//         HAL_TIMEOUT - 어느 보레이트에서도 응답 없음 (기본 보레이트, ASCII로 수신)
+HAL_StatusTypeDef IMU_Init(UART_HandleTypeDef *huart);
 
 // UART IDLE 인터럽트 콜백 함수 (ISR 컨텍스트에서 호출 - 가볍게 유지)
 void IMU_IDLE_Callback(void);
 
+// DMA 절반/완료 콜백 (HAL_UART_RxHalfCpltCallback/RxCpltCallback에서 호출, 한 바퀴 안에 한 번 이상 위치 갱신 보장)
+void IMU_DMA_Callback(void);
+
+// UART 오류 콜백 (HAL_UART_ErrorCallback에서 호출)
+void IMU_Error_Callback(void);
+
 // [신규] 수신된 데이터를 파싱하여 변환하는 함수 (while(1) 루프에서 호출)
 void IMU_Process_Data(void);
 
 // 최신 IMU 데이터 반환 (Getter)
 IMU_Data_t IMU_Get_Data(void);
 
+// 수신/파싱 통계 조회
+const IMU_Stats_t* IMU_Get_Stats(void);
+
 #endif /* INC_IMU_DRIVER_H_ */
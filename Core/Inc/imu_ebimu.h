@@ -0,0 +1,75 @@
+/*
+ * imu_ebimu.h
+ * Description: EBIMU 출력 프레임 파서 (ASCII "*roll,pitch,yaw\r\n", 오일러 각 출력 모드)
+ * 길이를 받아 한 번 훑으면서 숫자를 바로 만들기 때문에 NUL 종료/힙/로케일(newlib strtof)이 필요 없고,
+ * 필드마다 형식을 검사해 오류 종류를 돌려줌
+ * 수정사항: 바이너리(HEX) 출력 프레임 디코더와 설정 명령 추가
+ * 수정사항: 보레이트/출력 주기 설정 명령 생성 (<sbN>, <sorN>)
+ * Note: 바이너리 프레임 = SOP(0x55 0x55) + roll/pitch/yaw (int16 빅엔디안, 0.01도) + 체크섬
+ *       (SOP부터 데이터까지 바이트 합의 하위 16비트, 빅엔디안) = 10바이트 (ASCII는 약 21바이트)
+ *       두 파서는 호스트 퍼저로 검증 (Tests/fuzz_ebimu.c, ASCII 결과는 strtof와 비트 단위 비교)
+ */
+
+#ifndef INC_IMU_EBIMU_H_
+#define INC_IMU_EBIMU_H_
+
+#include "main.h"
+#include "imu_driver.h"
+
+#define EBIMU_ASCII_FIELDS 3        // roll, pitch, yaw
+#define EBIMU_MAX_DIGITS   7        // 필드 1개의 정수부+소수부 자릿수 상한 (float 가수부에 정확히 들어가는 범위)
+#define EBIMU_ANGLE_LIMIT  360.0f   // 각도 절대값 상한 (넘으면 잡음으로 판단)
+
+#define EBIMU_BIN_SOP       0x55    // 바이너리 프레임 시작 바이트 (2회 연속)
+#define EBIMU_BIN_FRAME_LEN 10      // SOP 2 + 데이터 6 + 체크섬 2
+#define EBIMU_BIN_DIV       100.0f  // 바이너리 각도 단위 0.01도 (나눗셈이라 같은 값의 ASCII 파싱 결과와 동일)
+
+// 설정 명령 (응답: "<ok>")
+#define EBIMU_CMD_EULER  "<sof1>" // 출력 항목: 오일러 각
+#define EBIMU_CMD_BINARY "<soc2>" // 출력 형식: HEX (바이너리)
+#define EBIMU_ACK        "<ok>"
+#define EBIMU_CMD_MAX    12       // 숫자 인자가 붙는 명령 최대 길이 ("<sor1000>" + NUL)
+
+#define EBIMU_BAUD_DEFAULT 115200 // 공장 설정 보레이트
+#define EBIMU_BAUD_COUNT   8      // <sb1>(9600) ~ <sb8>(921600)
+
+// 파싱 결과 (IMU_Stats_t의 last_parse_error에 기록)
+typedef enum {
+	EBIMU_OK = 0,
+	EBIMU_ERR_EMPTY,  // 숫자가 없는 필드
+	EBIMU_ERR_CHAR,   // 허용되지 않은 문자 (숫자, 부호, 소수점, 공백, 콤마 외)
+	EBIMU_ERR_DIGITS, // 자릿수 초과
+	EBIMU_ERR_FIELDS, // 필드 수가 EBIMU_ASCII_FIELDS가 아님
+	EBIMU_ERR_RANGE,  // 각도가 EBIMU_ANGLE_LIMIT를 넘음
+	EBIMU_ERR_CHECKSUM // 바이너리 프레임 SOP/길이/체크섬 불일치
+} EBIMU_Result_t;
+
+// 파서 벤치마크 결과 (프레임 1개당 CPU 사이클)
+typedef struct {
+	uint16_t frame_len;   // 측정에 사용한 프레임 길이 ('*'부터 줄바꿈 직전까지)
+	uint32_t cycles_libc; // 기존 방식: 버퍼 복사 + strrchr + strtok_r + strtof
+	uint32_t cycles_fast; // EBIMU_Parse_Ascii
+	uint32_t cycles_binary; // EBIMU_Parse_Binary (같은 값의 바이너리 프레임)
+	uint8_t match;        // 1: 세 방식의 결과가 같음
+} EBIMU_Bench_t;
+
+// --- 함수 프로토타입 선언 ---
+
+// '*' 다음 문자부터 줄바꿈 직전까지 len바이트 파싱 (성공할 때만 out 갱신)
+EBIMU_Result_t EBIMU_Parse_Ascii(const uint8_t *p, uint16_t len, IMU_Data_t *out);
+
+// SOP부터 체크섬까지 len바이트(EBIMU_BIN_FRAME_LEN) 검증 후 디코딩 (성공할 때만 out 갱신)
+EBIMU_Result_t EBIMU_Parse_Binary(const uint8_t *p, uint16_t len, IMU_Data_t *out);
+
+// 보레이트 명령 번호 (<sbN>의 N, 지원하지 않는 보레이트면 0)
+uint8_t EBIMU_Baud_Code(uint32_t baud);
+// 보레이트 표 (code 1 ~ EBIMU_BAUD_COUNT, 범위 밖이면 0)
+uint32_t EBIMU_Baud_Of_Code(uint8_t code);
+
+// 숫자 인자 명령 생성: "<" name value ">" (예: "sor", 5 -> "<sor5>"), 반환값: 길이 (buf는 EBIMU_CMD_MAX 이상)
+uint16_t EBIMU_Format_Command(char *buf, const char *name, uint16_t value);
+
+// DWT 사이클 카운터로 기존 newlib 방식, ASCII/바이너리 파서 속도 비교 (iterations회 평균, Debug 빌드는 부팅 시 main.c가 호출 -> imu_bench)
+void EBIMU_Benchmark(EBIMU_Bench_t *result, uint32_t iterations);
+
+#endif /* INC_IMU_EBIMU_H_ */
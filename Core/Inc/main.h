@@ -53,7 +53,8 @@ extern "C" {
 void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
-
+// DWT 사이클 카운터 활성화 (부팅 시 1회, 사이클 시각을 쓰는 모듈 초기화 전)
+void DWT_Cycle_Init(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
@@ -0,0 +1,95 @@
+/*
+ * robot_topology.h
+ * Description: 로봇 모터 구성 (다리, 다리별 관절, 모델, ID, 회전 방향, 영점)
+ * 아래 표(X-매크로)가 유일한 구성 원본이며, robot_topology.c에서 컴파일 시점에
+ * ID/방향/영점별 평탄한 배열(구조체 배열이 아닌 항목별 배열)로 전개됨.
+ * 관절 인덱스 = 다리 * JOINTS_PER_LEG + 역할 (0: 고관절, 1: 무릎)
+ * 다리 2개 구성은 빌드 옵션 -DROBOT_VARIANT=ROBOT_VARIANT_2LEG로 선택 (코드 분기 없음)
+ */
+
+#ifndef INC_ROBOT_TOPOLOGY_H_
+#define INC_ROBOT_TOPOLOGY_H_
+
+#include <stdint.h>
+#include "dxl_model.h"
+
+#define ROBOT_VARIANT_4LEG 4 // 다리 4개 (앞/뒤 각 2개)
+#define ROBOT_VARIANT_2LEG 2 // 다리 2개 (좌/우)
+
+#ifndef ROBOT_VARIANT
+#define ROBOT_VARIANT ROBOT_VARIANT_4LEG
+#endif
+
+#define JOINTS_PER_LEG 2 // 고관절, 무릎
+
+// ROBOT_LEG_TABLE(X):   X(이름, 피치 보정 부호)  - 몸체가 앞으로 기울면 +1 다리는 늘리고 -1 다리는 줄임
+// ROBOT_JOINT_TABLE(X): X(다리, ID, 모델, 방향, 영점)  - 관절 인덱스 순서
+// ROBOT_WHEEL_TABLE(X): X(다리, ID, 모델, 방향)        - 다리 순서
+#if ROBOT_VARIANT == ROBOT_VARIANT_4LEG
+
+#define ROBOT_LEG_TABLE(X) \
+	X(FR, +1) /* 다리 1: 앞 오른쪽 */ \
+	X(FL, +1) /* 다리 2: 앞 왼쪽 */ \
+	X(RR, -1) /* 다리 3: 뒤 오른쪽 */ \
+	X(RL, -1) /* 다리 4: 뒤 왼쪽 */
+
+#define ROBOT_JOINT_TABLE(X) \
+	X(0, 1,  DXL_MODEL_MX106, +1, 2048) X(0, 2,  DXL_MODEL_MX64, -1, 2048) \
+	X(1, 11, DXL_MODEL_MX106, +1, 2048) X(1, 12, DXL_MODEL_MX64, -1, 2048) \
+	X(2, 21, DXL_MODEL_MX106, +1, 2048) X(2, 22, DXL_MODEL_MX64, -1, 2048) \
+	X(3, 31, DXL_MODEL_MX106, +1, 2048) X(3, 32, DXL_MODEL_MX64, -1, 2048)
+
+#define ROBOT_WHEEL_TABLE(X) \
+	X(0, 3,  DXL_MODEL_AX12, +1) \
+	X(1, 13, DXL_MODEL_AX12, +1) \
+	X(2, 23, DXL_MODEL_AX12, +1) \
+	X(3, 33, DXL_MODEL_AX12, +1)
+
+#elif ROBOT_VARIANT == ROBOT_VARIANT_2LEG
+
+#define ROBOT_LEG_TABLE(X) \
+	X(R, 0) /* 다리 1: 오른쪽 (피치는 바퀴로 보정) */ \
+	X(L, 0) /* 다리 2: 왼쪽 */
+
+#define ROBOT_JOINT_TABLE(X) \
+	X(0, 1,  DXL_MODEL_MX106, +1, 2048) X(0, 2,  DXL_MODEL_MX64, -1, 2048) \
+	X(1, 11, DXL_MODEL_MX106, +1, 2048) X(1, 12, DXL_MODEL_MX64, -1, 2048)
+
+#define ROBOT_WHEEL_TABLE(X) \
+	X(0, 3,  DXL_MODEL_AX12, +1) \
+	X(1, 13, DXL_MODEL_AX12, -1) /* 좌우 대칭 장착 */
+
+#else
+#error "ROBOT_VARIANT: ROBOT_VARIANT_4LEG 또는 ROBOT_VARIANT_2LEG"
+#endif
+
+// 표 항목 수 (상수식 - 배열 크기에 사용)
+#define ROBOT_COUNT_ONE(...) + 1
+#define LEG_COUNT   (0 ROBOT_LEG_TABLE(ROBOT_COUNT_ONE))
+#define JOINT_COUNT (0 ROBOT_JOINT_TABLE(ROBOT_COUNT_ONE))
+
+// 모터 1개당 1비트 마스크(uint8_t)를 쓰는 모듈이 있으므로 관절/바퀴는 8개 이하
+#if (JOINT_COUNT > 8) || (LEG_COUNT > 8)
+#error "관절/바퀴는 각각 8개 이하"
+#endif
+
+// --- 전개된 배열 (robot_topology.c) ---
+extern const uint8_t robot_joint_ids[JOINT_COUNT];
+extern const uint8_t robot_joint_leg[JOINT_COUNT];
+extern const DXL_Model_t robot_joint_model[JOINT_COUNT];
+extern const int8_t robot_joint_dir[JOINT_COUNT];
+extern const uint16_t robot_joint_zero[JOINT_COUNT];
+extern const uint8_t robot_wheel_ids[LEG_COUNT];
+extern const DXL_Model_t robot_wheel_model[LEG_COUNT];
+extern const int8_t robot_wheel_dir[LEG_COUNT];
+extern const int8_t robot_leg_pitch_sign[LEG_COUNT];
+
+// --- 함수 프로토타입 선언 ---
+
+// 관절 각도(rad, 영점 기준) -> 목표 위치(틱): 영점 + 방향 * 각도 (관절마다 같은 연산, 분기 없음)
+void Robot_Joint_Angles_To_Goals(const float *angle_rad, uint32_t *goals);
+
+// 바퀴 속도(로봇 기준, 전진 +) -> 모터 속도 (장착 방향 반영)
+void Robot_Wheel_Speeds_To_Goals(const int16_t *speed, int16_t *goals);
+
+#endif /* INC_ROBOT_TOPOLOGY_H_ */
@@ -2,34 +2,38 @@
  * dxl_2_0.c
  * 12축 모터 통합 제어 및 통신 패킷 생성 구현부 (수정본)
  * 수정사항: 토크 제어 전용 Sync Write 패킷 함수 추가
+ * 수정사항: 패킷을 송신 큐 슬롯에 직접 작성하고, 여러 패킷을 한 버스트로 연속 송신
+ * 수정사항: Sync Write 패킷을 부팅 시 템플릿으로 만들고 매 주기에는 목표값과 CRC만 갱신
+ * 수정사항: Sync Read / Fast Sync Read로 관절 8개의 현재 위치/속도/전류 수신
+ * 수정사항: 데이터에 FF FF FD가 나타나면 바이트 스터핑(FD 삽입) 후 길이/CRC 재계산
+ * 수정사항: 버스 스케줄러용 슬롯 비용 조회와 순환 진단 읽기(Hardware Error Status) 추가
+ * 수정사항: 단일 모터 Ping/Read/Write 요청-응답 함수 (프로토콜 2.0/1.0, 부팅 설정용)
+ * 수정사항: 값이 바뀐 모터만 담는 부분 Sync Write (명령 캐시용)
+ * 수정사항: Indirect Address 매핑으로 위치/프로파일/전류를 Sync Write 1개, 상태/진단을 Sync Read 1개로 처리
+ * 수정사항: 프로파일 속도/가속도 송신과 Drive Mode(시간 기준 프로파일) 설정 추가
+ * 수정사항: 주소/크기를 모델 등록부(dxl_model)에서 조회하고 범용 Sync Write/Sync Read 추가
+ * 수정사항: legs[] 표 대신 robot_topology의 관절/바퀴 ID 배열 사용 (다리 수는 빌드 설정)
+ * 수정사항: 모터별 송신/응답/CRC 오류/응답 없음/하드웨어 오류 카운터와 응답 지연 기록 (dxl_health)
+ * 수정사항: 하드웨어 오류 복구용 단일 요청(Reboot, Indirect 재설정, 토크, 확인 읽기)과 상태 읽기 대상 관절 선택
+ * 수정사항: 비상 정지용 토크 OFF 패킷(2.0/1.0)을 미리 만들어 두고 dxl_estop 경로로 송신
+ * 수정사항: 진단 스윕 요청(관절 Sync Read, 바퀴 1.0 Read)과 응답 해석 (1.0 상태 패킷 조립기를 공용으로 분리)
  */
 
 #include "dxl_2_0.h"
 #include "usart.h"
+#include "dxl_bus.h"
+#include "dxl_crc.h"
+#include "dxl_status.h"
+#include "dxl_health.h"
+#include "dxl_estop.h"
+#include "dxl_diag.h"
 #include <string.h>
 
 // ---------------------------------------------------------------------------
 // 1. 전역 변수 및 테이블 정의
 // ---------------------------------------------------------------------------
 
-// 다리별 모터 ID 매핑 (ID: 1, 11, 21, 31 시리즈)
-LegMotors legs[5] = { { 0, 0, 0 }, { 1, 2, 3 },  // 다리 1: 앞 오른쪽 (FR)
-		{ 11, 12, 13 }, // 다리 2: 앞 왼쪽 (FL)
-		{ 21, 22, 23 }, // 다리 3: 뒤 오른쪽 (RR)
-		{ 31, 32, 33 }  // 다리 4: 뒤 왼쪽 (RL)
-};
-
-// 프로토콜 2.0용 CRC16 참조 테이블 (DYNAMIXEL 표준)
-const unsigned short crc_table[256] = { 0x0000, 0x8005, 0x800F, 0x000A, 0x801B,
-		0x001E, 0x0014, 0x8011, 0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D,
-		0x8027, 0x0022, 0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077,
-		0x0072, 0x0050, 0x8055, 0x805F, 0x005A, 0x804B, 0x004E, 0x0044, 0x8041,
-		0x80C3, 0x00C6, 0x00CC, 0x80C9, 0x00D8, 0x80DD, 0x80D7, 0x00D2, 0x00F0,
-		0x80F5, 0x80FF, 0x00FA, 0x81EB, 0x01EE, 0x01E4, 0x81E1, 0x8103, 0x0106,
-		0x010C, 0x8109, 0x0118, 0x811D, 0x8117, 0x0112, 0x0130, 0x8135, 0x813F,
-		0x013A, 0x812B, 0x012E, 0x0124, 0x8121
-// (참고: 실제 CRC 테이블은 256개 값이 모두 있어야 정확합니다. 공간상 일부만 표시했으나 기존 값을 그대로 쓰세요)
-		};
+// 모터 ID/방향/영점은 robot_topology.h 표에서 정의 (robot_joint_ids, robot_wheel_ids)
 
 // ---------------------------------------------------------------------------
 // 2. 통신 유틸리티 함수
@@ -43,28 +47,74 @@ uint8_t calculate_checksum_1_0(uint8_t *data, uint16_t length) {
 	return (uint8_t) (~(checksum & 0xFF));
 }
 
+#define DXL_PACKET_MAX    64   // 단일 요청/응답 패킷 최대 길이
+#define DXL_1_0_FAIL_MASK 0x58 // 1.0 Error 중 명령이 처리되지 않은 경우 (Instruction, Checksum, Range)
+
+// 프로토콜 1.0 상태 패킷 조립기 (2.0 디코더와 달리 헤더가 FF FF뿐이라 바이트 단위로 길이까지 확인)
+typedef struct {
+	uint8_t frame[DXL_PACKET_MAX];
+	uint16_t idx;
+} DXL_Frame_1_0_t;
+
+// 1바이트 추가: 패킷이 완성되면 길이 반환 (체크섬 검사는 호출자), 아니면 0
+static uint16_t frame_1_0_push(DXL_Frame_1_0_t *f, uint8_t b) {
+	uint8_t *frame = f->frame;
+	frame[f->idx++] = b;
+
+	if (f->idx <= 2) { // 헤더 FF FF
+		if (b != 0xFF)
+			f->idx = 0;
+		return 0;
+	}
+	if (f->idx == 3 && b == 0xFF) { // FF가 더 이어지면 마지막 두 개를 헤더로 간주
+		f->idx = 2;
+		return 0;
+	}
+	if (f->idx == 4 && (b < 2 || b > DXL_PACKET_MAX - 4)) {
+		f->idx = 0;
+		return 0;
+	}
+	if (f->idx < 4 || f->idx < 4 + frame[3])
+		return 0;
+
+	uint16_t len = f->idx;
+	f->idx = 0;
+	return len;
+}
+
 // 프로토콜 2.0 CRC16 계산 (MX 시리즈용)
+// 하드웨어(CRC 주변장치)/소프트웨어(slice-by-8) 백엔드 선택은 dxl_crc 모듈이 담당
 unsigned short update_crc(unsigned short crc_accum, unsigned char *data_blk_ptr,
 		unsigned short data_blk_size) {
-	unsigned short i, j;
-	for (j = 0; j < data_blk_size; j++) {
-		i = ((unsigned short) (crc_accum >> 8) ^ data_blk_ptr[j]) & 0xFF;
-		crc_accum = (unsigned short) (crc_accum << 8) ^ crc_table[i];
-	}
-	return crc_accum;
+	return DXL_CRC_Update(crc_accum, data_blk_ptr, data_blk_size);
 }
 
-// UART3 패킷 전송 (RS-485 방향 제어 포함)
-void uart_transmit_packet(uint8_t *data, uint16_t size) {
-	HAL_GPIO_WritePin(GPIOB, GPIO_PIN_12, GPIO_PIN_SET); // 송신 모드로 전환
+// 프로토콜 2.0 바이트 스터핑: INST ~ 파라미터 구간을 복사하면서 FF FF FD 다음에 FD 삽입
+// (수신 측이 헤더로 오인하지 않도록 함, dst는 len + len/3 바이트 이상 필요, 복사된 길이 반환)
+uint16_t dxl_stuff_copy(uint8_t *dst, const uint8_t *src, uint16_t len) {
+	uint16_t out = 0;
+	uint8_t match = 0; // 연속으로 일치한 FF FF FD 바이트 수
 
-	HAL_UART_Transmit(&huart3, data, size, 10); // 데이터 전송 시작
+	for (uint16_t i = 0; i < len; i++) {
+		uint8_t b = src[i];
+		dst[out++] = b;
 
-	// 마지막 한 비트까지 완전히 전송될 때까지 하드웨어 플래그(TC) 대기
-	while (__HAL_UART_GET_FLAG(&huart3, UART_FLAG_TC) == RESET)
-		;
+		if (b == 0xFF) {
+			match = match ? 2 : 1;
+		} else if (match == 2 && b == 0xFD) {
+			dst[out++] = 0xFD;
+			match = 0;
+		} else {
+			match = 0;
+		}
+	}
+	return out;
+}
 
-	HAL_GPIO_WritePin(GPIOB, GPIO_PIN_12, GPIO_PIN_RESET); // 전송 즉시 수신 모드로 복귀
+// UART3 패킷 즉시 전송 (RS-485 방향 제어는 dxl_bus의 TC 인터럽트가 담당)
+void uart_transmit_packet(uint8_t *data, uint16_t size) {
+	// 송신 큐에 넣고 바로 버스트 시작 -> DMA 송신 중 CPU는 IK/IMU 파싱 수행 가능
+	DXL_Bus_Transmit(data, size);
 }
 
 // 바퀴 속도값 변환 (-1023 ~ 1023 -> AX 모터 프로토콜 포맷)
@@ -79,13 +129,42 @@ uint16_t clc_speed_1(int16_t wheel_speed) {
 }
 
 // ---------------------------------------------------------------------------
-// 3. Sync Write 패킷 생성 함수 (위치/속도 제어)
+// 3. Sync Write 패킷 템플릿 (부팅 시 1회 생성)
 // ---------------------------------------------------------------------------
+// 헤더/길이/명령어/주소/ID 바이트는 매 주기 같으므로 DXL_Init()에서 미리 만들어 두고,
+// 첫 번째 데이터 직전까지의 CRC(또는 체크섬) 중간값을 저장해 둠.
+// 매 주기에는 고정 위치에 목표값만 쓰고, 바뀐 구간에 대해서만 CRC를 마저 계산함.
+
+#define DXL_TPL_MAX_LEN 144 // 템플릿 최대 길이 (관절 8개 Indirect 복합 명령 Sync Write = 134바이트)
 
-// [위치 제어] 8개 관절(MX 시리즈) 동시 제어
-void send_sync_write_2_joints(uint32_t *hip_pos, uint32_t *knee_pos) {
-	uint8_t id_count = 8;
-	uint8_t packet[128];
+typedef struct {
+	uint8_t buf[DXL_TPL_MAX_LEN];
+	uint16_t len;        // 전체 패킷 길이 (CRC/체크섬 포함)
+	uint16_t data_start; // 첫 번째 데이터 바이트 위치 (여기부터 매 주기 바뀜)
+	uint16_t prefix;     // 2.0: data_start 직전까지의 CRC / 1.0: 고정 바이트 합
+	uint8_t protocol;    // 1 또는 2
+	uint8_t data_len;    // 모터 1개당 데이터 길이
+	uint8_t id_count;    // 모터 수
+} DXL_Frame_Template_t;
+
+static DXL_Frame_Template_t tpl_joint_pos;    // MX 8개 목표 위치
+static DXL_Frame_Template_t tpl_wheel_speed;  // AX 4개 목표 속도
+static DXL_Frame_Template_t tpl_torque_mx;    // MX 8개 토크 ON/OFF
+static DXL_Frame_Template_t tpl_torque_ax;    // AX 4개 토크 ON/OFF
+static DXL_Frame_Template_t tpl_read_sync;    // MX 8개 상태 Sync Read 요청
+static DXL_Frame_Template_t tpl_read_fast;    // MX 8개 상태 Fast Sync Read 요청
+static DXL_Frame_Template_t tpl_joint_cmd;    // MX 8개 Indirect 복합 명령 (DXL_Indirect_Setup 성공 후 생성)
+
+static uint8_t joint_all[JOINT_COUNT]; // 관절 인덱스 0 ~ JOINT_COUNT-1 (전체 관절 부분 송신용)
+
+#define DXL_READ_LEN 14 // 프로토콜 2.0 Read 요청 길이 (헤더 7 + INST 1 + 주소 2 + 길이 2 + CRC 2)
+static uint8_t diag_req[JOINT_COUNT][DXL_READ_LEN]; // 관절별 Hardware Error Status 읽기 요청
+static uint8_t diag_next = 0;                       // 다음 진단 대상 관절
+
+// 프로토콜 2.0 Sync Write 템플릿 생성
+static void tpl_build_2_0(DXL_Frame_Template_t *tpl, uint16_t addr,
+		uint8_t data_len, const uint8_t *ids, uint8_t id_count) {
+	uint8_t *packet = tpl->buf;
 	uint16_t idx = 0;
 
 	packet[idx++] = 0xFF;
@@ -94,132 +173,322 @@ void send_sync_write_2_joints(uint32_t *hip_pos, uint32_t *knee_pos) {
 	packet[idx++] = 0x00; // Reserved
 	packet[idx++] = 0xFE; // Broadcast ID
 
-	uint16_t length = 7 + (id_count * (MX_DATA_LEN + 1));
+	// Length: Inst(1)+Addr(2)+Len(2) + N*(ID(1)+Data) + CRC(2)
+	uint16_t length = 7 + (id_count * (data_len + 1));
 	packet[idx++] = length & 0xFF;
 	packet[idx++] = (length >> 8) & 0xFF;
 
 	packet[idx++] = 0x83; // Inst: Sync Write
-	packet[idx++] = DXL_2_Goal_Position & 0xFF;
-	packet[idx++] = (DXL_2_Goal_Position >> 8) & 0xFF; // Addr 116
-	packet[idx++] = MX_DATA_LEN & 0xFF;
-	packet[idx++] = (MX_DATA_LEN >> 8) & 0xFF; // Len 4
-
-	for (int i = 1; i <= 4; i++) {
-		// Hip Motor
-		packet[idx++] = legs[i].hip;
-		packet[idx++] = hip_pos[i - 1] & 0xFF;
-		packet[idx++] = (hip_pos[i - 1] >> 8) & 0xFF;
-		packet[idx++] = (hip_pos[i - 1] >> 16) & 0xFF;
-		packet[idx++] = (hip_pos[i - 1] >> 24) & 0xFF;
-
-		// Knee Motor
-		packet[idx++] = legs[i].knee;
-		packet[idx++] = knee_pos[i - 1] & 0xFF;
-		packet[idx++] = (knee_pos[i - 1] >> 8) & 0xFF;
-		packet[idx++] = (knee_pos[i - 1] >> 16) & 0xFF;
-		packet[idx++] = (knee_pos[i - 1] >> 24) & 0xFF;
-	}
-
-	unsigned short crc = update_crc(0, packet, idx);
-	packet[idx++] = crc & 0xFF;
-	packet[idx++] = (crc >> 8) & 0xFF;
-	uart_transmit_packet(packet, idx);
+	packet[idx++] = addr & 0xFF;
+	packet[idx++] = (addr >> 8) & 0xFF;
+	packet[idx++] = data_len;
+	packet[idx++] = 0x00;
+
+	for (uint8_t i = 0; i < id_count; i++) {
+		packet[idx++] = ids[i];
+		memset(&packet[idx], 0, data_len);
+		idx += data_len;
+	}
+
+	tpl->protocol = 2;
+	tpl->data_len = data_len;
+	tpl->id_count = id_count;
+	tpl->data_start = 12 + 1; // 첫 번째 ID 다음
+	tpl->prefix = update_crc(0, packet, tpl->data_start);
+	tpl->len = idx + 2;
 }
 
-// [속도 제어] 4개 바퀴(AX 시리즈) 동시 제어
-void send_sync_write_1_wheel(int16_t *wheel_speeds) {
-	uint8_t id_count = 4;
-	uint8_t packet[64];
+// 프로토콜 1.0 Sync Write 템플릿 생성
+static void tpl_build_1_0(DXL_Frame_Template_t *tpl, uint8_t addr,
+		uint8_t data_len, const uint8_t *ids, uint8_t id_count) {
+	uint8_t *packet = tpl->buf;
 	uint16_t idx = 0;
 
 	packet[idx++] = 0xFF;
 	packet[idx++] = 0xFF; // Header
 	packet[idx++] = 0xFE; // Broadcast ID
-	packet[idx++] = 4 + (id_count * (AX_DATA_LEN + 1)); // Length
+	packet[idx++] = 4 + (id_count * (data_len + 1)); // Length
 	packet[idx++] = 0x83; // Inst: Sync Write
-	packet[idx++] = DXL_1_MOVING_SPEED; // Addr 32
-	packet[idx++] = AX_DATA_LEN; // Data Length 2
+	packet[idx++] = addr;
+	packet[idx++] = data_len;
 
-	for (int i = 1; i <= 4; i++) {
-		packet[idx++] = legs[i].wheel;
-		uint16_t speed_val = clc_speed_1(wheel_speeds[i - 1]);
-		packet[idx++] = speed_val & 0xFF;
-		packet[idx++] = (speed_val >> 8) & 0xFF;
+	for (uint8_t i = 0; i < id_count; i++) {
+		packet[idx++] = ids[i];
+		memset(&packet[idx], 0, data_len);
+		idx += data_len;
 	}
 
-	packet[idx] = calculate_checksum_1_0(packet, idx);
-	idx++;
-	uart_transmit_packet(packet, idx);
+	// 데이터가 모두 0인 상태의 합 = 고정 바이트(ID, 헤더 필드)의 합
+	uint32_t sum = 0;
+	for (uint16_t i = 2; i < idx; i++)
+		sum += packet[i];
+
+	tpl->protocol = 1;
+	tpl->data_len = data_len;
+	tpl->id_count = id_count;
+	tpl->data_start = 7 + 1;
+	tpl->prefix = (uint16_t) sum;
+	tpl->len = idx + 1;
 }
 
-// ---------------------------------------------------------------------------
-// 4. [신규 추가] Sync Write 패킷 생성 함수 (토크 제어)
-// ---------------------------------------------------------------------------
+// 모터 i번째 데이터 위치 반환
+static inline uint8_t* tpl_data(DXL_Frame_Template_t *tpl, uint8_t i) {
+	return &tpl->buf[tpl->data_start + i * (tpl->data_len + 1)];
+}
 
-// [토크 제어] MX 시리즈(관절 8개) 토크 ON/OFF
-void send_sync_torque_mx(uint8_t on_off) {
-	uint8_t packet[128];
+// 리틀 엔디안으로 size바이트 기록
+static inline void put_le(uint8_t *d, uint32_t v, uint8_t size) {
+	for (uint8_t b = 0; b < size; b++)
+		d[b] = (v >> (8 * b)) & 0xFF;
+}
+
+// 모터 i번째 데이터에 값 기록 (템플릿의 모터당 데이터 길이만큼)
+static inline void tpl_put(DXL_Frame_Template_t *tpl, uint8_t i, uint32_t v) {
+	put_le(tpl_data(tpl, i), v, tpl->data_len);
+}
+
+// 등록부 항목으로 Sync Write 템플릿 생성 (모델의 프로토콜로 2.0/1.0 선택)
+// 쓸 수 없는 항목이거나 템플릿 버퍼를 넘으면 HAL_ERROR
+static HAL_StatusTypeDef tpl_build_field(DXL_Frame_Template_t *tpl, DXL_Model_t model,
+		DXL_Field_t field, const uint8_t *ids, uint8_t id_count) {
+	const DXL_Model_Info_t *m = DXL_Model_Get(model);
+	const DXL_Field_Info_t *f = DXL_Model_Field(model, field);
+
+	if (m == NULL || f == NULL || !(f->access & DXL_ACCESS_W))
+		return HAL_ERROR;
+
+	uint16_t fixed = (m->protocol == 2) ? 14 : 8; // 헤더 + INST + 주소 + 길이 + CRC(체크섬)
+	if (fixed + id_count * (f->size + 1) > DXL_TPL_MAX_LEN)
+		return HAL_ERROR;
+
+	if (m->protocol == 2)
+		tpl_build_2_0(tpl, f->addr, f->size, ids, id_count);
+	else
+		tpl_build_1_0(tpl, (uint8_t) f->addr, f->size, ids, id_count);
+	return HAL_OK;
+}
+
+// 스터핑이 필요할 수 있는 프레임: 송신 슬롯에 스터핑하며 복사하고 길이 필드와 CRC를 다시 계산
+static void tpl_queue_stuffed(DXL_Frame_Template_t *tpl) {
+	const uint8_t *packet = tpl->buf;
+	uint16_t body = tpl->len - 9; // INST ~ 마지막 데이터 (헤더 7바이트, CRC 2바이트 제외)
+
+	// FF FF FD는 모터 1개의 데이터 안에서만 생길 수 있음 (ID는 0xFC 이하) -> 3바이트마다 최대 1바이트 증가
+	uint8_t *slot = DXL_Bus_Slot_Acquire(tpl->len + tpl->id_count * (tpl->data_len / 3));
+	if (slot == NULL)
+		return;
+
+	memcpy(slot, packet, 7);
+	uint16_t idx = 7 + dxl_stuff_copy(&slot[7], &packet[7], body);
+
+	uint16_t length = idx - 7 + 2;
+	slot[5] = length & 0xFF;
+	slot[6] = (length >> 8) & 0xFF;
+
+	uint16_t crc = update_crc(0, slot, idx);
+	slot[idx++] = crc & 0xFF;
+	slot[idx++] = (crc >> 8) & 0xFF;
+
+	DXL_Bus_Slot_Commit(idx);
+}
+
+// 바뀐 구간만 CRC/체크섬 계산 (스터핑이 필요 없는 프레임)
+static void tpl_finish(DXL_Frame_Template_t *tpl) {
+	uint8_t *packet = tpl->buf;
+	if (tpl->protocol == 2) {
+		uint16_t end = tpl->len - 2;
+		uint16_t crc = update_crc(tpl->prefix, &packet[tpl->data_start], end - tpl->data_start);
+		packet[end] = crc & 0xFF;
+		packet[end + 1] = (crc >> 8) & 0xFF;
+	} else {
+		uint32_t sum = tpl->prefix;
+		for (uint8_t i = 0; i < tpl->id_count; i++) {
+			const uint8_t *d = tpl_data(tpl, i);
+			for (uint8_t b = 0; b < tpl->data_len; b++)
+				sum += d[b];
+		}
+		packet[tpl->len - 1] = (uint8_t) (~(sum & 0xFF));
+	}
+}
+
+// 바뀐 구간만 CRC/체크섬 계산 후 송신 큐에 추가
+// may_stuff: 0이면 호출자가 데이터에 FF FF FD가 없음을 보장 (스터핑 검사 생략)
+static void tpl_finish_and_queue(DXL_Frame_Template_t *tpl, uint8_t may_stuff) {
+	if (tpl->len == 0)
+		return; // DXL_Init() 이전 호출
+
+	// 모터별 송신 카운터 (ID는 각 모터 데이터 바로 앞 바이트)
+	for (uint8_t i = 0; i < tpl->id_count; i++)
+		DXL_Health_Sent(tpl_data(tpl, i)[-1]);
+
+	if (tpl->protocol == 2 && may_stuff && tpl->data_len >= 3) {
+		tpl_queue_stuffed(tpl); // 3바이트 미만 필드에는 FF FF FD가 들어갈 수 없음
+		return;
+	}
+
+	tpl_finish(tpl);
+	DXL_Bus_Enqueue(tpl->buf, tpl->len); // 송신은 DXL_Bus_Flush 시점에 시작
+}
+
+// 프로토콜 2.0 Sync Read / Fast Sync Read 요청 패킷 생성 (매 주기 동일하므로 CRC까지 완성)
+static void tpl_build_read(DXL_Frame_Template_t *tpl, uint8_t inst, uint16_t addr,
+		uint16_t data_len, const uint8_t *ids, uint8_t id_count) {
+	uint8_t *packet = tpl->buf;
 	uint16_t idx = 0;
-	uint8_t data_len = 1; // 토크 데이터는 1Byte (1 or 0)
 
 	packet[idx++] = 0xFF;
 	packet[idx++] = 0xFF;
 	packet[idx++] = 0xFD; // Header
-	packet[idx++] = 0x00;
+	packet[idx++] = 0x00; // Reserved
 	packet[idx++] = 0xFE; // Broadcast ID
 
-	// Length: Inst(1)+Addr(2)+Len(2) + N*(ID(1)+Data(1)) + CRC(2) -> Header 제외 길이
-	// Param Length = 7 + (8 * 2) = 23
-	uint16_t length = 7 + (8 * (data_len + 1));
+	// Length: Inst(1)+Addr(2)+Len(2) + N*ID(1) + CRC(2)
+	uint16_t length = 7 + id_count;
 	packet[idx++] = length & 0xFF;
 	packet[idx++] = (length >> 8) & 0xFF;
 
-	packet[idx++] = 0x83; // Inst: Sync Write
-	packet[idx++] = DXL_2_Torque_Enable & 0xFF;
-	packet[idx++] = (DXL_2_Torque_Enable >> 8) & 0xFF; // Addr 64
+	packet[idx++] = inst; // Inst: Sync Read(0x82) / Fast Sync Read(0x8A)
+	packet[idx++] = addr & 0xFF;
+	packet[idx++] = (addr >> 8) & 0xFF;
 	packet[idx++] = data_len & 0xFF;
-	packet[idx++] = (data_len >> 8) & 0xFF; // Data Len 1
+	packet[idx++] = (data_len >> 8) & 0xFF;
 
-	for (int i = 1; i <= 4; i++) {
-		// Hip
-		packet[idx++] = legs[i].hip;
-		packet[idx++] = on_off;
-		// Knee
-		packet[idx++] = legs[i].knee;
-		packet[idx++] = on_off;
-	}
+	for (uint8_t i = 0; i < id_count; i++)
+		packet[idx++] = ids[i];
 
-	unsigned short crc = update_crc(0, packet, idx);
+	uint16_t crc = update_crc(0, packet, idx);
 	packet[idx++] = crc & 0xFF;
 	packet[idx++] = (crc >> 8) & 0xFF;
-	uart_transmit_packet(packet, idx);
+
+	tpl->protocol = 2;
+	tpl->data_len = data_len;
+	tpl->id_count = id_count;
+	tpl->data_start = idx;
+	tpl->prefix = crc;
+	tpl->len = idx;
 }
 
-// [토크 제어] AX 시리즈(바퀴 4개) 토크 ON/OFF
-void send_sync_torque_ax(uint8_t on_off) {
-	uint8_t packet[64];
+// 프로토콜 2.0 단일 모터 Read(0x02) 요청 패킷 생성 (길이 DXL_READ_LEN)
+static void build_read_2_0(uint8_t *packet, uint8_t id, uint16_t addr, uint16_t data_len) {
 	uint16_t idx = 0;
-	uint8_t data_len = 1;
 
 	packet[idx++] = 0xFF;
 	packet[idx++] = 0xFF;
-	packet[idx++] = 0xFE; // Broadcast ID
-	// Length: Inst(1)+Addr(1)+Len(1) + N*(ID(1)+Data(1)) + Checksum(1) - 2(Header)
-	// = 2 + 1 + 1 + (4*2) = 12
-	packet[idx++] = (4 * (data_len + 1)) + 4;
+	packet[idx++] = 0xFD; // Header
+	packet[idx++] = 0x00; // Reserved
+	packet[idx++] = id;
+	packet[idx++] = 7;    // Length: Inst(1)+Addr(2)+Len(2)+CRC(2)
+	packet[idx++] = 0x00;
+	packet[idx++] = 0x02; // Inst: Read
+	packet[idx++] = addr & 0xFF;
+	packet[idx++] = (addr >> 8) & 0xFF;
+	packet[idx++] = data_len & 0xFF;
+	packet[idx++] = (data_len >> 8) & 0xFF;
 
-	packet[idx++] = 0x83; // Inst: Sync Write
-	packet[idx++] = DXL_1_Torque_Enable; // Addr 24
-	packet[idx++] = data_len; // Data Len 1
+	uint16_t crc = update_crc(0, packet, idx);
+	packet[idx++] = crc & 0xFF;
+	packet[idx++] = (crc >> 8) & 0xFF;
+}
+
+// robot_topology 구성으로부터 모든 Sync Write 템플릿 생성
+void DXL_Init(void) {
+	DXL_Health_Init();
+	for (int i = 0; i < JOINT_COUNT; i++)
+		joint_all[i] = (uint8_t) i;
 
-	for (int i = 1; i <= 4; i++) {
-		packet[idx++] = legs[i].wheel;
-		packet[idx++] = on_off;
+	tpl_build_field(&tpl_joint_pos, DXL_JOINT_MODEL, DXL_FIELD_GOAL_POSITION, robot_joint_ids, JOINT_COUNT);
+	tpl_build_field(&tpl_torque_mx, DXL_JOINT_MODEL, DXL_FIELD_TORQUE_ENABLE, robot_joint_ids, JOINT_COUNT);
+	tpl_build_field(&tpl_wheel_speed, DXL_WHEEL_MODEL, DXL_FIELD_GOAL_VELOCITY, robot_wheel_ids, LEG_COUNT);
+	tpl_build_field(&tpl_torque_ax, DXL_WHEEL_MODEL, DXL_FIELD_TORQUE_ENABLE, robot_wheel_ids, LEG_COUNT);
+
+	// 관절 상태 읽기: Present Current(126)부터 10바이트 = 전류, 속도, 위치
+	tpl_build_read(&tpl_read_sync, 0x82, DXL_JOINT_ADDR(PRESENT_CURRENT), JOINT_STATE_LEN, robot_joint_ids, JOINT_COUNT);
+	tpl_build_read(&tpl_read_fast, 0x8A, DXL_JOINT_ADDR(PRESENT_CURRENT), JOINT_STATE_LEN, robot_joint_ids, JOINT_COUNT);
+
+	// 진단 읽기: 관절마다 Hardware Error Status 1바이트
+	for (int i = 0; i < JOINT_COUNT; i++)
+		build_read_2_0(diag_req[i], robot_joint_ids[i], DXL_JOINT_ADDR(HARDWARE_ERROR_STATUS), 1);
+}
+
+// ---------------------------------------------------------------------------
+// 4. Sync Write 패킷 송신 함수 (위치/속도/토크 제어)
+// ---------------------------------------------------------------------------
+
+// [위치 제어] 관절 전체(MX 시리즈) 동시 제어 (goals: 관절 인덱스 순 목표 위치)
+void send_sync_write_joints(const uint32_t *goals) {
+	uint32_t any = 0; // 모든 값의 OR (각 값은 이보다 작거나 같음)
+
+	for (int i = 0; i < JOINT_COUNT; i++) {
+		tpl_put(&tpl_joint_pos, i, goals[i]);
+		any |= goals[i];
 	}
+	// 정상 위치 범위(0 ~ 4095)는 항상 빠른 경로
+	tpl_finish_and_queue(&tpl_joint_pos, any >= DXL_STUFF_FREE_LIMIT);
+}
 
-	packet[idx] = calculate_checksum_1_0(packet, idx);
-	idx++;
-	uart_transmit_packet(packet, idx);
+// [속도 제어] 바퀴 전체(AX 시리즈) 동시 제어
+void send_sync_write_1_wheel(int16_t *wheel_speeds) {
+	for (int i = 0; i < LEG_COUNT; i++)
+		tpl_put(&tpl_wheel_speed, i, clc_speed_1(wheel_speeds[i]));
+	tpl_finish_and_queue(&tpl_wheel_speed, 0);
+}
+
+// [위치 제어] 일부 관절만 Sync Write (joints: 오름차순 관절 인덱스, pos: 관절 인덱스 순 목표 위치)
+void send_sync_write_joints_subset(const uint8_t *joints, const uint32_t *pos, uint8_t count) {
+	if (count == 0 || count > JOINT_COUNT || tpl_joint_pos.len == 0)
+		return;
+
+	// 전체 관절이면 부팅 시 만든 템플릿 사용 (고정 구간 CRC 재사용)
+	DXL_Frame_Template_t subset;
+	DXL_Frame_Template_t *tpl = &tpl_joint_pos;
+	if (count < JOINT_COUNT) {
+		uint8_t ids[JOINT_COUNT];
+		for (uint8_t i = 0; i < count; i++)
+			ids[i] = robot_joint_ids[joints[i]];
+		tpl_build_field(&subset, DXL_JOINT_MODEL, DXL_FIELD_GOAL_POSITION, ids, count);
+		tpl = &subset;
+	}
+
+	uint32_t any = 0;
+	for (uint8_t i = 0; i < count; i++) {
+		tpl_put(tpl, i, pos[joints[i]]);
+		any |= pos[joints[i]];
+	}
+	tpl_finish_and_queue(tpl, any >= DXL_STUFF_FREE_LIMIT);
+}
+
+// [속도 제어] 일부 바퀴만 Sync Write (wheels: 오름차순 다리 인덱스, speeds: 다리 순 속도)
+void send_sync_write_wheels_subset(const uint8_t *wheels, const int16_t *speeds, uint8_t count) {
+	if (count == 0 || count > LEG_COUNT || tpl_wheel_speed.len == 0)
+		return;
+
+	DXL_Frame_Template_t subset;
+	DXL_Frame_Template_t *tpl = &tpl_wheel_speed;
+	if (count < LEG_COUNT) {
+		uint8_t ids[LEG_COUNT];
+		for (uint8_t i = 0; i < count; i++)
+			ids[i] = robot_wheel_ids[wheels[i]];
+		tpl_build_field(&subset, DXL_WHEEL_MODEL, DXL_FIELD_GOAL_VELOCITY, ids, count);
+		tpl = &subset;
+	}
+
+	for (uint8_t i = 0; i < count; i++)
+		tpl_put(tpl, i, clc_speed_1(speeds[wheels[i]]));
+	tpl_finish_and_queue(tpl, 0);
+}
+
+// [토크 제어] MX 시리즈(관절 8개) 토크 ON/OFF
+void send_sync_torque_mx(uint8_t on_off) {
+	for (int i = 0; i < JOINT_COUNT; i++)
+		tpl_put(&tpl_torque_mx, i, on_off);
+	tpl_finish_and_queue(&tpl_torque_mx, 0);
+}
+
+// [토크 제어] AX 시리즈(바퀴 4개) 토크 ON/OFF
+void send_sync_torque_ax(uint8_t on_off) {
+	for (int i = 0; i < LEG_COUNT; i++)
+		tpl_put(&tpl_torque_ax, i, on_off);
+	tpl_finish_and_queue(&tpl_torque_ax, 0);
 }
 
 // ---------------------------------------------------------------------------
@@ -228,19 +497,1089 @@ void send_sync_torque_ax(uint8_t on_off) {
 
 // 로봇 전체 모터 토크 상태 설정 (버그 수정됨)
 void dxl_torque_set(uint8_t on_hip, uint8_t on_knee, uint8_t on_wheel) {
-	// 1. 관절(MX 시리즈) 토크 패킷 전송
+	// 1. 관절(MX 시리즈) 토크 패킷 큐에 추가
 	// on_hip 값을 대표로 사용하여 8개 관절 모두 제어
 	send_sync_torque_mx(on_hip);
 
-	// 통신 충돌 방지를 위한 최소 딜레이
-	HAL_Delay(5);
-
-	// 2. 바퀴(AX 시리즈) 토크 패킷 전송
+	// 2. 바퀴(AX 시리즈) 토크 패킷 큐에 추가
 	send_sync_torque_ax(on_wheel);
+
+	// 3. 두 패킷을 하나의 버스트로 연속 송신 (브로드캐스트라 응답이 없어 딜레이 불필요)
+	DXL_Bus_Flush();
 }
 
-// 긴급 상황 시 모든 모터의 힘을 뺌
+// 긴급 상황 시 모든 모터의 힘을 뺌 (송신 큐를 거치지 않는 비상 정지 경로, 이후 버스 잠금)
 void DXL_Emergency_All_Off(void) {
-	dxl_torque_set(0, 0, 0);
+	DXL_Estop_Trigger();
+}
+
+// 비상 정지용 토크 OFF 패킷 (관절 2.0 Sync Write + 바퀴 1.0 Sync Write)을 buf에 이어서 작성
+// 작성한 길이 반환 (DXL_Init 이전이거나 max가 부족하면 0)
+uint16_t DXL_Build_Torque_Off_Frames(uint8_t *buf, uint16_t max) {
+	DXL_Frame_Template_t *src[2] = { &tpl_torque_mx, &tpl_torque_ax };
+	DXL_Frame_Template_t tpl;
+	uint16_t n = 0;
+
+	for (int k = 0; k < 2; k++) {
+		if (src[k]->len == 0 || n + src[k]->len > max)
+			return 0;
+		tpl = *src[k]; // 평소 토크 템플릿은 그대로 둠
+		for (uint8_t i = 0; i < tpl.id_count; i++)
+			tpl_put(&tpl, i, 0);
+		tpl_finish(&tpl);
+		memcpy(&buf[n], tpl.buf, tpl.len);
+		n += tpl.len;
+	}
+	return n;
+}
+
+// ---------------------------------------------------------------------------
+// 6. 관절 상태 피드백 (Sync Read / Fast Sync Read)
+// ---------------------------------------------------------------------------
+// 요청은 Sync Write 뒤에 같은 버스트로 송신하고, 응답은 USART3 RX DMA 순환 버퍼에 쌓임.
+// 다음 제어 주기 시작 시 DXL_Poll_Joint_State()가 쌓인 바이트를 해석하여 상태 배열을 갱신함.
+// Fast Sync Read는 8개 모터의 응답이 하나의 상태 패킷으로 이어져 오므로 버스 점유 시간이 짧음:
+//   55 | ERR1 ID1 DATA1 CRC1 | ERR2 ID2 DATA2 CRC2 | ... | ERRn IDn DATAn | CRC
+// (첫 번째 ERR는 상태 패킷의 Error 필드, 마지막 모터의 CRC 자리는 패킷 CRC)
+
+#define FAST_READ_MAX_MISS 3 // 응답 없는 Fast Sync Read가 이만큼 이어지면 일반 Sync Read로 전환
+
+static DXL_Joint_State_t joint_state[JOINT_COUNT];
+static DXL_Status_Parser_t status_parser;
+static uint8_t status_parser_ready = 0;
+
+static uint8_t use_fast_read = DXL_USE_FAST_SYNC_READ;
+static uint8_t fast_read_pending = 0; // Fast Sync Read 요청 후 응답 대기 중
+static uint8_t fast_read_miss = 0;    // 응답 없이 지나간 연속 요청 수
+static uint16_t joint_read_len = JOINT_STATE_LEN; // 관절 1개당 읽기 길이 (Indirect 매핑 후 JOINT_BLOCK_LEN)
+
+// 응답 대기 중인 요청 (다음 요청 시점까지 응답이 없으면 모터별 응답 없음 카운터 증가)
+static uint8_t read_pending = 0;  // 비트 j: 관절 j의 상태 응답 대기 중
+static uint32_t read_stamp;       // 상태 읽기 요청을 큐에 넣은 시각 (DWT 사이클)
+static uint8_t diag_pending = 0;  // 진단 응답 대기 중인 관절 인덱스 + 1 (0: 없음)
+static uint32_t diag_stamp;       // 진단 요청을 큐에 넣은 시각
+
+// 상태 읽기/진단 대상 관절 (복구 중인 관절은 응답이 없거나 매핑이 풀려 있으므로 제외)
+static uint8_t joint_read_mask = (uint8_t) ((1U << JOINT_COUNT) - 1);
+static DXL_Joint_Check_t joint_check[JOINT_COUNT]; // 복구 확인 읽기 / Write 응답 결과
+
+// 모터 ID -> 관절 인덱스 (없으면 -1)
+static int joint_index_of(uint8_t id) {
+	for (int i = 0; i < JOINT_COUNT; i++) {
+		if (robot_joint_ids[i] == id)
+			return i;
+	}
+	return -1;
 }
 
+// 응답 데이터 해석 (리틀 엔디안): 전류 2 + 속도 4 + 위치 4
+// Indirect 매핑 블록이면 이어서 Hardware Error Status 1 + 입력 전압 2 + 온도 1
+static uint8_t joint_state_store(uint8_t id, uint8_t error, const uint8_t *d, uint32_t now) {
+	DXL_Health_Reply(id, error, read_stamp);
+	int j = joint_index_of(id);
+	if (j < 0)
+		return 0;
+	read_pending &= (uint8_t) ~(1U << j);
+
+	DXL_Joint_State_t *s = &joint_state[j];
+	s->current = (int16_t) (d[0] | (d[1] << 8));
+	s->velocity = (int32_t) (d[2] | (d[3] << 8) | (d[4] << 16) | ((uint32_t) d[5] << 24));
+	s->position = (int32_t) (d[6] | (d[7] << 8) | (d[8] << 16) | ((uint32_t) d[9] << 24));
+	if (joint_read_len >= JOINT_BLOCK_LEN) {
+		s->hw_error = d[10];
+		s->voltage = d[11] | (d[12] << 8);
+		s->temperature = d[13];
+		DXL_Health_Hw_Error(id, d[10]);
+	}
+	s->error = error;
+	s->valid = 1;
+	s->stamp = now;
+	return 1;
+}
+
+// 진단 슬롯 요청 1개 등록: 지난 요청의 응답이 아직 없으면 응답 없음으로 집계
+static void diag_begin(uint8_t j) {
+	if (diag_pending)
+		DXL_Health_Timeout(robot_joint_ids[diag_pending - 1]);
+	DXL_Health_Sent(robot_joint_ids[j]);
+	diag_pending = j + 1;
+	diag_stamp = DXL_Health_Now();
+}
+
+// 진단 스윕 응답 대기 (채움 슬롯에서 요청 1개, 응답은 dxl_diag 표에 기록)
+// 바퀴(1.0) 응답을 기다리는 동안에는 수신 바이트를 1.0 조립기로 해석 (그 시간에는 2.0 응답이 오지 않음)
+static uint8_t sweep_pending = 0; // 비트 j: 관절 j의 스윕 Sync Read 응답 대기 중
+static uint16_t sweep_len;        // 기다리는 파라미터 길이
+static uint32_t sweep_stamp;      // 스윕 요청을 큐에 넣은 시각 (DWT 사이클)
+static uint8_t sweep_wheel = 0;   // 1.0 응답 대기 중인 바퀴 인덱스 + 1 (0: 없음)
+static uint32_t sweep_deadline;   // 1.0 해석 구간 종료 시각 (채움 슬롯 선로 시간, DWT 사이클)
+static DXL_Frame_1_0_t sweep_rx;
+
+// 지난 스윕 요청 중 응답이 없던 모터를 응답 없음으로 집계
+static void sweep_expire(void) {
+	for (int j = 0; j < JOINT_COUNT; j++) {
+		if ((sweep_pending >> j) & 1)
+			DXL_Health_Timeout(robot_joint_ids[j]);
+	}
+	sweep_pending = 0;
+	if (sweep_wheel) {
+		DXL_Health_Timeout(robot_wheel_ids[sweep_wheel - 1]);
+		sweep_wheel = 0;
+	}
+}
+
+// 관절 스윕 응답이면 진단 표에 기록하고 1 반환
+static uint8_t sweep_joint_reply(const DXL_Status_Packet_t *pkt) {
+	if (!sweep_pending || pkt->param_len != sweep_len)
+		return 0;
+	int j = joint_index_of(pkt->id);
+	if (j < 0 || !((sweep_pending >> j) & 1))
+		return 0;
+
+	sweep_pending &= (uint8_t) ~(1U << j);
+	DXL_Health_Reply(pkt->id, pkt->error, sweep_stamp);
+	DXL_Diag_Store((uint8_t) j, pkt->error, pkt->params, pkt->param_len);
+	return 1;
+}
+
+// 바퀴 스윕 응답 해석: 소비한 바이트 수 반환 (응답을 찾으면 그 직후에서 멈춤)
+static uint16_t sweep_wheel_rx(const uint8_t *chunk, uint16_t n) {
+	uint8_t w = sweep_wheel - 1;
+
+	for (uint16_t i = 0; i < n; i++) {
+		uint16_t flen = frame_1_0_push(&sweep_rx, chunk[i]);
+		if (flen == 0)
+			continue;
+
+		uint8_t *frame = sweep_rx.frame;
+		if (frame[3] != sweep_len + 2)
+			continue; // 반이중 선로에서 되돌아온 요청 패킷 (길이 4) 등
+		if (frame[flen - 1] != calculate_checksum_1_0(frame, flen - 1)) {
+			DXL_Health_Crc_Error(frame[2]);
+			continue;
+		}
+		if (frame[2] != robot_wheel_ids[w])
+			continue;
+
+		uint8_t hw = frame[4] & (uint8_t) ~DXL_1_0_FAIL_MASK;
+		DXL_Health_Reply(frame[2], frame[4] & DXL_1_0_FAIL_MASK, sweep_stamp);
+		DXL_Health_Hw_Error(frame[2], hw);
+		DXL_Diag_Store(JOINT_COUNT + w, hw, &frame[5], sweep_len);
+		sweep_wheel = 0;
+		return i + 1;
+	}
+	return n;
+}
+
+// 상태 패킷 디코더 최초 사용 시 초기화
+static void status_parser_prepare(void) {
+	if (!status_parser_ready) {
+		DXL_Status_Init(&status_parser);
+		DXL_Bus_Rx_Discard(); // 부팅 중 들어온 잡음 제거
+		status_parser_ready = 1;
+	}
+}
+
+// 관절 8개 상태 읽기 요청을 송신 큐에 추가 (송신은 DXL_Bus_Flush 시점)
+void send_sync_read_joint_state(void) {
+	if (tpl_read_sync.len == 0)
+		return; // DXL_Init() 이전 호출
+
+	status_parser_prepare();
+
+	// 지난 요청의 응답이 아직 안 온 관절 = 응답 없음
+	for (int j = 0; j < JOINT_COUNT; j++) {
+		if ((read_pending >> j) & 1)
+			DXL_Health_Timeout(robot_joint_ids[j]);
+		if ((joint_read_mask >> j) & 1)
+			DXL_Health_Sent(robot_joint_ids[j]);
+	}
+	read_pending = joint_read_mask;
+	read_stamp = DXL_Health_Now();
+	sweep_expire(); // 지난 주기 채움 슬롯의 응답은 이미 끝났어야 함
+	if (tpl_read_sync.id_count == 0)
+		return; // 모든 관절이 복구 중
+
+	// 펌웨어가 Fast Sync Read를 지원하지 않으면 응답이 오지 않음 -> 일반 Sync Read로 전환
+	if (fast_read_pending) {
+		fast_read_pending = 0;
+		if (++fast_read_miss >= FAST_READ_MAX_MISS)
+			use_fast_read = 0;
+	}
+
+	if (use_fast_read) {
+		DXL_Bus_Enqueue(tpl_read_fast.buf, tpl_read_fast.len);
+		fast_read_pending = 1;
+	} else {
+		DXL_Bus_Enqueue(tpl_read_sync.buf, tpl_read_sync.len);
+	}
+}
+
+// 수신된 상태 패킷을 해석하여 관절 상태 갱신 (갱신된 관절 수 반환)
+// 응답 지연을 정확히 재려면 버스 스케줄러 대기 중에도 호출 (DXL_Sched_Set_Idle_Callback)
+uint8_t DXL_Poll_Joint_State(void) {
+	if (!status_parser_ready)
+		return 0;
+
+	uint8_t updated = 0;
+	uint32_t now = HAL_GetTick();
+	const uint8_t *chunk;
+	uint16_t n;
+
+	// 바퀴 스윕 응답 구간이 지났으면 다시 2.0 해석 (응답 없음 집계)
+	if (sweep_wheel && (int32_t) (DXL_Health_Now() - sweep_deadline) > 0)
+		sweep_expire();
+
+	// 순환 버퍼의 연속 구간을 디코더에 그대로 넘기고, 패킷 해석을 마친 뒤에 소비 처리
+	while ((n = DXL_Bus_Rx_Peek(&chunk)) > 0) {
+		if (sweep_wheel) {
+			DXL_Bus_Rx_Consume(sweep_wheel_rx(chunk, n));
+			continue;
+		}
+
+		DXL_Status_Packet_t pkt;
+		uint16_t used;
+		uint32_t crc_errors = status_parser.crc_errors;
+		uint8_t got = DXL_Status_Parse(&status_parser, chunk, n, &used, &pkt);
+
+		if (status_parser.crc_errors != crc_errors)
+			DXL_Health_Crc_Error(status_parser.crc_error_id); // Fast Sync Read(0xFE)는 모터를 알 수 없음
+		if (got) {
+			if (pkt.id == 0xFE) {
+				// Fast Sync Read 응답: 모터별 항목 간격 = ERR(1) + ID(1) + DATA + CRC(2)
+				const uint16_t stride = joint_read_len + 4;
+				uint16_t count = (pkt.param_len + 3) / stride;
+				for (uint16_t k = 0; k < count; k++) {
+					const uint8_t *e = &pkt.params[k * stride];
+					uint8_t error = (k == 0) ? pkt.error : e[-1];
+					updated += joint_state_store(e[0], error, &e[1], now);
+				}
+				fast_read_pending = 0;
+				fast_read_miss = 0;
+			} else if (sweep_joint_reply(&pkt)) {
+				// 진단 스윕 응답 (길이와 ID가 대기 중인 스윕 요청과 일치, dxl_diag 표에 기록됨)
+			} else if (pkt.param_len == joint_read_len) {
+				// 일반 Sync Read 응답: 모터마다 상태 패킷 1개
+				updated += joint_state_store(pkt.id, pkt.error, pkt.params, now);
+			} else if (pkt.param_len == 1) {
+				// 진단 읽기 응답: Hardware Error Status
+				DXL_Health_Reply(pkt.id, pkt.error, diag_stamp);
+				DXL_Health_Hw_Error(pkt.id, pkt.params[0]);
+				int j = joint_index_of(pkt.id);
+				if (j >= 0) {
+					joint_state[j].hw_error = pkt.params[0];
+					if (diag_pending == j + 1)
+						diag_pending = 0;
+				}
+			} else if (pkt.param_len == JOINT_CHECK_LEN || pkt.param_len == 0) {
+				// 복구 요청 응답: 확인 읽기(Torque Enable ~ Hardware Error Status) 또는 Reboot/Write 처리 결과
+				DXL_Health_Reply(pkt.id, pkt.error, diag_stamp);
+				int j = joint_index_of(pkt.id);
+				if (j >= 0) {
+					DXL_Joint_Check_t *c = &joint_check[j];
+					if (pkt.param_len) {
+						c->torque = pkt.params[0];
+						c->hw_error = pkt.params[JOINT_CHECK_LEN - 1];
+						c->fresh = 1;
+						joint_state[j].hw_error = c->hw_error;
+						DXL_Health_Hw_Error(pkt.id, c->hw_error);
+					} else if (pkt.error & 0x7F) {
+						c->write_error = 1;
+					}
+					if (diag_pending == j + 1)
+						diag_pending = 0;
+				}
+			}
+		}
+		DXL_Bus_Rx_Consume(used);
+	}
+
+	return updated;
+}
+
+// 관절 상태 조회 (joint: 다리 i의 고관절 = 2*i, 무릎 = 2*i+1)
+const DXL_Joint_State_t* DXL_Get_Joint_State(uint8_t joint) {
+	if (joint >= JOINT_COUNT)
+		return NULL;
+	return &joint_state[joint];
+}
+
+uint8_t DXL_Is_Fast_Sync_Read(void) {
+	return use_fast_read;
+}
+
+// 관절 1개씩 돌아가며 Hardware Error Status 읽기 요청 (8주기에 한 바퀴, 복구 중인 관절은 건너뜀)
+void send_diag_read_next(void) {
+	if (tpl_read_sync.len == 0 || joint_read_mask == 0)
+		return; // DXL_Init() 이전 호출 또는 모든 관절이 복구 중
+
+	while (!((joint_read_mask >> diag_next) & 1))
+		diag_next = (diag_next + 1) % JOINT_COUNT;
+	diag_begin(diag_next);
+
+	DXL_Bus_Enqueue(diag_req[diag_next], DXL_READ_LEN);
+	diag_next = (diag_next + 1) % JOINT_COUNT;
+}
+
+// ---------------------------------------------------------------------------
+// 7. 버스 스케줄러용 슬롯 비용 (상태 패킷 = 헤더 7 + INST 1 + ERR 1 + 파라미터 + CRC 2)
+// ---------------------------------------------------------------------------
+
+DXL_Frame_Cost_t DXL_Get_Joint_Write_Cost(void) {
+	// 스터핑 최악의 경우 모터마다 데이터 3바이트당 1바이트 증가
+	DXL_Frame_Cost_t c;
+	if (tpl_joint_cmd.len != 0) {
+		// Indirect 복합 명령 1개 (위치 + 프로파일 + 전류)
+		c.tx_bytes = tpl_joint_cmd.len + tpl_joint_cmd.id_count * (JOINT_CMD_LEN / 3);
+	} else {
+		// 위치 Sync Write + 프로파일이 바뀐 주기의 프로파일 Sync Write (14 + 8 * (8 + 1))
+		c.tx_bytes = tpl_joint_pos.len + tpl_joint_pos.id_count
+				+ 14 + JOINT_COUNT * (2 * MX_DATA_LEN + 1 + 2);
+	}
+	c.rx_bytes = 0;
+	c.replies = 0;
+	return c;
+}
+
+DXL_Frame_Cost_t DXL_Get_Wheel_Write_Cost(void) {
+	DXL_Frame_Cost_t c = { tpl_wheel_speed.len, 0, 0 };
+	return c;
+}
+
+DXL_Frame_Cost_t DXL_Get_Joint_Read_Cost(void) {
+	DXL_Frame_Cost_t c;
+	if (use_fast_read) {
+		// 응답 1개에 관절 8개 항목 (항목 간격 = 데이터 + 4, 마지막 항목은 CRC 공유)
+		c.tx_bytes = tpl_read_fast.len;
+		c.rx_bytes = 11 + JOINT_COUNT * (joint_read_len + 4) - 3;
+		c.replies = 1;
+	} else {
+		c.tx_bytes = tpl_read_sync.len;
+		c.rx_bytes = JOINT_COUNT * (11 + joint_read_len);
+		c.replies = JOINT_COUNT;
+	}
+	return c;
+}
+
+// 진단 슬롯 = 진단 읽기 또는 복구 요청 1개 (최악: Indirect Address 14개 Write 요청, 확인 읽기 응답)
+DXL_Frame_Cost_t DXL_Get_Diag_Cost(void) {
+	DXL_Frame_Cost_t c = { 10 + 2 + 2 * JOINT_BLOCK_LEN, 11 + JOINT_CHECK_LEN, 1 };
+	return c;
+}
+
+// ---------------------------------------------------------------------------
+// 8. 단일 모터 요청/응답 (부팅 설정용 - 버스 스케줄러 실행 전, 메인 루프에서만 호출)
+// ---------------------------------------------------------------------------
+
+#define DXL_REPLY_TIMEOUT_MS 3  // 응답 대기 시간 (Return Delay Time 최대 508us + 패킷 송수신)
+#define DXL_BROADCAST_PING_SLOT_MS 3 // 브로드캐스트 Ping 응답 간격 (ID 1당, 공식 SDK 대기 시간 기준)
+
+// 프로토콜 2.0 패킷 생성 (파라미터 바이트 스터핑 포함, 패킷 길이 반환)
+static uint16_t build_packet_2_0(uint8_t *packet, uint8_t id, uint8_t inst,
+		const uint8_t *params, uint16_t n) {
+	packet[0] = 0xFF;
+	packet[1] = 0xFF;
+	packet[2] = 0xFD; // Header
+	packet[3] = 0x00; // Reserved
+	packet[4] = id;
+	packet[7] = inst;
+	uint16_t idx = 8 + dxl_stuff_copy(&packet[8], params, n);
+
+	uint16_t length = idx - 7 + 2; // Inst + Params + CRC
+	packet[5] = length & 0xFF;
+	packet[6] = (length >> 8) & 0xFF;
+
+	uint16_t crc = update_crc(0, packet, idx);
+	packet[idx++] = crc & 0xFF;
+	packet[idx++] = (crc >> 8) & 0xFF;
+	return idx;
+}
+
+// 프로토콜 1.0 패킷 생성 (패킷 길이 반환)
+static uint16_t build_packet_1_0(uint8_t *packet, uint8_t id, uint8_t inst,
+		const uint8_t *params, uint8_t n) {
+	uint16_t idx = 0;
+
+	packet[idx++] = 0xFF;
+	packet[idx++] = 0xFF; // Header
+	packet[idx++] = id;
+	packet[idx++] = n + 2; // Length: Inst + Params + Checksum
+	packet[idx++] = inst;
+	for (uint8_t i = 0; i < n; i++)
+		packet[idx++] = params[i];
+
+	packet[idx] = calculate_checksum_1_0(packet, idx);
+	return idx + 1;
+}
+
+// 2.0 요청 송신 후 지정 ID의 상태 패킷 대기 (다른 패킷은 버림), 파라미터 앞 data_len 바이트 복사
+static HAL_StatusTypeDef txn_2_0(const uint8_t *req, uint16_t len, uint8_t id,
+		uint8_t *data, uint16_t data_len) {
+	status_parser_prepare();
+	DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+	DXL_Bus_Rx_Discard();
+	DXL_Status_Reset(&status_parser);
+
+	uint32_t stamp = DXL_Health_Now();
+	if (DXL_Bus_Transmit(req, len) != HAL_OK)
+		return HAL_ERROR;
+	if (id == 0xFE)
+		return DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS); // 브로드캐스트는 응답 없음
+	DXL_Health_Sent(id);
+
+	uint32_t start = HAL_GetTick();
+	do {
+		const uint8_t *chunk;
+		uint16_t n;
+		while ((n = DXL_Bus_Rx_Peek(&chunk)) > 0) {
+			DXL_Status_Packet_t pkt;
+			uint16_t used;
+			uint32_t crc_errors = status_parser.crc_errors;
+			uint8_t got = DXL_Status_Parse(&status_parser, chunk, n, &used, &pkt);
+
+			if (status_parser.crc_errors != crc_errors)
+				DXL_Health_Crc_Error(status_parser.crc_error_id);
+			if (got && pkt.id == id) {
+				DXL_Health_Reply(id, pkt.error, stamp);
+				// Error 최상위 비트(Alert)는 하드웨어 오류 알림일 뿐 명령은 처리됨
+				HAL_StatusTypeDef st = (pkt.error & 0x7F) ? HAL_ERROR : HAL_OK;
+				if (st == HAL_OK && data_len) {
+					if (pkt.param_len < data_len)
+						st = HAL_ERROR;
+					else
+						memcpy(data, pkt.params, data_len);
+				}
+				DXL_Bus_Rx_Consume(used);
+				return st;
+			}
+			DXL_Bus_Rx_Consume(used);
+		}
+	} while ((HAL_GetTick() - start) <= DXL_REPLY_TIMEOUT_MS);
+
+	DXL_Health_Timeout(id);
+	return HAL_TIMEOUT;
+}
+
+// 1.0 요청 송신 후 지정 ID의 상태 패킷 대기, 파라미터 앞 data_len 바이트 복사
+static HAL_StatusTypeDef txn_1_0(const uint8_t *req, uint16_t len, uint8_t id,
+		uint8_t *data, uint8_t data_len) {
+	DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+	DXL_Bus_Rx_Discard();
+
+	uint32_t stamp = DXL_Health_Now();
+	if (DXL_Bus_Transmit(req, len) != HAL_OK)
+		return HAL_ERROR;
+	if (id == 0xFE)
+		return DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS); // 브로드캐스트는 응답 없음
+	DXL_Health_Sent(id);
+
+	DXL_Frame_1_0_t rx = { .idx = 0 };
+	uint8_t *frame = rx.frame;
+	uint32_t start = HAL_GetTick();
+	do {
+		const uint8_t *chunk;
+		uint16_t n;
+		while ((n = DXL_Bus_Rx_Peek(&chunk)) > 0) {
+			for (uint16_t i = 0; i < n; i++) {
+				uint16_t flen = frame_1_0_push(&rx, chunk[i]);
+				if (flen == 0)
+					continue;
+
+				// 패킷 완성
+				if (flen == len && memcmp(frame, req, len) == 0)
+					continue; // 반이중 선로에서 되돌아온 송신 패킷
+				if (frame[flen - 1] != calculate_checksum_1_0(frame, flen - 1)) {
+					DXL_Health_Crc_Error(frame[2]);
+					continue;
+				}
+				if (frame[2] != id)
+					continue;
+
+				// 1.0 Error: 명령 실패 비트 외(전압, 각도 제한, 과열, 과부하)는 하드웨어 오류
+				DXL_Health_Reply(id, frame[4] & DXL_1_0_FAIL_MASK, stamp);
+				DXL_Health_Hw_Error(id, frame[4] & (uint8_t) ~DXL_1_0_FAIL_MASK);
+				HAL_StatusTypeDef st = (frame[4] & DXL_1_0_FAIL_MASK) ? HAL_ERROR : HAL_OK;
+				if (st == HAL_OK && data_len) {
+					if (frame[3] - 2 < data_len)
+						st = HAL_ERROR;
+					else
+						memcpy(data, &frame[5], data_len);
+				}
+				DXL_Bus_Rx_Consume(i + 1);
+				return st;
+			}
+			DXL_Bus_Rx_Consume(n);
+		}
+	} while ((HAL_GetTick() - start) <= DXL_REPLY_TIMEOUT_MS);
+
+	DXL_Health_Timeout(id);
+	return HAL_TIMEOUT;
+}
+
+// [2.0] Ping: 응답하면 모델 번호 반환
+HAL_StatusTypeDef dxl_ping_2_0(uint8_t id, uint16_t *model) {
+	uint8_t packet[DXL_PACKET_MAX];
+	uint8_t data[3]; // Model Number(2) + Firmware Version(1)
+
+	uint16_t len = build_packet_2_0(packet, id, 0x01, NULL, 0);
+	HAL_StatusTypeDef st = txn_2_0(packet, len, id, data, 3);
+	if (st == HAL_OK && model != NULL)
+		*model = data[0] | (data[1] << 8);
+	return st;
+}
+
+// [2.0] 브로드캐스트 Ping: 버스의 모든 2.0 모터가 ID 순서대로 응답 (모델 번호 포함)
+// wait_ids가 모두 응답하면 바로 반환, 아니면 가장 큰 wait_id의 응답 순서까지 기다림
+// (그보다 큰 ID의 예상 밖 모터는 놓칠 수 있음). 받은 응답 수 반환 (최대 max개 기록)
+uint8_t dxl_broadcast_ping_2_0(const uint8_t *wait_ids, uint8_t wait_count, uint8_t *ids,
+		uint16_t *models, uint8_t max) {
+	uint8_t packet[DXL_PACKET_MAX];
+	uint8_t got = 0;
+	uint8_t waiting = 0;
+	uint8_t max_id = 0;
+
+	for (uint8_t i = 0; i < wait_count; i++) {
+		if (wait_ids[i] > max_id)
+			max_id = wait_ids[i];
+	}
+
+	uint16_t len = build_packet_2_0(packet, 0xFE, 0x01, NULL, 0);
+	status_parser_prepare();
+	DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+	DXL_Bus_Rx_Discard();
+	DXL_Status_Reset(&status_parser);
+	if (DXL_Bus_Transmit(packet, len) != HAL_OK)
+		return 0;
+
+	uint32_t window = DXL_REPLY_TIMEOUT_MS + DXL_BROADCAST_PING_SLOT_MS * ((uint32_t) max_id + 1);
+	uint32_t start = HAL_GetTick();
+	do {
+		const uint8_t *chunk;
+		uint16_t n;
+		while ((n = DXL_Bus_Rx_Peek(&chunk)) > 0) {
+			DXL_Status_Packet_t pkt;
+			uint16_t used;
+			if (DXL_Status_Parse(&status_parser, chunk, n, &used, &pkt) && pkt.param_len >= 3) {
+				uint8_t dup = 0;
+				for (uint8_t i = 0; i < got && i < max; i++)
+					dup |= (ids[i] == pkt.id);
+				if (!dup) {
+					if (got < max) {
+						ids[got] = pkt.id;
+						models[got] = pkt.params[0] | (pkt.params[1] << 8);
+					}
+					got++;
+					for (uint8_t i = 0; i < wait_count; i++)
+						waiting += (wait_ids[i] == pkt.id);
+				}
+			}
+			DXL_Bus_Rx_Consume(used);
+		}
+	} while (waiting < wait_count && (HAL_GetTick() - start) <= window);
+
+	return got;
+}
+
+// [2.0] Read: addr부터 len바이트 읽기
+HAL_StatusTypeDef dxl_read_2_0(uint8_t id, uint16_t addr, uint8_t *data, uint16_t len) {
+	uint8_t packet[DXL_PACKET_MAX];
+	uint8_t params[4] = { addr & 0xFF, (addr >> 8) & 0xFF, len & 0xFF, (len >> 8) & 0xFF };
+
+	if (len > DXL_PACKET_MAX - 11)
+		return HAL_ERROR;
+	uint16_t plen = build_packet_2_0(packet, id, 0x02, params, 4);
+	return txn_2_0(packet, plen, id, data, len);
+}
+
+// [2.0] Write: addr부터 len바이트 쓰기 (응답으로 처리 여부 확인, 브로드캐스트는 확인 없음)
+HAL_StatusTypeDef dxl_write_2_0(uint8_t id, uint16_t addr, const uint8_t *data, uint16_t len) {
+	uint8_t packet[DXL_PACKET_MAX];
+	uint8_t params[2 + 32];
+
+	if (len > 32)
+		return HAL_ERROR;
+	params[0] = addr & 0xFF;
+	params[1] = (addr >> 8) & 0xFF;
+	memcpy(&params[2], data, len);
+
+	uint16_t plen = build_packet_2_0(packet, id, 0x03, params, 2 + len);
+	return txn_2_0(packet, plen, id, NULL, 0);
+}
+
+// [1.0] Ping
+HAL_StatusTypeDef dxl_ping_1_0(uint8_t id) {
+	uint8_t packet[DXL_PACKET_MAX];
+	uint16_t len = build_packet_1_0(packet, id, 0x01, NULL, 0);
+	return txn_1_0(packet, len, id, NULL, 0);
+}
+
+// [1.0] Read: addr부터 len바이트 읽기
+HAL_StatusTypeDef dxl_read_1_0(uint8_t id, uint8_t addr, uint8_t *data, uint8_t len) {
+	uint8_t packet[DXL_PACKET_MAX];
+	uint8_t params[2] = { addr, len };
+
+	if (len > DXL_PACKET_MAX - 6)
+		return HAL_ERROR;
+	uint16_t plen = build_packet_1_0(packet, id, 0x02, params, 2);
+	return txn_1_0(packet, plen, id, data, len);
+}
+
+// [1.0] Write: 1 또는 2바이트 값 쓰기 (개별 AX-12 제어)
+HAL_StatusTypeDef dxl_write_1_0(uint8_t id, uint8_t addr, uint8_t data_len, uint16_t data) {
+	uint8_t packet[DXL_PACKET_MAX];
+	uint8_t params[3] = { addr, data & 0xFF, (data >> 8) & 0xFF };
+
+	if (data_len != 1 && data_len != 2)
+		return HAL_ERROR;
+	uint16_t plen = build_packet_1_0(packet, id, 0x03, params, 1 + data_len);
+	return txn_1_0(packet, plen, id, NULL, 0);
+}
+
+// ---------------------------------------------------------------------------
+// 9. Indirect Address 매핑 (명령/상태 항목을 연속 블록으로 묶음)
+// ---------------------------------------------------------------------------
+// 목표 위치, 프로파일, 목표 전류와 상태/진단 항목은 컨트롤 테이블에서 서로 떨어져 있어
+// 한 번에 쓰거나 읽으려면 패킷이 여러 개 필요함. Indirect Address n에 원래 주소를 바이트 단위로
+// 적어두면 Indirect Data n이 그 바이트와 연결되므로, 명령은 Indirect Data 1~14, 상태는 15~28에
+// 모아 Sync Write 1개 / Sync Read 1개로 처리함.
+// Indirect Address는 RAM 영역이라 모터 재부팅 후에는 다시 설정해야 함 (토크 OFF 상태에서만 쓰기 가능).
+
+// 명령 블록 (Indirect Data 1~14) - DXL_Joint_Command_t 순서
+static const DXL_Field_t indirect_cmd_map[] = {
+	DXL_FIELD_GOAL_POSITION,
+	DXL_FIELD_PROFILE_VELOCITY,
+	DXL_FIELD_PROFILE_ACCELERATION,
+	DXL_FIELD_GOAL_CURRENT,
+};
+
+// 상태 블록 (Indirect Data 15~28) - joint_state_store() 해석 순서
+static const DXL_Field_t indirect_state_map[] = {
+	DXL_FIELD_PRESENT_CURRENT,
+	DXL_FIELD_PRESENT_VELOCITY,
+	DXL_FIELD_PRESENT_POSITION,
+	DXL_FIELD_HARDWARE_ERROR_STATUS,
+	DXL_FIELD_PRESENT_INPUT_VOLTAGE,
+	DXL_FIELD_PRESENT_TEMPERATURE,
+};
+
+#define INDIRECT_CMD_ITEMS   (sizeof(indirect_cmd_map) / sizeof(indirect_cmd_map[0]))
+#define INDIRECT_STATE_ITEMS (sizeof(indirect_state_map) / sizeof(indirect_state_map[0]))
+#define INDIRECT_CMD_DATA    (DXL_JOINT_ADDR(INDIRECT_DATA_1))                 // 명령 블록 Indirect Data 주소
+#define INDIRECT_STATE_DATA  (DXL_JOINT_ADDR(INDIRECT_DATA_1) + JOINT_CMD_LEN) // 상태 블록 Indirect Data 주소
+
+static uint8_t indirect_ready = 0;
+
+// 매핑 표를 Indirect Address 값(바이트마다 2바이트 주소)으로 펼침 (data: 2 * JOINT_BLOCK_LEN 바이트)
+// 펼친 길이 반환 (표와 블록 길이가 맞지 않으면 0)
+static uint16_t indirect_map_data(uint8_t *data, const DXL_Field_t *map, uint8_t items, uint8_t block_len) {
+	uint16_t n = 0;
+
+	for (uint8_t i = 0; i < items; i++) {
+		const DXL_Field_Info_t *f = DXL_Model_Field(DXL_JOINT_MODEL, map[i]);
+		if (f == NULL || n + 2u * f->size > 2 * JOINT_BLOCK_LEN)
+			return 0;
+		for (uint8_t b = 0; b < f->size; b++) {
+			put_le(&data[n], f->addr + b, 2);
+			n += 2;
+		}
+	}
+	return (n == 2 * block_len) ? n : 0;
+}
+
+// 매핑 표를 first번째 Indirect Address부터 기록
+static HAL_StatusTypeDef indirect_write_map(uint8_t id, uint8_t first,
+		const DXL_Field_t *map, uint8_t items, uint8_t block_len) {
+	uint8_t data[2 * JOINT_BLOCK_LEN];
+	uint16_t n = indirect_map_data(data, map, items, block_len);
+	if (n == 0)
+		return HAL_ERROR;
+
+	// 28바이트 = dxl_write_2_0 한 번 (최대 32바이트)
+	return dxl_write_2_0(id, DXL_JOINT_ADDR(INDIRECT_ADDRESS_1) + 2 * first, data, n);
+}
+
+// 상태 읽기 요청 템플릿 생성 (joint_read_mask의 관절만, Indirect 매핑 여부에 따라 주소/길이 결정)
+static void read_tpl_build(void) {
+	uint8_t ids[JOINT_COUNT];
+	uint8_t n = 0;
+
+	for (int j = 0; j < JOINT_COUNT; j++) {
+		if ((joint_read_mask >> j) & 1)
+			ids[n++] = robot_joint_ids[j];
+	}
+	uint16_t addr = indirect_ready ? INDIRECT_STATE_DATA : DXL_JOINT_ADDR(PRESENT_CURRENT);
+	joint_read_len = indirect_ready ? JOINT_BLOCK_LEN : JOINT_STATE_LEN;
+	tpl_build_read(&tpl_read_sync, 0x82, addr, joint_read_len, ids, n);
+	tpl_build_read(&tpl_read_fast, 0x8A, addr, joint_read_len, ids, n);
+}
+
+// 부팅 시 모터에 설정되어 있던 명령 블록 값 (Goal Current ~ Goal Position, DXL_Indirect_Setup에서 읽음)
+static DXL_Joint_Command_t joint_cmd_boot[JOINT_COUNT];
+
+// 명령 블록 항목을 원래 주소에서 읽어 초기 명령값으로 저장 (Goal Current 102 ~ Goal Position 119를 한 번에 읽음)
+static HAL_StatusTypeDef indirect_read_boot_cmd(uint8_t j) {
+	const uint16_t first = DXL_JOINT_ADDR(GOAL_CURRENT);
+	const uint16_t last = DXL_JOINT_ADDR(GOAL_POSITION) + DXL_Model_Size(DXL_JOINT_MODEL, DXL_FIELD_GOAL_POSITION);
+	uint8_t d[32];
+	int32_t v[INDIRECT_CMD_ITEMS];
+
+	if ((uint16_t) (last - first) > sizeof(d))
+		return HAL_ERROR;
+	HAL_StatusTypeDef st = dxl_read_2_0(robot_joint_ids[j], first, d, last - first);
+	if (st != HAL_OK)
+		return st;
+
+	for (uint8_t k = 0; k < INDIRECT_CMD_ITEMS; k++) {
+		const DXL_Field_Info_t *f = DXL_Model_Field(DXL_JOINT_MODEL, indirect_cmd_map[k]);
+		v[k] = DXL_Model_Decode(f, &d[f->addr - first]);
+	}
+	DXL_Joint_Command_t *c = &joint_cmd_boot[j];
+	c->position = (uint32_t) v[0];
+	c->profile_velocity = (uint32_t) v[1];
+	c->profile_acceleration = (uint32_t) v[2];
+	c->goal_current = (int16_t) v[3];
+	return HAL_OK;
+}
+
+// 부팅 시 모터의 명령값 조회 (캐시가 프로파일/전류 초기값으로 사용, 매핑 실패 시 0)
+const DXL_Joint_Command_t* DXL_Get_Joint_Boot_Command(uint8_t joint) {
+	if (joint >= JOINT_COUNT)
+		return NULL;
+	return &joint_cmd_boot[joint];
+}
+
+// 관절 8개에 명령/상태 블록 매핑 기록 (부팅 설정용, 토크 OFF 상태에서 호출)
+// 모두 성공하면 복합 명령 템플릿을 만들고 상태 읽기를 상태 블록으로 전환, 하나라도 실패하면 기존 방식 유지
+HAL_StatusTypeDef DXL_Indirect_Setup(void) {
+	if (tpl_read_sync.len == 0)
+		return HAL_ERROR; // DXL_Init() 이전 호출
+
+	indirect_ready = 0;
+	for (int i = 0; i < JOINT_COUNT; i++) {
+		if (indirect_read_boot_cmd(i) != HAL_OK)
+			return HAL_ERROR;
+		if (indirect_write_map(robot_joint_ids[i], 0, indirect_cmd_map, INDIRECT_CMD_ITEMS,
+				JOINT_CMD_LEN) != HAL_OK)
+			return HAL_ERROR;
+		if (indirect_write_map(robot_joint_ids[i], JOINT_CMD_LEN, indirect_state_map, INDIRECT_STATE_ITEMS,
+				JOINT_BLOCK_LEN) != HAL_OK)
+			return HAL_ERROR;
+	}
+
+	tpl_build_2_0(&tpl_joint_cmd, INDIRECT_CMD_DATA, JOINT_CMD_LEN, robot_joint_ids, JOINT_COUNT);
+	indirect_ready = 1;
+	read_tpl_build();
+	return HAL_OK;
+}
+
+uint8_t DXL_Indirect_Is_Ready(void) {
+	return indirect_ready;
+}
+
+// [복합 명령] 일부 관절의 위치 + 프로파일 속도/가속도 + 목표 전류를 Sync Write 1개로 송신
+// joints: 오름차순 관절 인덱스, cmd[]: 관절 인덱스 순서 (다리 i의 고관절 = 2*i, 무릎 = 2*i+1)
+void send_sync_write_joint_commands_subset(const uint8_t *joints, const DXL_Joint_Command_t *cmd, uint8_t count) {
+	if (!indirect_ready)
+		return; // 매핑 전에는 Indirect Data가 아무 항목과도 연결되어 있지 않음
+	if (count == 0 || count > JOINT_COUNT)
+		return;
+
+	DXL_Frame_Template_t subset;
+	DXL_Frame_Template_t *tpl = &tpl_joint_cmd;
+	if (count < JOINT_COUNT) {
+		uint8_t ids[JOINT_COUNT];
+		for (uint8_t i = 0; i < count; i++)
+			ids[i] = robot_joint_ids[joints[i]];
+		tpl_build_2_0(&subset, INDIRECT_CMD_DATA, JOINT_CMD_LEN, ids, count);
+		tpl = &subset;
+	}
+
+	for (uint8_t i = 0; i < count; i++) {
+		const DXL_Joint_Command_t *c = &cmd[joints[i]];
+		const uint32_t v[INDIRECT_CMD_ITEMS] = { c->position, c->profile_velocity,
+				c->profile_acceleration, (uint16_t) c->goal_current };
+		uint8_t *d = tpl_data(tpl, i);
+		for (uint8_t k = 0; k < INDIRECT_CMD_ITEMS; k++) {
+			uint8_t size = DXL_Model_Size(DXL_JOINT_MODEL, indirect_cmd_map[k]);
+			put_le(d, v[k], size);
+			d += size;
+		}
+	}
+	// 음수 전류(0xFFxx)와 이어지는 바이트로 FF FF FD가 생길 수 있으므로 항상 스터핑 검사
+	tpl_finish_and_queue(tpl, 1);
+}
+
+// [복합 명령] 관절 전체
+void send_sync_write_joint_commands(const DXL_Joint_Command_t *cmd) {
+	send_sync_write_joint_commands_subset(joint_all, cmd, JOINT_COUNT);
+}
+
+// [프로파일] 일부 관절의 Profile Acceleration + Profile Velocity (108~115 연속 8바이트) Sync Write
+// Indirect 매핑이 없을 때 프로파일이 바뀐 경우에만 사용 (위치는 send_sync_write_joints_subset으로 따로 송신)
+void send_sync_write_joint_profiles_subset(const uint8_t *joints, const DXL_Joint_Command_t *cmd, uint8_t count) {
+	if (count == 0 || count > JOINT_COUNT || tpl_joint_pos.len == 0)
+		return;
+
+	DXL_Frame_Template_t tpl;
+	uint8_t ids[JOINT_COUNT];
+	for (uint8_t i = 0; i < count; i++)
+		ids[i] = robot_joint_ids[joints[i]];
+	tpl_build_2_0(&tpl, DXL_JOINT_ADDR(PROFILE_ACCELERATION), 2 * MX_DATA_LEN, ids, count);
+
+	uint32_t any = 0;
+	for (uint8_t i = 0; i < count; i++) {
+		const DXL_Joint_Command_t *c = &cmd[joints[i]];
+		uint8_t *d = tpl_data(&tpl, i);
+		put_le(d, c->profile_acceleration, MX_DATA_LEN);
+		put_le(d + MX_DATA_LEN, c->profile_velocity, MX_DATA_LEN);
+		any |= c->profile_acceleration | c->profile_velocity;
+	}
+	// 값이 제한 이하이면 바이트마다 상위 바이트가 0 -> 필드 경계를 넘는 FF FF FD도 생기지 않음
+	tpl_finish_and_queue(&tpl, any >= DXL_STUFF_FREE_LIMIT);
+}
+
+// ---------------------------------------------------------------------------
+// 10. Drive Mode (프로파일 기준 설정)
+// ---------------------------------------------------------------------------
+// 속도 기준(기본): Profile Velocity/Acceleration이 속도/가속도 단위
+// 시간 기준(Drive Mode bit2): Profile Velocity = 이동 전체 시간(ms), Profile Acceleration = 가속 시간(ms)
+// 시간 기준이면 제어기가 드문 경유점만 보내도 모터가 정해진 시간 안에 부드럽게 보간함.
+// Drive Mode는 EEPROM이라 토크 OFF 상태에서만 쓸 수 있고, 값이 다를 때만 기록함 (쓰기 수명 보호).
+
+// 관절 8개 Drive Mode의 시간 기준 비트 설정 (다른 비트 - 회전 방향 등 - 는 유지)
+HAL_StatusTypeDef DXL_Set_Drive_Mode(uint8_t time_based) {
+	HAL_StatusTypeDef result = HAL_OK;
+
+	if (tpl_joint_pos.len == 0)
+		return HAL_ERROR; // DXL_Init() 이전 호출
+
+	for (int i = 0; i < JOINT_COUNT; i++) {
+		uint8_t mode;
+		if (dxl_read_2_0(robot_joint_ids[i], DXL_JOINT_ADDR(DRIVE_MODE), &mode, 1) != HAL_OK) {
+			result = HAL_ERROR;
+			continue;
+		}
+
+		uint8_t want = time_based ? (mode | DXL_DRIVE_MODE_TIME_BASED) : (mode & ~DXL_DRIVE_MODE_TIME_BASED);
+		if (want != mode && dxl_write_2_0(robot_joint_ids[i], DXL_JOINT_ADDR(DRIVE_MODE), &want, 1) != HAL_OK)
+			result = HAL_ERROR;
+	}
+	return result;
+}
+
+// ---------------------------------------------------------------------------
+// 11. 등록부 기반 범용 Sync Write / Sync Read
+// ---------------------------------------------------------------------------
+// 항목의 주소/크기와 프로토콜을 모델 표에서 가져와 패킷을 만들므로,
+// 새 항목이나 모델은 dxl_model.c 표에 추가하기만 하면 됨 (패킷 생성 코드를 따로 쓰지 않음).
+
+// ids[]의 모터들에 같은 항목을 각자 다른 값으로 쓰기 (송신 큐에 추가만 함)
+HAL_StatusTypeDef dxl_sync_write(DXL_Model_t model, DXL_Field_t field, const uint8_t *ids,
+		const int32_t *values, uint8_t count) {
+	DXL_Frame_Template_t tpl;
+
+	if (count == 0 || tpl_build_field(&tpl, model, field, ids, count) != HAL_OK)
+		return HAL_ERROR;
+
+	for (uint8_t i = 0; i < count; i++)
+		tpl_put(&tpl, i, (uint32_t) values[i]);
+	tpl_finish_and_queue(&tpl, 1); // 2.0이고 3바이트 이상이면 스터핑 검사
+	return HAL_OK;
+}
+
+// ids[]의 모터들에서 같은 항목 읽기 (응답까지 대기 - 부팅 설정용)
+HAL_StatusTypeDef dxl_sync_read(DXL_Model_t model, DXL_Field_t field, const uint8_t *ids,
+		uint8_t count, int32_t *values) {
+	const DXL_Model_Info_t *m = DXL_Model_Get(model);
+	const DXL_Field_Info_t *f = DXL_Model_Field(model, field);
+	uint8_t data[4];
+
+	if (m == NULL || f == NULL || !(f->access & DXL_ACCESS_R) || count == 0)
+		return HAL_ERROR;
+
+	// 프로토콜 1.0(AX-12)에는 Sync Read가 없음 -> 모터마다 Read
+	if (m->protocol == 1) {
+		for (uint8_t i = 0; i < count; i++) {
+			HAL_StatusTypeDef st = dxl_read_1_0(ids[i], (uint8_t) f->addr, data, f->size);
+			if (st != HAL_OK)
+				return st;
+			values[i] = DXL_Model_Decode(f, data);
+		}
+		return HAL_OK;
+	}
+
+	DXL_Frame_Template_t req;
+	if (count > DXL_TPL_MAX_LEN - 14)
+		return HAL_ERROR;
+	tpl_build_read(&req, 0x82, f->addr, f->size, ids, count);
+
+	status_parser_prepare();
+	DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+	DXL_Bus_Rx_Discard();
+	DXL_Status_Reset(&status_parser);
+	uint32_t stamp = DXL_Health_Now();
+	if (DXL_Bus_Transmit(req.buf, req.len) != HAL_OK)
+		return HAL_ERROR;
+	for (uint8_t i = 0; i < count; i++)
+		DXL_Health_Sent(ids[i]);
+
+	// 모터들이 ID 순서대로 하나씩 응답 -> 모두 받거나 시간 초과까지 수집
+	uint8_t got = 0;
+	uint32_t start = HAL_GetTick();
+	do {
+		const uint8_t *chunk;
+		uint16_t n;
+		while (got < count && (n = DXL_Bus_Rx_Peek(&chunk)) > 0) {
+			DXL_Status_Packet_t pkt;
+			uint16_t used;
+			if (DXL_Status_Parse(&status_parser, chunk, n, &used, &pkt) && pkt.param_len == f->size) {
+				for (uint8_t i = 0; i < count; i++) {
+					if (ids[i] == pkt.id) {
+						DXL_Health_Reply(pkt.id, pkt.error, stamp);
+						values[i] = DXL_Model_Decode(f, pkt.params);
+						got++;
+						break;
+					}
+				}
+			}
+			DXL_Bus_Rx_Consume(used);
+		}
+	} while (got < count && (HAL_GetTick() - start) <= (uint32_t) DXL_REPLY_TIMEOUT_MS + count);
+
+	return (got == count) ? HAL_OK : HAL_TIMEOUT;
+}
+
+// ---------------------------------------------------------------------------
+// 12. 하드웨어 오류 복구용 요청 (버스 스케줄러 실행 중 사용 - 진단 슬롯에서 1개씩)
+// ---------------------------------------------------------------------------
+// 응답을 기다리지 않고 송신 큐에 추가만 하며, 응답은 DXL_Poll_Joint_State()가 joint_check[]에 기록함.
+// 응답 없음은 진단 읽기와 같이 다음 진단 슬롯 요청 시점에 집계됨.
+
+// 상태 읽기/진단 대상 관절 변경 (상태 읽기 템플릿을 다시 만듦)
+void DXL_Set_Joint_Read_Mask(uint8_t mask) {
+	mask &= (uint8_t) ((1U << JOINT_COUNT) - 1);
+	if (mask == joint_read_mask)
+		return;
+	joint_read_mask = mask;
+	read_pending &= mask;
+	if (diag_pending && !((mask >> (diag_pending - 1)) & 1))
+		diag_pending = 0;
+	if (tpl_read_sync.len != 0)
+		read_tpl_build();
+}
+
+uint8_t DXL_Get_Joint_Read_Mask(void) {
+	return joint_read_mask;
+}
+
+// 관절 1개에 단일 요청 송신 큐 추가 (진단 슬롯 요청으로 등록)
+static HAL_StatusTypeDef joint_request(uint8_t joint, uint8_t inst, const uint8_t *params, uint16_t n) {
+	uint8_t packet[DXL_PACKET_MAX];
+
+	if (joint >= JOINT_COUNT || tpl_read_sync.len == 0)
+		return HAL_ERROR;
+	status_parser_prepare();
+	diag_begin(joint);
+	uint16_t len = build_packet_2_0(packet, robot_joint_ids[joint], inst, params, n);
+	return DXL_Bus_Enqueue(packet, len);
+}
+
+// [Reboot] 하드웨어 오류 해제 (RAM 영역 초기화: 토크 OFF, Indirect Address/프로파일/목표 전류 기본값)
+HAL_StatusTypeDef send_joint_reboot(uint8_t joint) {
+	if (joint < JOINT_COUNT)
+		joint_check[joint].write_error = 0;
+	return joint_request(joint, 0x08, NULL, 0);
+}
+
+// 재부팅 후 Indirect Address 다시 기록 (block 0: 명령 블록, 1: 상태 블록 - 요청 1개씩)
+HAL_StatusTypeDef send_joint_indirect_map(uint8_t joint, uint8_t block) {
+	uint8_t params[2 + 2 * JOINT_BLOCK_LEN];
+	uint8_t first = block ? JOINT_CMD_LEN : 0;
+	uint16_t n = block ? indirect_map_data(&params[2], indirect_state_map, INDIRECT_STATE_ITEMS, JOINT_BLOCK_LEN)
+			: indirect_map_data(&params[2], indirect_cmd_map, INDIRECT_CMD_ITEMS, JOINT_CMD_LEN);
+	if (n == 0)
+		return HAL_ERROR;
+
+	put_le(params, DXL_JOINT_ADDR(INDIRECT_ADDRESS_1) + 2 * first, 2);
+	return joint_request(joint, 0x03, params, 2 + n);
+}
+
+HAL_StatusTypeDef send_joint_torque(uint8_t joint, uint8_t on) {
+	uint16_t addr = DXL_JOINT_ADDR(TORQUE_ENABLE);
+	uint8_t params[3] = { addr & 0xFF, (addr >> 8) & 0xFF, on ? 1 : 0 };
+	return joint_request(joint, 0x03, params, 3);
+}
+
+// Torque Enable부터 Hardware Error Status까지 읽기 (재부팅 응답 확인, 토크 ON 확인)
+HAL_StatusTypeDef send_joint_check(uint8_t joint) {
+	uint16_t addr = DXL_JOINT_ADDR(TORQUE_ENABLE);
+	uint8_t params[4] = { addr & 0xFF, (addr >> 8) & 0xFF, JOINT_CHECK_LEN, 0 };
+	if (joint < JOINT_COUNT)
+		joint_check[joint].fresh = 0;
+	return joint_request(joint, 0x02, params, 4);
+}
+
+const DXL_Joint_Check_t* DXL_Get_Joint_Check(uint8_t joint) {
+	if (joint >= JOINT_COUNT)
+		return NULL;
+	return &joint_check[joint];
+}
+
+// ---------------------------------------------------------------------------
+// 13. 진단 스윕 요청 (버스 스케줄러 채움 슬롯 - 남는 버스 시간에 요청 1개씩)
+// ---------------------------------------------------------------------------
+// 응답은 DXL_Poll_Joint_State()가 DXL_Diag_Store()로 넘김. 응답 없음은 다음 주기 상태 읽기 요청 시점
+// (바퀴는 해석 구간이 끝나는 시점)에 집계됨.
+
+// 상태 읽기 대상 관절 전체에서 addr부터 len바이트 Sync Read
+HAL_StatusTypeDef send_sweep_read_joints(uint16_t addr, uint16_t len) {
+	uint8_t ids[JOINT_COUNT];
+	uint8_t n = 0;
+	DXL_Frame_Template_t req;
+
+	if (tpl_read_sync.len == 0 || len == 0 || len > DXL_STATUS_MAX_PARAMS)
+		return HAL_ERROR;
+	for (int j = 0; j < JOINT_COUNT; j++) {
+		if ((joint_read_mask >> j) & 1)
+			ids[n++] = robot_joint_ids[j];
+	}
+	if (n == 0)
+		return HAL_ERROR; // 모든 관절이 복구 중
+
+	status_parser_prepare();
+	sweep_expire();
+	tpl_build_read(&req, 0x82, addr, len, ids, n);
+	if (DXL_Bus_Enqueue(req.buf, req.len) != HAL_OK)
+		return HAL_ERROR;
+
+	for (uint8_t i = 0; i < n; i++)
+		DXL_Health_Sent(ids[i]);
+	sweep_pending = joint_read_mask;
+	sweep_len = len;
+	sweep_stamp = DXL_Health_Now();
+	return HAL_OK;
+}
+
+// 바퀴 1개에서 addr부터 len바이트 Read (1.0에는 Sync Read가 없음)
+// window_us: 요청 송신부터 응답 수신까지 수신 바이트를 1.0으로 해석할 시간 (채움 슬롯의 선로 시간)
+HAL_StatusTypeDef send_sweep_read_wheel(uint8_t wheel, uint8_t addr, uint8_t len, uint32_t window_us) {
+	uint8_t packet[DXL_PACKET_MAX];
+	uint8_t params[2] = { addr, len };
+
+	if (wheel >= LEG_COUNT || tpl_read_sync.len == 0 || len == 0 || len > DXL_PACKET_MAX - 6)
+		return HAL_ERROR;
+
+	status_parser_prepare();
+	sweep_expire();
+	uint16_t plen = build_packet_1_0(packet, robot_wheel_ids[wheel], 0x02, params, 2);
+	if (DXL_Bus_Enqueue(packet, plen) != HAL_OK)
+		return HAL_ERROR;
+
+	DXL_Health_Sent(robot_wheel_ids[wheel]);
+	sweep_rx.idx = 0;
+	sweep_len = len;
+	sweep_stamp = DXL_Health_Now();
+	sweep_deadline = sweep_stamp + window_us * (SystemCoreClock / 1000000U);
+	sweep_wheel = wheel + 1;
+	return HAL_OK;
+}
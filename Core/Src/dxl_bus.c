@@ -0,0 +1,496 @@
+/*
+ * dxl_bus.c
+ * Description: 다이나믹셀 RS-485 버스 비동기 송신 엔진 구현부
+ * Note: 송신 중에는 CPU가 바이트를 기다리지 않음 - DMA가 전송하고 TC 인터럽트가 방향 핀을 해제
+ * 수정사항: 2개의 버스트 뱅크를 번갈아 사용하는 송신 큐
+ *   - 호출자는 채우는 중인 뱅크의 슬롯에 패킷을 직접 인코딩
+ *   - Flush 시 뱅크 전체를 DMA 1회로 송신 -> 패킷 사이 CPU 공백 없음, 방향 핀 전환도 버스트당 1회
+ *   - 한 뱅크가 송신되는 동안 다른 뱅크에 다음 패킷을 채울 수 있음
+ * 수정사항: RX DMA 순환 수신 - 남은 전송 횟수(NDTR)로 DMA 쓰기 위치를 구하고 읽기 위치까지의 새 바이트만 처리
+ * 수정사항: 실행 중 보레이트 변경 (오버샘플링 16/8 선택 및 BRR 오차 검사)
+ * 수정사항: 비상 정지 - 송신 DMA를 레지스터로 바로 멈추고 토크 OFF 패킷을 폴링 송신, 이후 큐 잠금
+ */
+
+#include "dxl_bus.h"
+#include <string.h>
+
+// RS-485 방향 제어 (PB12: High = 송신, Low = 수신)
+#define DXL_DIR_TX() HAL_GPIO_WritePin(DXL_RS485_EN3_GPIO_Port, DXL_RS485_EN3_Pin, GPIO_PIN_SET)
+#define DXL_DIR_RX() HAL_GPIO_WritePin(DXL_RS485_EN3_GPIO_Port, DXL_RS485_EN3_Pin, GPIO_PIN_RESET)
+
+#define DXL_BUS_BANK_COUNT 2
+
+// 뱅크 상태: FREE -> FILLING(패킷 추가 중) -> READY(송신 대기) -> SENDING(DMA 송신 중) -> FREE
+typedef enum {
+	BANK_FREE = 0, BANK_FILLING, BANK_READY, BANK_SENDING
+} DXL_Bank_State_t;
+
+// 버스트 뱅크: DMA가 직접 읽어가는 연속 버퍼 + 슬롯(패킷) 수
+typedef struct {
+	uint8_t buf[DXL_BUS_BANK_SIZE];
+	uint16_t len;
+	uint8_t frames;
+	volatile DXL_Bank_State_t state;
+} DXL_Tx_Bank_t;
+
+static UART_HandleTypeDef *dxl_uart;
+
+static DXL_Tx_Bank_t dxl_banks[DXL_BUS_BANK_COUNT];
+static DXL_Tx_Bank_t *dxl_fill_bank = NULL;          // 메인 루프가 채우는 중인 뱅크
+static DXL_Tx_Bank_t *volatile dxl_send_bank = NULL; // DMA가 송신 중인 뱅크
+
+// RX DMA가 순환하며 채우는 수신 버퍼와 읽기 위치
+static uint8_t dxl_rx_ring[DXL_BUS_RX_RING_SIZE];
+static uint16_t dxl_rx_tail = 0;
+
+static volatile DXL_Bus_State_t dxl_bus_state = DXL_BUS_IDLE;
+static DXL_Bus_TxDone_Cb dxl_tx_done_cb = NULL;
+static DXL_Bus_Stats_t dxl_bus_stats = { 0, };
+static volatile uint8_t dxl_estop = 0; // 1: 비상 정지 잠금 (큐 송신 금지)
+
+// 지정한 상태의 뱅크 검색
+static DXL_Tx_Bank_t* bus_find_bank(DXL_Bank_State_t state) {
+	for (int i = 0; i < DXL_BUS_BANK_COUNT; i++) {
+		if (dxl_banks[i].state == state)
+			return &dxl_banks[i];
+	}
+	return NULL;
+}
+
+// 뱅크 송신 시작 (인터럽트 금지 구간 또는 ISR에서 호출)
+static void bus_start_bank(DXL_Tx_Bank_t *bank) {
+	// 이전 오류로 HAL 상태가 꼬여 있으면 송신 경로를 리셋
+	if (dxl_bus_state == DXL_BUS_ERROR)
+		HAL_UART_AbortTransmit(dxl_uart);
+
+	bank->state = BANK_SENDING;
+	dxl_send_bank = bank;
+	dxl_bus_state = DXL_BUS_BUSY;
+	DXL_DIR_TX(); // 송신 모드로 전환 (연속 버스트 중이면 이미 High)
+
+	if (HAL_UART_Transmit_DMA(dxl_uart, bank->buf, bank->len) != HAL_OK) {
+		DXL_DIR_RX();
+		bank->state = BANK_FREE;
+		dxl_send_bank = NULL;
+		dxl_bus_state = DXL_BUS_ERROR;
+		dxl_bus_stats.tx_errors++;
+	}
+}
+
+// RX DMA 순환 수신 시작 (오류로 중단된 경우 재시작에도 사용)
+static void bus_start_rx(void) {
+	if (dxl_uart->hdmarx == NULL)
+		return;
+	dxl_rx_tail = 0;
+	HAL_UART_Receive_DMA(dxl_uart, dxl_rx_ring, DXL_BUS_RX_RING_SIZE);
+}
+
+// DMA가 다음에 쓸 위치
+static uint16_t bus_rx_head(void) {
+	uint16_t head = DXL_BUS_RX_RING_SIZE - (uint16_t) __HAL_DMA_GET_COUNTER(dxl_uart->hdmarx);
+	return (head >= DXL_BUS_RX_RING_SIZE) ? 0 : head;
+}
+
+// 버스 초기화
+void DXL_Bus_Init(UART_HandleTypeDef *huart) {
+	dxl_uart = huart;
+	for (int i = 0; i < DXL_BUS_BANK_COUNT; i++) {
+		dxl_banks[i].len = 0;
+		dxl_banks[i].frames = 0;
+		dxl_banks[i].state = BANK_FREE;
+	}
+	dxl_fill_bank = NULL;
+	dxl_send_bank = NULL;
+	dxl_bus_state = DXL_BUS_IDLE;
+	DXL_DIR_RX();
+
+	bus_start_rx();
+}
+
+// [큐] 슬롯 확보
+uint8_t* DXL_Bus_Slot_Acquire(uint16_t max_size) {
+	if (dxl_estop) {
+		dxl_bus_stats.estop_blocked++;
+		return NULL;
+	}
+	if (max_size == 0 || max_size > DXL_BUS_BANK_SIZE) {
+		dxl_bus_stats.tx_dropped++;
+		return NULL;
+	}
+
+	// 현재 뱅크에 자리가 없으면 봉인하여 송신 대기열로 넘김
+	if (dxl_fill_bank != NULL
+			&& (dxl_fill_bank->len + max_size > DXL_BUS_BANK_SIZE
+					|| dxl_fill_bank->frames >= DXL_BUS_MAX_SLOTS)) {
+		DXL_Bus_Flush();
+	}
+
+	if (dxl_fill_bank == NULL) {
+		DXL_Tx_Bank_t *bank = bus_find_bank(BANK_FREE);
+		if (bank == NULL) {
+			// 두 뱅크 모두 송신 중/대기 중: 앞선 버스트가 끝날 때까지만 대기
+			DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+			bank = bus_find_bank(BANK_FREE);
+			if (bank == NULL) {
+				dxl_bus_stats.tx_dropped++;
+				return NULL;
+			}
+		}
+		bank->len = 0;
+		bank->frames = 0;
+		bank->state = BANK_FILLING;
+		dxl_fill_bank = bank;
+	}
+
+	return &dxl_fill_bank->buf[dxl_fill_bank->len];
+}
+
+// [큐] 슬롯 확정
+void DXL_Bus_Slot_Commit(uint16_t size) {
+	if (dxl_fill_bank == NULL || size == 0)
+		return;
+	dxl_fill_bank->len += size;
+	dxl_fill_bank->frames++;
+}
+
+// [큐] 완성된 패킷 복사 후 추가
+HAL_StatusTypeDef DXL_Bus_Enqueue(const uint8_t *data, uint16_t size) {
+	uint8_t *slot = DXL_Bus_Slot_Acquire(size);
+	if (slot == NULL)
+		return HAL_ERROR;
+	memcpy(slot, data, size);
+	DXL_Bus_Slot_Commit(size);
+	return HAL_OK;
+}
+
+// [큐] 쌓인 패킷을 버스트로 송신 시작
+HAL_StatusTypeDef DXL_Bus_Flush(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq(); // TC 인터럽트의 뱅크 전환과 충돌 방지 (수 마이크로초 이내)
+
+	if (dxl_estop) {
+		// 비상 정지 중 채워진 뱅크는 송신하지 않고 버림
+		if (dxl_fill_bank != NULL) {
+			dxl_bus_stats.estop_blocked += dxl_fill_bank->frames;
+			dxl_fill_bank->state = BANK_FREE;
+			dxl_fill_bank = NULL;
+		}
+		__set_PRIMASK(primask);
+		return HAL_ERROR;
+	}
+
+	if (dxl_fill_bank != NULL && dxl_fill_bank->frames > 0) {
+		dxl_fill_bank->state = BANK_READY;
+		dxl_fill_bank = NULL;
+	}
+
+	// 송신 중이 아니면 바로 시작, 송신 중이면 TC 인터럽트가 이어서 시작
+	if (dxl_send_bank == NULL) {
+		DXL_Tx_Bank_t *ready = bus_find_bank(BANK_READY);
+		if (ready != NULL)
+			bus_start_bank(ready);
+	}
+
+	__set_PRIMASK(primask);
+	return (dxl_bus_state == DXL_BUS_ERROR) ? HAL_ERROR : HAL_OK;
+}
+
+// 패킷 1개 즉시 송신
+HAL_StatusTypeDef DXL_Bus_Transmit(const uint8_t *data, uint16_t size) {
+	if (DXL_Bus_Enqueue(data, size) != HAL_OK)
+		return HAL_ERROR;
+	return DXL_Bus_Flush();
+}
+
+// 송신 중이거나 송신 대기 중인 뱅크가 있는지 확인
+static uint8_t bus_pending(void) {
+	return dxl_send_bank != NULL || bus_find_bank(BANK_READY) != NULL;
+}
+
+// 쌓인 패킷이 모두 송신될 때까지 대기
+HAL_StatusTypeDef DXL_Bus_Wait_Idle(uint32_t timeout_ms) {
+	if (!bus_pending())
+		return HAL_OK;
+
+	if (__get_IPSR() != 0) {
+		// ISR 안에서는 같은 우선순위의 DMA/USART 인터럽트와 SysTick이 돌지 않으므로
+		// 핸들러를 직접 펌핑하여 송신을 마무리 (HAL_GetTick도 멈춰 있어 루프 횟수로 제한)
+		uint32_t spin = timeout_ms * (SystemCoreClock / 1000U / 8U);
+		while (bus_pending() && spin-- > 0) {
+			HAL_DMA_IRQHandler(dxl_uart->hdmatx);
+			HAL_UART_IRQHandler(dxl_uart);
+		}
+	} else {
+		uint32_t start = HAL_GetTick();
+		while (bus_pending()) {
+			if ((HAL_GetTick() - start) > timeout_ms)
+				break;
+		}
+	}
+
+	if (bus_pending()) {
+		// 송신이 끝나지 않음: DMA 중단 후 대기 중인 버스트까지 모두 폐기
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		HAL_UART_AbortTransmit(dxl_uart);
+		DXL_DIR_RX();
+		for (int i = 0; i < DXL_BUS_BANK_COUNT; i++) {
+			if (dxl_banks[i].state == BANK_READY
+					|| dxl_banks[i].state == BANK_SENDING) {
+				dxl_bus_stats.tx_dropped += dxl_banks[i].frames;
+				dxl_banks[i].state = BANK_FREE;
+			}
+		}
+		dxl_send_bank = NULL;
+		dxl_bus_state = DXL_BUS_ERROR;
+		dxl_bus_stats.tx_timeouts++;
+		__set_PRIMASK(primask);
+		return HAL_TIMEOUT;
+	}
+	return HAL_OK;
+}
+
+DXL_Bus_State_t DXL_Bus_Get_State(void) {
+	return dxl_bus_state;
+}
+
+uint8_t DXL_Bus_Is_Busy(void) {
+	return dxl_bus_state == DXL_BUS_BUSY;
+}
+
+void DXL_Bus_Set_TxDone_Callback(DXL_Bus_TxDone_Cb cb) {
+	dxl_tx_done_cb = cb;
+}
+
+DXL_Bus_Stats_t DXL_Bus_Get_Stats(void) {
+	return dxl_bus_stats;
+}
+
+uint32_t DXL_Bus_Get_Baud(void) {
+	return dxl_uart ? dxl_uart->Init.BaudRate : 0;
+}
+
+// 보레이트에 맞는 오버샘플링 선택 (허용 오차 안에서 낼 수 없으면 HAL_ERROR)
+// USART3 커널 클럭(D2PCLK1)은 USART2(IMU)와 같은 선택 비트를 쓰므로 클럭원은 그대로 두고,
+// 분주비가 16보다 작아지면 8배 오버샘플링으로 전환하여 BRR만 다시 계산함
+static HAL_StatusTypeDef bus_baud_config(uint32_t baud, uint32_t *oversampling) {
+	if (baud == 0)
+		return HAL_ERROR;
+
+	uint32_t fck = HAL_RCC_GetPCLK1Freq();
+	uint32_t over = (fck / baud >= 16) ? UART_OVERSAMPLING_16 : UART_OVERSAMPLING_8;
+	uint32_t scale = (over == UART_OVERSAMPLING_8) ? 2 : 1;
+
+	// USARTDIV는 16 이상이어야 하고, 실제 보레이트 오차가 허용 범위 안이어야 함
+	uint32_t div = (scale * fck + baud / 2) / baud;
+	if (div < 16)
+		return HAL_ERROR;
+	uint32_t actual = scale * fck / div;
+	uint32_t diff = (actual > baud) ? actual - baud : baud - actual;
+	if (diff * 1000U / baud > DXL_BUS_BAUD_TOL_PERMILLE)
+		return HAL_ERROR;
+
+	*oversampling = over;
+	return HAL_OK;
+}
+
+uint8_t DXL_Bus_Baud_Supported(uint32_t baud) {
+	uint32_t over;
+	return bus_baud_config(baud, &over) == HAL_OK;
+}
+
+// 보레이트 변경
+HAL_StatusTypeDef DXL_Bus_Set_Baud(uint32_t baud) {
+	uint32_t over;
+	if (dxl_uart == NULL || bus_baud_config(baud, &over) != HAL_OK)
+		return HAL_ERROR;
+
+	DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+	HAL_UART_Abort(dxl_uart); // TX/RX DMA 정지
+
+	dxl_uart->Init.BaudRate = baud;
+	dxl_uart->Init.OverSampling = over;
+	if (HAL_UART_Init(dxl_uart) != HAL_OK) { // 상태가 READY이므로 MSP(핀/DMA) 설정은 유지됨
+		dxl_bus_state = DXL_BUS_ERROR;
+		return HAL_ERROR;
+	}
+
+	dxl_bus_state = DXL_BUS_IDLE;
+	DXL_DIR_RX();
+	bus_start_rx();
+	return HAL_OK;
+}
+
+// 뱅크 안의 패킷 길이 (2.0: 헤더 7 + LEN, 1.0: 헤더 4 + LEN)
+static uint16_t bus_frame_len(const uint8_t *p) {
+	if (p[2] == 0xFD && p[3] == 0x00)
+		return 7 + (p[5] | (p[6] << 8));
+	return 4 + p[3];
+}
+
+// CPU가 TDR에 직접 기록 (DMA/인터럽트 없이 동작, 바이트마다 대기 횟수 제한)
+static HAL_StatusTypeDef bus_push_polled(const uint8_t *data, uint16_t len, uint32_t spin_per_byte) {
+	USART_TypeDef *u = dxl_uart->Instance;
+	for (uint16_t i = 0; i < len; i++) {
+		uint32_t spin = spin_per_byte;
+		while (!(u->ISR & USART_ISR_TXE_TXFNF)) {
+			if (spin-- == 0)
+				return HAL_TIMEOUT;
+		}
+		u->TDR = data[i];
+	}
+	return HAL_OK;
+}
+
+// [비상 정지] 송신 중단 후 토크 OFF 패킷 송신
+HAL_StatusTypeDef DXL_Bus_Estop(const uint8_t *frames, uint16_t len, uint16_t *tail) {
+	if (tail)
+		*tail = 0;
+	if (dxl_uart == NULL)
+		return HAL_ERROR;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	dxl_estop = 1;
+
+	// 1. 송신 DMA 정지: 스트림 인터럽트를 먼저 꺼서 정지로 생기는 완료 플래그가 콜백을 부르지 않게 함
+	//    (HAL_UART_AbortTransmit은 HAL_GetTick 기반 대기라 ISR 안에서 상한이 없음)
+	uint16_t remaining = 0;
+	DMA_HandleTypeDef *hdma = dxl_uart->hdmatx;
+	if (hdma != NULL && dxl_send_bank != NULL) {
+		__HAL_DMA_DISABLE_IT(hdma, DMA_IT_TC | DMA_IT_HT | DMA_IT_TE | DMA_IT_DME);
+		__HAL_DMA_DISABLE_IT(hdma, DMA_IT_FE);
+		__HAL_DMA_DISABLE(hdma);
+		for (uint32_t spin = 1000; (((DMA_Stream_TypeDef*) hdma->Instance)->CR & DMA_SxCR_EN) && spin > 0; spin--)
+			;
+		remaining = (uint16_t) __HAL_DMA_GET_COUNTER(hdma);
+		hdma->State = HAL_DMA_STATE_READY;
+		__HAL_UNLOCK(hdma);
+	}
+	CLEAR_BIT(dxl_uart->Instance->CR3, USART_CR3_DMAT);
+	CLEAR_BIT(dxl_uart->Instance->CR1, USART_CR1_TCIE | USART_CR1_TXEIE_TXFNFIE);
+	dxl_uart->gState = HAL_UART_STATE_READY;
+
+	// 2. 선로에 나가던 패킷의 나머지 바이트 (중간에 끊으면 모터가 뒤 바이트를 그 패킷의 일부로 읽음)
+	const uint8_t *rest = NULL;
+	uint16_t rest_len = 0;
+	DXL_Tx_Bank_t *bank = dxl_send_bank;
+	if (bank != NULL && remaining > 0 && remaining <= bank->len) {
+		uint16_t sent = bank->len - remaining;
+		for (uint16_t pos = 0; pos < bank->len;) {
+			uint16_t flen = bus_frame_len(&bank->buf[pos]);
+			if (sent < pos + flen) {
+				if (sent > pos) { // 이미 시작된 패킷만 마무리 (경계에서 끊겼으면 0)
+					rest = &bank->buf[sent];
+					rest_len = pos + flen - sent;
+				}
+				break;
+			}
+			pos += flen;
+		}
+	}
+
+	// 3. 대기/송신 중이던 버스트 폐기
+	for (int i = 0; i < DXL_BUS_BANK_COUNT; i++) {
+		if (dxl_banks[i].state == BANK_READY || dxl_banks[i].state == BANK_SENDING) {
+			dxl_bus_stats.tx_dropped += dxl_banks[i].frames;
+			dxl_banks[i].state = BANK_FREE;
+		}
+	}
+	dxl_send_bank = NULL;
+
+	// 4. 폴링 송신: 바이트 1개 선로 시간의 4배를 넘게 TXE가 안 켜지면 중단 (상한 보장)
+	uint32_t baud = dxl_uart->Init.BaudRate ? dxl_uart->Init.BaudRate : 9600;
+	uint32_t spin_per_byte = 4 * 10 * (SystemCoreClock / baud);
+	DXL_DIR_TX();
+	HAL_StatusTypeDef st = bus_push_polled(rest, rest_len, spin_per_byte);
+	if (st == HAL_OK)
+		st = bus_push_polled(frames, len, spin_per_byte);
+	for (uint32_t spin = spin_per_byte; !(dxl_uart->Instance->ISR & USART_ISR_TC) && spin > 0; spin--)
+		;
+	__HAL_UART_CLEAR_FLAG(dxl_uart, UART_CLEAR_TCF);
+	DXL_DIR_RX();
+
+	if (tail)
+		*tail = rest_len;
+	if (st != HAL_OK)
+		dxl_bus_stats.tx_errors++;
+	dxl_bus_state = (st == HAL_OK) ? DXL_BUS_IDLE : DXL_BUS_ERROR;
+	__set_PRIMASK(primask);
+	return st;
+}
+
+uint8_t DXL_Bus_Is_Estopped(void) {
+	return dxl_estop;
+}
+
+// [수신] 아직 읽지 않은 연속 구간 반환
+uint16_t DXL_Bus_Rx_Peek(const uint8_t **data) {
+	if (dxl_uart == NULL || dxl_uart->hdmarx == NULL)
+		return 0;
+
+	uint16_t head = bus_rx_head();
+	*data = &dxl_rx_ring[dxl_rx_tail];
+	if (head >= dxl_rx_tail)
+		return head - dxl_rx_tail;
+	return DXL_BUS_RX_RING_SIZE - dxl_rx_tail; // 버퍼 끝까지만 (나머지는 다음 Peek에서)
+}
+
+// [수신] n바이트 소비
+void DXL_Bus_Rx_Consume(uint16_t n) {
+	dxl_rx_tail = (dxl_rx_tail + n) % DXL_BUS_RX_RING_SIZE;
+	dxl_bus_stats.rx_bytes += n;
+}
+
+// [수신] 들어온 바이트 모두 버림
+void DXL_Bus_Rx_Discard(void) {
+	if (dxl_uart == NULL || dxl_uart->hdmarx == NULL)
+		return;
+	dxl_rx_tail = bus_rx_head();
+}
+
+// [인터럽트] 뱅크의 마지막 비트까지 전송 완료(TC) 시 호출됨
+void DXL_Bus_TxCplt_Callback(void) {
+	DXL_Tx_Bank_t *done = dxl_send_bank;
+	if (done != NULL) {
+		dxl_bus_stats.tx_frames += done->frames;
+		dxl_bus_stats.tx_bytes += done->len;
+		done->state = BANK_FREE;
+	}
+	dxl_send_bank = NULL;
+
+	// 대기 중인 뱅크가 있으면 방향 핀을 내리지 않고 바로 이어서 송신
+	DXL_Tx_Bank_t *next = bus_find_bank(BANK_READY);
+	if (next != NULL) {
+		bus_start_bank(next);
+		return;
+	}
+
+	DXL_DIR_RX(); // 버스트 종료 -> 즉시 수신 모드로 복귀
+	dxl_bus_stats.tx_bursts++;
+	dxl_bus_state = DXL_BUS_IDLE;
+
+	if (dxl_tx_done_cb != NULL)
+		dxl_tx_done_cb();
+}
+
+// [인터럽트] UART/DMA 오류 발생 시 호출됨
+void DXL_Bus_Error_Callback(void) {
+	// 수신 오류: 노이즈/프레이밍 오류는 수신이 계속되고, 오버런 등으로 수신이 중단되었으면 재시작
+	if (dxl_uart->ErrorCode & (HAL_UART_ERROR_NE | HAL_UART_ERROR_FE
+					| HAL_UART_ERROR_PE | HAL_UART_ERROR_ORE | HAL_UART_ERROR_RTO)) {
+		dxl_bus_stats.rx_errors++;
+		if (dxl_uart->RxState == HAL_UART_STATE_READY)
+			bus_start_rx();
+	}
+
+	// 송신 오류: 송신 중이던 뱅크가 HAL에 의해 중단된 경우에만 처리
+	if (dxl_send_bank != NULL && dxl_uart->gState == HAL_UART_STATE_READY) {
+		DXL_DIR_RX();
+		dxl_bus_stats.tx_dropped += dxl_send_bank->frames;
+		dxl_send_bank->state = BANK_FREE;
+		dxl_send_bank = NULL;
+		dxl_bus_stats.tx_errors++;
+		dxl_bus_state = DXL_BUS_ERROR;
+	}
+}
@@ -0,0 +1,212 @@
+/*
+ * dxl_cache.c
+ * Description: 모터 명령 캐시 구현부
+ * Note: Sync Write는 브로드캐스트라 모터의 응답(ACK)이 없으므로, 버스에서 송신 완료된 값을
+ *       '전달된 값'으로 간주함. 송신 오류/시간 초과/폐기가 발생하면 어느 값이 빠졌는지 알 수 없으므로
+ *       캐시 전체를 비워 다음 주기에 모두 다시 보냄
+ * 수정사항: 프로파일 속도/가속도 캐시 (Indirect 매핑 시 위치+프로파일+전류 복합 명령, 아니면 프로파일만 따로 송신)
+ * 수정사항: 관절 목표를 hip/knee 배열 2개 대신 관절 인덱스 순 배열 1개로 받음
+ * 수정사항: 제외된 관절(하드웨어 오류 복구 중)은 Sync Write에 넣지 않음
+ */
+
+#include "dxl_cache.h"
+#include "dxl_2_0.h"
+#include "dxl_bus.h"
+
+// 패킷 길이 (스터핑 제외): 2.0 = 헤더 7 + INST 1 + 주소 2 + 길이 2 + CRC 2, 1.0 = 헤더 4 + INST 1 + 주소 1 + 길이 1 + 체크섬 1
+#define SYNC_WRITE_LEN_2_0(n, len) (14 + (n) * ((len) + 1))
+#define SYNC_WRITE_LEN_1_0(n, len) (8 + (n) * ((len) + 1))
+
+static uint32_t cache_joint_pos[JOINT_COUNT];
+static uint32_t cache_joint_stamp[JOINT_COUNT];
+static int16_t cache_wheel_speed[LEG_COUNT];
+static uint32_t cache_wheel_stamp[LEG_COUNT];
+static uint8_t cache_joint_valid = 0; // 비트 i: 관절 i 값이 유효
+static uint8_t cache_wheel_valid = 0; // 비트 i: 바퀴 i 값이 유효
+static uint8_t cache_joint_active = (uint8_t) ((1U << JOINT_COUNT) - 1); // 비트 i: 관절 i를 Sync Write에 포함
+
+static DXL_Joint_Command_t cache_joint_cmd[JOINT_COUNT]; // 관절별 프로파일/전류 목표 (위치는 송신 시 채움)
+static uint8_t cache_cmd_seeded = 0;    // 1: 모터의 부팅 시 프로파일/전류 값으로 초기화됨
+static uint8_t cache_profile_dirty = 0; // 비트 i: 관절 i 프로파일이 아직 송신되지 않음
+static uint8_t cache_profile_owned = 0; // 비트 i: 관절 i 프로파일을 제어기가 설정함 (무효화 시 재송신 대상)
+
+static uint32_t cache_bus_faults = 0; // 마지막으로 확인한 버스 송신 오류 합계
+static DXL_Cache_Stats_t cache_stats = { 0, };
+
+void DXL_Cache_Invalidate(void) {
+	cache_joint_valid = 0;
+	cache_wheel_valid = 0;
+	cache_profile_dirty = cache_profile_owned;
+}
+
+// 프로파일/전류 목표를 모터에 설정되어 있던 값으로 초기화 (복합 명령이 기존 설정을 덮어쓰지 않도록)
+static void cache_seed_cmd(void) {
+	if (cache_cmd_seeded)
+		return;
+	for (uint8_t j = 0; j < JOINT_COUNT; j++)
+		cache_joint_cmd[j] = *DXL_Get_Joint_Boot_Command(j);
+	cache_cmd_seeded = 1;
+}
+
+void DXL_Cache_Set_Joint_Profile(uint8_t joint, uint32_t velocity, uint32_t acceleration) {
+	cache_seed_cmd();
+	for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+		if (joint < JOINT_COUNT && j != joint)
+			continue;
+		DXL_Joint_Command_t *c = &cache_joint_cmd[j];
+		cache_profile_owned |= (uint8_t) (1U << j);
+		if (c->profile_velocity != velocity || c->profile_acceleration != acceleration) {
+			c->profile_velocity = velocity;
+			c->profile_acceleration = acceleration;
+			cache_profile_dirty |= (uint8_t) (1U << j);
+		}
+	}
+}
+
+void DXL_Cache_Set_Joint_Active(uint8_t joint, uint8_t active) {
+	if (joint >= JOINT_COUNT)
+		return;
+	uint8_t bit = (uint8_t) (1U << joint);
+	if (!active) {
+		cache_joint_active &= (uint8_t) ~bit;
+		return;
+	}
+	if (!(cache_joint_active & bit)) {
+		// 제외된 동안 모터가 재부팅되었을 수 있으므로 마지막 송신 값을 믿지 않음
+		cache_joint_valid &= (uint8_t) ~bit;
+		cache_profile_dirty |= cache_profile_owned & bit;
+		cache_joint_active |= bit;
+	}
+}
+
+// 지난 주기 이후 버스 송신 오류가 있었으면 캐시를 비움
+static void cache_check_bus(void) {
+	DXL_Bus_Stats_t bus = DXL_Bus_Get_Stats();
+	uint32_t faults = bus.tx_errors + bus.tx_timeouts + bus.tx_dropped;
+	if (faults != cache_bus_faults) {
+		cache_bus_faults = faults;
+		if (cache_joint_valid || cache_wheel_valid)
+			cache_stats.invalidations++;
+		DXL_Cache_Invalidate();
+	}
+}
+
+// 캐시 항목을 보내야 하는지 판단 (값 변화가 불감대 밖이거나 갱신 주기 경과)
+static uint8_t cache_need_send(uint8_t valid, int32_t diff, uint32_t deadband, uint32_t stamp, uint32_t now) {
+	if (!valid)
+		return 1;
+	if ((uint32_t) (diff < 0 ? -diff : diff) > deadband)
+		return 1;
+	if (now - stamp >= DXL_CACHE_REFRESH_MS) {
+		cache_stats.refreshes++;
+		return 1;
+	}
+	return 0;
+}
+
+void DXL_Cache_Write_Joints(const uint32_t *goals) {
+	uint8_t changed[JOINT_COUNT];
+	uint8_t count = 0;
+	uint8_t profiles[JOINT_COUNT];
+	uint8_t profile_count = 0;
+	uint32_t now = HAL_GetTick();
+	uint8_t combined = DXL_Indirect_Is_Ready();
+	uint8_t data_len = combined ? JOINT_CMD_LEN : MX_DATA_LEN;
+
+	cache_check_bus();
+	cache_seed_cmd();
+
+	// 복합 명령이면 프로파일이 바뀐 관절도 같은 Sync Write에 포함, 아니면 프로파일 Sync Write를 따로 만듦
+	for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+		cache_joint_cmd[j].position = goals[j];
+		if (!((cache_joint_active >> j) & 1))
+			continue;
+		uint8_t valid = (cache_joint_valid >> j) & 1;
+		uint8_t dirty = (cache_profile_dirty >> j) & 1;
+		int32_t diff = (int32_t) (goals[j] - cache_joint_pos[j]);
+		uint8_t need = cache_need_send(valid, diff, DXL_CACHE_POS_DEADBAND, cache_joint_stamp[j], now);
+		if (need || (combined && dirty))
+			changed[count++] = j;
+		if (!combined && dirty)
+			profiles[profile_count++] = j;
+	}
+
+	if (profile_count > 0) {
+		send_sync_write_joint_profiles_subset(profiles, cache_joint_cmd, profile_count);
+		for (uint8_t i = 0; i < profile_count; i++)
+			cache_profile_dirty &= (uint8_t) ~(1U << profiles[i]); // 제외된 관절은 복귀 때 송신
+		cache_stats.frames_sent++;
+		cache_stats.bytes_sent += SYNC_WRITE_LEN_2_0(profile_count, 2 * MX_DATA_LEN);
+	}
+
+	uint16_t full = SYNC_WRITE_LEN_2_0(JOINT_COUNT, data_len);
+	cache_stats.motors_skipped += JOINT_COUNT - count;
+	if (count == 0) {
+		cache_stats.frames_skipped++;
+		cache_stats.bytes_saved += full;
+		return;
+	}
+
+	if (combined) {
+		send_sync_write_joint_commands_subset(changed, cache_joint_cmd, count);
+		for (uint8_t i = 0; i < count; i++)
+			cache_profile_dirty &= (uint8_t) ~(1U << changed[i]);
+	} else {
+		send_sync_write_joints_subset(changed, goals, count);
+	}
+
+	for (uint8_t i = 0; i < count; i++) {
+		uint8_t j = changed[i];
+		cache_joint_pos[j] = goals[j];
+		cache_joint_stamp[j] = now;
+		cache_joint_valid |= (uint8_t) (1U << j);
+	}
+
+	uint16_t sent = SYNC_WRITE_LEN_2_0(count, data_len);
+	cache_stats.frames_sent++;
+	cache_stats.motors_sent += count;
+	cache_stats.bytes_sent += sent;
+	cache_stats.bytes_saved += full - sent;
+}
+
+void DXL_Cache_Write_Wheels(const int16_t *wheel_speeds) {
+	uint8_t changed[LEG_COUNT];
+	uint8_t count = 0;
+	uint32_t now = HAL_GetTick();
+
+	cache_check_bus();
+
+	for (uint8_t w = 0; w < LEG_COUNT; w++) {
+		uint8_t valid = (cache_wheel_valid >> w) & 1;
+		int32_t diff = (int32_t) wheel_speeds[w] - cache_wheel_speed[w];
+		if (cache_need_send(valid, diff, DXL_CACHE_SPEED_DEADBAND, cache_wheel_stamp[w], now))
+			changed[count++] = w;
+	}
+
+	uint16_t full = SYNC_WRITE_LEN_1_0(LEG_COUNT, AX_DATA_LEN);
+	cache_stats.motors_skipped += LEG_COUNT - count;
+	if (count == 0) {
+		cache_stats.frames_skipped++;
+		cache_stats.bytes_saved += full;
+		return;
+	}
+
+	send_sync_write_wheels_subset(changed, wheel_speeds, count);
+
+	for (uint8_t i = 0; i < count; i++) {
+		uint8_t w = changed[i];
+		cache_wheel_speed[w] = wheel_speeds[w];
+		cache_wheel_stamp[w] = now;
+		cache_wheel_valid |= (uint8_t) (1U << w);
+	}
+
+	uint16_t sent = SYNC_WRITE_LEN_1_0(count, AX_DATA_LEN);
+	cache_stats.frames_sent++;
+	cache_stats.motors_sent += count;
+	cache_stats.bytes_sent += sent;
+	cache_stats.bytes_saved += full - sent;
+}
+
+DXL_Cache_Stats_t DXL_Cache_Get_Stats(void) {
+	return cache_stats;
+}
@@ -0,0 +1,250 @@
+/*
+ * dxl_crc.c
+ * Description: 다이나믹셀 프로토콜 2.0 CRC16 계산 구현부
+ * Note: CRC는 GF(2) 위의 선형 연산이므로 테이블 값 T[v]는 v의 각 비트에 해당하는
+ *       기저값 8개의 XOR로 표현됨. 기저값만 다항식에서 enum 상수로 유도하고,
+ *       256개 항목은 매크로로 전개하여 컴파일러가 상수로 계산하도록 함
+ * 수정사항: STM32H7 CRC 주변장치 백엔드 (POL=0x8005, 16비트, 입출력 비반사)
+ *   - 부팅 시 소프트웨어 엔진과 비트 단위로 일치하는지 자체 검증 후에만 사용
+ *   - ISR과 메인 루프가 동시에 쓰려 하면 나중 쪽은 소프트웨어 테이블로 계산
+ *   - 레지스터 쓰기는 WRITE_REG로 (호스트 테스트는 이 매크로로 주변장치 모델에 연결)
+ */
+
+#include "dxl_crc.h"
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+// 1. 컴파일 시점 테이블 생성
+// ---------------------------------------------------------------------------
+
+// 비트 1개 진행: 최상위 비트가 1이면 다항식 XOR (비반사 CRC)
+#define DXL_CRC_STEP(c)  ((((c) << 1) ^ (((c) >> 15) * DXL_CRC_POLY)) & 0xFFFFu)
+
+// 기저값 조합으로 T0[v] 계산 (v는 0~255)
+#define DXL_CRC_BIT(v, b, k)  ((((v) >> (b)) & 1u) * DXL_CRC_K##k##_##b)
+#define DXL_CRC_TK(k, v) \
+	(DXL_CRC_BIT(v, 0, k) ^ DXL_CRC_BIT(v, 1, k) ^ DXL_CRC_BIT(v, 2, k) ^ DXL_CRC_BIT(v, 3, k) \
+	^ DXL_CRC_BIT(v, 4, k) ^ DXL_CRC_BIT(v, 5, k) ^ DXL_CRC_BIT(v, 6, k) ^ DXL_CRC_BIT(v, 7, k))
+
+// 0x00 한 바이트만큼 CRC 진행: (x << 8) ^ T0[x >> 8]
+#define DXL_CRC_ADV8(x)  (((((x) << 8) & 0xFFFFu) ^ DXL_CRC_TK(0, (x) >> 8)) & 0xFFFFu)
+
+// 테이블 k의 기저값 8개를 테이블 p의 기저값에서 유도
+#define DXL_CRC_BASIS(k, p) \
+	DXL_CRC_K##k##_0 = DXL_CRC_ADV8(DXL_CRC_K##p##_0), \
+	DXL_CRC_K##k##_1 = DXL_CRC_ADV8(DXL_CRC_K##p##_1), \
+	DXL_CRC_K##k##_2 = DXL_CRC_ADV8(DXL_CRC_K##p##_2), \
+	DXL_CRC_K##k##_3 = DXL_CRC_ADV8(DXL_CRC_K##p##_3), \
+	DXL_CRC_K##k##_4 = DXL_CRC_ADV8(DXL_CRC_K##p##_4), \
+	DXL_CRC_K##k##_5 = DXL_CRC_ADV8(DXL_CRC_K##p##_5), \
+	DXL_CRC_K##k##_6 = DXL_CRC_ADV8(DXL_CRC_K##p##_6), \
+	DXL_CRC_K##k##_7 = DXL_CRC_ADV8(DXL_CRC_K##p##_7)
+
+enum {
+	// T0[1] = 0x0100을 8비트 진행한 값, T0[2^b] = T0[2^(b-1)]을 1비트 더 진행한 값
+	DXL_CRC_X0 = 0x0100,
+	DXL_CRC_X1 = DXL_CRC_STEP(DXL_CRC_X0),
+	DXL_CRC_X2 = DXL_CRC_STEP(DXL_CRC_X1),
+	DXL_CRC_X3 = DXL_CRC_STEP(DXL_CRC_X2),
+	DXL_CRC_X4 = DXL_CRC_STEP(DXL_CRC_X3),
+	DXL_CRC_X5 = DXL_CRC_STEP(DXL_CRC_X4),
+	DXL_CRC_X6 = DXL_CRC_STEP(DXL_CRC_X5),
+	DXL_CRC_X7 = DXL_CRC_STEP(DXL_CRC_X6),
+	DXL_CRC_K0_0 = DXL_CRC_STEP(DXL_CRC_X7),
+	DXL_CRC_K0_1 = DXL_CRC_STEP(DXL_CRC_K0_0),
+	DXL_CRC_K0_2 = DXL_CRC_STEP(DXL_CRC_K0_1),
+	DXL_CRC_K0_3 = DXL_CRC_STEP(DXL_CRC_K0_2),
+	DXL_CRC_K0_4 = DXL_CRC_STEP(DXL_CRC_K0_3),
+	DXL_CRC_K0_5 = DXL_CRC_STEP(DXL_CRC_K0_4),
+	DXL_CRC_K0_6 = DXL_CRC_STEP(DXL_CRC_K0_5),
+	DXL_CRC_K0_7 = DXL_CRC_STEP(DXL_CRC_K0_6),
+	DXL_CRC_BASIS(1, 0),
+	DXL_CRC_BASIS(2, 1),
+	DXL_CRC_BASIS(3, 2),
+	DXL_CRC_BASIS(4, 3),
+	DXL_CRC_BASIS(5, 4),
+	DXL_CRC_BASIS(6, 5),
+	DXL_CRC_BASIS(7, 6),
+};
+
+// 256개 항목 전개
+#define DXL_CRC_R4(k, n)   DXL_CRC_TK(k, n), DXL_CRC_TK(k, n + 1), DXL_CRC_TK(k, n + 2), DXL_CRC_TK(k, n + 3)
+#define DXL_CRC_R16(k, n)  DXL_CRC_R4(k, n), DXL_CRC_R4(k, n + 4), DXL_CRC_R4(k, n + 8), DXL_CRC_R4(k, n + 12)
+#define DXL_CRC_R64(k, n)  DXL_CRC_R16(k, n), DXL_CRC_R16(k, n + 16), DXL_CRC_R16(k, n + 32), DXL_CRC_R16(k, n + 48)
+#define DXL_CRC_R256(k)    DXL_CRC_R64(k, 0), DXL_CRC_R64(k, 64), DXL_CRC_R64(k, 128), DXL_CRC_R64(k, 192)
+
+const uint16_t dxl_crc_table[8][256] = {
+	{ DXL_CRC_R256(0) }, { DXL_CRC_R256(1) }, { DXL_CRC_R256(2) }, { DXL_CRC_R256(3) },
+	{ DXL_CRC_R256(4) }, { DXL_CRC_R256(5) }, { DXL_CRC_R256(6) }, { DXL_CRC_R256(7) },
+};
+
+// 생성 결과 검증 (DYNAMIXEL 표준 테이블의 알려진 값과 비교)
+_Static_assert(DXL_CRC_TK(0, 1) == 0x8005, "crc table T0[1]");
+_Static_assert(DXL_CRC_TK(0, 0x2C) == 0x80EB, "crc table T0[0x2C]");
+_Static_assert(DXL_CRC_TK(0, 0xFF) == 0x0202, "crc table T0[0xFF]");
+
+// ---------------------------------------------------------------------------
+// 2. CRC 엔진
+// ---------------------------------------------------------------------------
+
+// 바이트 단위 테이블 조회 (기존 update_crc와 동일한 방식)
+uint16_t DXL_CRC_Update_Byte(uint16_t crc, const uint8_t *data, uint16_t len) {
+	const uint16_t *t0 = dxl_crc_table[0];
+	while (len--) {
+		crc = (uint16_t) (crc << 8) ^ t0[((crc >> 8) ^ *data++) & 0xFF];
+	}
+	return crc;
+}
+
+// slice-by-4: 4바이트마다 테이블 4개를 병렬 조회
+uint16_t DXL_CRC_Update_Slice4(uint16_t crc, const uint8_t *data, uint16_t len) {
+	const uint16_t (*t)[256] = dxl_crc_table;
+	while (len >= 4) {
+		uint16_t x = crc ^ (uint16_t) ((data[0] << 8) | data[1]);
+		crc = t[3][x >> 8] ^ t[2][x & 0xFF] ^ t[1][data[2]] ^ t[0][data[3]];
+		data += 4;
+		len -= 4;
+	}
+	return DXL_CRC_Update_Byte(crc, data, len);
+}
+
+// slice-by-8: 8바이트마다 테이블 8개를 병렬 조회
+uint16_t DXL_CRC_Update_Slice8(uint16_t crc, const uint8_t *data, uint16_t len) {
+	const uint16_t (*t)[256] = dxl_crc_table;
+	while (len >= 8) {
+		uint16_t x = crc ^ (uint16_t) ((data[0] << 8) | data[1]);
+		crc = t[7][x >> 8] ^ t[6][x & 0xFF] ^ t[5][data[2]] ^ t[4][data[3]]
+				^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+		data += 8;
+		len -= 8;
+	}
+	return DXL_CRC_Update_Slice4(crc, data, len);
+}
+
+// ---------------------------------------------------------------------------
+// 3. CRC 주변장치 백엔드
+// ---------------------------------------------------------------------------
+
+static DXL_CRC_Backend_t dxl_crc_backend = DXL_CRC_BACKEND_SW;
+static volatile uint8_t dxl_crc_hw_lock = 0; // 1: 주변장치 사용 중
+static DXL_CRC_Stats_t dxl_crc_stats = { 0, };
+
+// 주변장치 점유 시도 (이미 사용 중이면 0 반환)
+static uint8_t crc_hw_try_lock(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	uint8_t ok = (dxl_crc_hw_lock == 0);
+	if (ok)
+		dxl_crc_hw_lock = 1;
+	__set_PRIMASK(primask);
+	return ok;
+}
+
+// 초기값 적재 후 계산 시작 상태로 리셋
+static void crc_hw_start(uint16_t crc) {
+	WRITE_REG(CRC->INIT, crc);
+	WRITE_REG(CRC->CR, CRC_CR_POLYSIZE_0 | CRC_CR_RESET); // 16비트 다항식, REV_IN/REV_OUT 없음
+}
+
+// CPU가 직접 주변장치에 공급 (4바이트 단위 쓰기, 입력 비반사이므로 상위 바이트부터 처리되도록 바이트 순서 반전)
+static uint16_t crc_hw_feed(uint16_t crc, const uint8_t *data, uint16_t len) {
+	crc_hw_start(crc);
+	while (len >= 4) {
+		uint32_t word;
+		memcpy(&word, data, 4);
+		WRITE_REG(CRC->DR, __REV(word));
+		data += 4;
+		len -= 4;
+	}
+	while (len--) {
+		WRITE_REG(*(__IO uint8_t*) &CRC->DR, *data++); // 나머지는 8비트 쓰기 (1바이트씩 처리됨)
+	}
+	return (uint16_t) READ_REG(CRC->DR);
+}
+
+// 주변장치 결과를 소프트웨어 엔진과 비교 (길이 0~68 = 4로 나눈 나머지 전부, 여러 초기값)
+static uint8_t crc_hw_self_test(void) {
+	uint8_t buf[68];
+	for (uint16_t i = 0; i < sizeof(buf); i++)
+		buf[i] = (uint8_t) (i * 151u + 0xFD);
+
+	for (uint16_t len = 0; len <= sizeof(buf); len++) {
+		uint16_t init = (uint16_t) (len * 0x1021u);
+		if (crc_hw_feed(init, buf, len) != DXL_CRC_Update_Slice8(init, buf, len))
+			return 0;
+	}
+	return 1;
+}
+
+// CRC 주변장치 초기화 및 자체 검증 (통과할 때만 하드웨어 백엔드 사용)
+DXL_CRC_Backend_t DXL_CRC_Init(void) {
+	__HAL_RCC_CRC_CLK_ENABLE();
+
+	WRITE_REG(CRC->POL, DXL_CRC_POLY);
+	WRITE_REG(CRC->CR, CRC_CR_POLYSIZE_0);
+
+	dxl_crc_backend = crc_hw_self_test() ? DXL_CRC_BACKEND_HW : DXL_CRC_BACKEND_SW;
+	return dxl_crc_backend;
+}
+
+DXL_CRC_Backend_t DXL_CRC_Get_Backend(void) {
+	return dxl_crc_backend;
+}
+
+DXL_CRC_Stats_t DXL_CRC_Get_Stats(void) {
+	return dxl_crc_stats;
+}
+
+// CRC 주변장치로 계산
+uint16_t DXL_CRC_HW_Update(uint16_t crc, const uint8_t *data, uint16_t len) {
+	if (dxl_crc_backend != DXL_CRC_BACKEND_HW || !crc_hw_try_lock()) {
+		dxl_crc_stats.sw_fallbacks++;
+		return DXL_CRC_Update_Slice8(crc, data, len);
+	}
+	crc = crc_hw_feed(crc, data, len);
+	dxl_crc_stats.hw_calls++;
+	dxl_crc_hw_lock = 0;
+	return crc;
+}
+
+// 기본 CRC 계산
+uint16_t DXL_CRC_Update(uint16_t crc, const uint8_t *data, uint16_t len) {
+	if (dxl_crc_backend == DXL_CRC_BACKEND_HW)
+		return DXL_CRC_HW_Update(crc, data, len);
+	return DXL_CRC_Update_Slice8(crc, data, len);
+}
+
+// ---------------------------------------------------------------------------
+// 4. 벤치마크 (Cortex-M7 DWT 사이클 카운터)
+// ---------------------------------------------------------------------------
+
+void DXL_CRC_Benchmark(DXL_CRC_Bench_t *result, uint32_t iterations) {
+	// 관절 8개 위치 Sync Write 패킷과 같은 길이/구성의 측정용 데이터 (CRC 2바이트 제외)
+	uint8_t frame[52] = { 0xFF, 0xFF, 0xFD, 0x00, 0xFE, 0x2F, 0x00, 0x83, 0x74, 0x00, 0x04, 0x00 };
+	for (uint16_t i = 12; i < sizeof(frame); i++)
+		frame[i] = (uint8_t) (i * 37u);
+
+	uint16_t (*const engines[4])(uint16_t, const uint8_t*, uint16_t) = {
+			DXL_CRC_Update_Byte, DXL_CRC_Update_Slice4, DXL_CRC_Update_Slice8, DXL_CRC_HW_Update };
+	int engine_count = (dxl_crc_backend == DXL_CRC_BACKEND_HW) ? 4 : 3;
+	uint32_t cycles[4] = { 0, };
+	volatile uint16_t sink[4];
+
+	if (iterations == 0)
+		iterations = 1;
+
+	for (int e = 0; e < engine_count; e++) {
+		uint32_t start = DWT->CYCCNT;
+		for (uint32_t n = 0; n < iterations; n++)
+			sink[e] = engines[e](0, frame, sizeof(frame));
+		cycles[e] = (DWT->CYCCNT - start) / iterations;
+	}
+
+	result->frame_len = sizeof(frame);
+	result->cycles_byte = cycles[0];
+	result->cycles_slice4 = cycles[1];
+	result->cycles_slice8 = cycles[2];
+	result->cycles_hw = cycles[3];
+	result->match = (sink[0] == sink[1]) && (sink[1] == sink[2])
+			&& (engine_count < 4 || sink[2] == sink[3]);
+}
@@ -0,0 +1,248 @@
+/*
+ * dxl_diag.c
+ * Description: 모터 진단 표 순환 갱신 구현부
+ * Note: 스윕 단계 = 관절 Moving~Moving Status, 관절 입력 전압~온도, 관절 Hardware Error Status,
+ *       바퀴마다 Present Load~Moving (1.0). 채움 슬롯 1회에 요청 1개만 보내므로 응답이 겹치지 않음.
+ *       Indirect 매핑 시 관절 전압/온도/오류 단계는 매 주기 상태 읽기 값을 복사하고 건너뜀
+ */
+
+#include "dxl_diag.h"
+#include "dxl_2_0.h"
+#include "dxl_bus.h"
+
+// 스윕 단계 (관절 묶음 3개 다음 바퀴 순서)
+enum {
+	SWEEP_JOINT_MOVING = 0, // Moving(122) + Moving Status(123)
+	SWEEP_JOINT_POWER,      // Present Input Voltage(144) + Present Temperature(146)
+	SWEEP_JOINT_HW_ERROR,   // Hardware Error Status(70)
+	SWEEP_WHEEL_0,          // 바퀴 w = SWEEP_WHEEL_0 + w: Present Load(40) ~ Moving(46)
+	SWEEP_STEPS = SWEEP_WHEEL_0 + LEG_COUNT
+};
+
+// 단계별 읽기 구간 (첫 항목 주소 ~ 마지막 항목 끝)
+typedef struct {
+	uint16_t addr;
+	uint16_t len;
+} Sweep_Range_t;
+
+static DXL_Diag_Motor_t diag_table[DXL_DIAG_MOTORS];
+static DXL_Diag_Report_t diag_report = { 0, };
+static uint8_t diag_sent_step = SWEEP_STEPS; // 응답 대기 중인 요청의 단계 (SWEEP_STEPS: 없음)
+static uint32_t diag_round_start;            // 현재 한 바퀴 시작 시각 (HAL_GetTick)
+
+void DXL_Diag_Init(void) {
+	for (uint8_t m = 0; m < DXL_DIAG_MOTORS; m++) {
+		DXL_Diag_Motor_t *d = &diag_table[m];
+		*d = (DXL_Diag_Motor_t) { 0 };
+		d->id = (m < JOINT_COUNT) ? robot_joint_ids[m] : robot_wheel_ids[m - JOINT_COUNT];
+	}
+	diag_report = (DXL_Diag_Report_t) { 0 };
+	diag_sent_step = SWEEP_STEPS;
+	diag_round_start = HAL_GetTick();
+}
+
+static Sweep_Range_t sweep_range_of(DXL_Model_t model, DXL_Field_t first, DXL_Field_t last) {
+	Sweep_Range_t r;
+	r.addr = DXL_Model_Addr(model, first);
+	r.len = DXL_Model_Addr(model, last) + DXL_Model_Size(model, last) - r.addr;
+	return r;
+}
+
+static Sweep_Range_t sweep_range(uint8_t step) {
+	switch (step) {
+	case SWEEP_JOINT_MOVING:
+		return sweep_range_of(DXL_JOINT_MODEL, DXL_FIELD_MOVING, DXL_FIELD_MOVING_STATUS);
+	case SWEEP_JOINT_POWER:
+		return sweep_range_of(DXL_JOINT_MODEL, DXL_FIELD_PRESENT_INPUT_VOLTAGE, DXL_FIELD_PRESENT_TEMPERATURE);
+	case SWEEP_JOINT_HW_ERROR:
+		return sweep_range_of(DXL_JOINT_MODEL, DXL_FIELD_HARDWARE_ERROR_STATUS, DXL_FIELD_HARDWARE_ERROR_STATUS);
+	default:
+		return sweep_range_of(DXL_WHEEL_MODEL, DXL_FIELD_PRESENT_LOAD, DXL_FIELD_MOVING);
+	}
+}
+
+// 버스를 쓰지 않고 건너뛰는 단계 (상태 읽기에 이미 들어 있음 / 읽을 관절 없음)
+static uint8_t sweep_step_local(uint8_t step) {
+	if (step >= SWEEP_WHEEL_0)
+		return 0;
+	if (DXL_Get_Joint_Read_Mask() == 0)
+		return 1; // 모든 관절이 복구 중
+	return DXL_Indirect_Is_Ready() && (step == SWEEP_JOINT_POWER || step == SWEEP_JOINT_HW_ERROR);
+}
+
+// 현재 단계부터 버스를 쓰는 첫 단계 (상태는 바꾸지 않음)
+static uint8_t sweep_next_bus_step(void) {
+	uint8_t step = diag_report.step;
+	for (uint8_t k = 0; k < SWEEP_STEPS && sweep_step_local(step); k++)
+		step = (uint8_t) ((step + 1) % SWEEP_STEPS);
+	return step;
+}
+
+// 한 단계 진행 (마지막 단계 다음이면 한 바퀴 완료)
+static void sweep_advance(uint32_t now) {
+	if (++diag_report.step < SWEEP_STEPS)
+		return;
+	diag_report.step = 0;
+	diag_report.rounds++;
+	diag_report.round_ms = now - diag_round_start;
+	diag_round_start = now;
+}
+
+static inline void diag_mark(DXL_Diag_Motor_t *d, DXL_Diag_Item_t item, uint32_t stamp) {
+	d->valid |= (uint8_t) (1U << item);
+	d->stamp[item] = stamp;
+}
+
+// 매 주기 상태 읽기로 받은 항목 복사 (갱신 시각은 상태 응답 시각 그대로)
+static void diag_copy_state(void) {
+	uint8_t block = DXL_Indirect_Is_Ready();
+
+	for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+		const DXL_Joint_State_t *s = DXL_Get_Joint_State(j);
+		DXL_Diag_Motor_t *d = &diag_table[j];
+		if (!s->valid || (((d->valid >> DXL_DIAG_LOAD) & 1) && d->stamp[DXL_DIAG_LOAD] == s->stamp))
+			continue;
+
+		d->load = s->current;
+		diag_mark(d, DXL_DIAG_LOAD, s->stamp);
+		if (block) {
+			d->hw_error = s->hw_error;
+			d->voltage = s->voltage;
+			d->temperature = s->temperature;
+			diag_mark(d, DXL_DIAG_HW_ERROR, s->stamp);
+			diag_mark(d, DXL_DIAG_VOLTAGE, s->stamp);
+			diag_mark(d, DXL_DIAG_TEMPERATURE, s->stamp);
+		}
+	}
+}
+
+// 단계의 선로 비용 (관절: Sync Read 요청 14 + N, 응답 N x (11 + 길이) / 바퀴: Read 요청 8, 응답 6 + 길이)
+static DXL_Frame_Cost_t sweep_cost(uint8_t step) {
+	DXL_Frame_Cost_t c = { 0, 0, 0 };
+	Sweep_Range_t r = sweep_range(step);
+
+	if (step >= SWEEP_WHEEL_0) {
+		c.tx_bytes = 8;
+		c.rx_bytes = 6 + r.len;
+		c.replies = 1;
+		return c;
+	}
+
+	uint8_t n = 0;
+	for (uint8_t mask = DXL_Get_Joint_Read_Mask(); mask; mask &= (uint8_t) (mask - 1))
+		n++;
+	if (n == 0)
+		return c;
+	c.tx_bytes = 14 + n;
+	c.rx_bytes = n * (11 + r.len);
+	c.replies = n;
+	return c;
+}
+
+DXL_Frame_Cost_t DXL_Diag_Sweep_Cost(void) {
+	return sweep_cost(sweep_next_bus_step());
+}
+
+void DXL_Diag_Sweep_Slot(void) {
+	uint32_t now = HAL_GetTick();
+	HAL_StatusTypeDef st;
+
+	diag_copy_state();
+
+	// 버스를 쓰지 않는 단계는 진행만 함 (바퀴 단계는 항상 버스를 쓰므로 한 바퀴 안에 멈춤)
+	while (sweep_step_local(diag_report.step))
+		sweep_advance(now);
+
+	uint8_t step = diag_report.step;
+	Sweep_Range_t r = sweep_range(step);
+	if (step < SWEEP_WHEEL_0) {
+		st = send_sweep_read_joints(r.addr, r.len);
+	} else {
+		// 1.0 응답 해석 구간 = 스케줄러가 이 요청에 배정한 선로 시간
+		DXL_Frame_Cost_t c = sweep_cost(step);
+		uint32_t baud = DXL_Bus_Get_Baud();
+		uint32_t window = DXL_Sched_Wire_Us(c.tx_bytes + c.rx_bytes, baud)
+				+ DXL_Sched_Get_Report()->rdt_us + DXL_SCHED_GUARD_US;
+		st = send_sweep_read_wheel(step - SWEEP_WHEEL_0, (uint8_t) r.addr, (uint8_t) r.len, window);
+	}
+
+	if (st == HAL_OK) {
+		diag_sent_step = step;
+		diag_report.requests++;
+		sweep_advance(now);
+	}
+}
+
+// 읽기 구간 안의 항목 값 (base: 구간 시작 주소)
+static int32_t range_get(DXL_Model_t model, DXL_Field_t field, uint16_t base, const uint8_t *data) {
+	const DXL_Field_Info_t *f = DXL_Model_Field(model, field);
+	return DXL_Model_Decode(f, &data[f->addr - base]);
+}
+
+void DXL_Diag_Store(uint8_t motor, uint8_t error, const uint8_t *data, uint16_t len) {
+	if (motor >= DXL_DIAG_MOTORS || diag_sent_step >= SWEEP_STEPS)
+		return;
+
+	DXL_Diag_Motor_t *d = &diag_table[motor];
+	Sweep_Range_t r = sweep_range(diag_sent_step);
+	uint32_t now = HAL_GetTick();
+	if (len != r.len)
+		return;
+
+	if (motor >= JOINT_COUNT) {
+		if (diag_sent_step != SWEEP_WHEEL_0 + (motor - JOINT_COUNT))
+			return;
+		// AX-12 Present Load: bit0~9 크기, bit10 방향 (부호-크기 표현)
+		int32_t load = range_get(DXL_WHEEL_MODEL, DXL_FIELD_PRESENT_LOAD, r.addr, data);
+		d->load = (int16_t) ((load & 0x400) ? -(load & 0x3FF) : (load & 0x3FF));
+		d->voltage = (uint16_t) range_get(DXL_WHEEL_MODEL, DXL_FIELD_PRESENT_INPUT_VOLTAGE, r.addr, data);
+		d->temperature = (uint8_t) range_get(DXL_WHEEL_MODEL, DXL_FIELD_PRESENT_TEMPERATURE, r.addr, data);
+		d->moving = (uint8_t) range_get(DXL_WHEEL_MODEL, DXL_FIELD_MOVING, r.addr, data);
+		d->hw_error = error;
+		diag_mark(d, DXL_DIAG_LOAD, now);
+		diag_mark(d, DXL_DIAG_VOLTAGE, now);
+		diag_mark(d, DXL_DIAG_TEMPERATURE, now);
+		diag_mark(d, DXL_DIAG_MOVING, now);
+		diag_mark(d, DXL_DIAG_HW_ERROR, now);
+		return;
+	}
+
+	switch (diag_sent_step) {
+	case SWEEP_JOINT_MOVING:
+		d->moving = (uint8_t) range_get(DXL_JOINT_MODEL, DXL_FIELD_MOVING, r.addr, data);
+		d->moving_status = (uint8_t) range_get(DXL_JOINT_MODEL, DXL_FIELD_MOVING_STATUS, r.addr, data);
+		diag_mark(d, DXL_DIAG_MOVING, now);
+		break;
+	case SWEEP_JOINT_POWER:
+		d->voltage = (uint16_t) range_get(DXL_JOINT_MODEL, DXL_FIELD_PRESENT_INPUT_VOLTAGE, r.addr, data);
+		d->temperature = (uint8_t) range_get(DXL_JOINT_MODEL, DXL_FIELD_PRESENT_TEMPERATURE, r.addr, data);
+		diag_mark(d, DXL_DIAG_VOLTAGE, now);
+		diag_mark(d, DXL_DIAG_TEMPERATURE, now);
+		break;
+	case SWEEP_JOINT_HW_ERROR:
+		d->hw_error = data[0];
+		diag_mark(d, DXL_DIAG_HW_ERROR, now);
+		break;
+	default:
+		break;
+	}
+}
+
+const DXL_Diag_Motor_t* DXL_Diag_Get(uint8_t motor) {
+	if (motor >= DXL_DIAG_MOTORS)
+		return NULL;
+	return &diag_table[motor];
+}
+
+uint32_t DXL_Diag_Age_Ms(uint8_t motor, DXL_Diag_Item_t item) {
+	if (motor >= DXL_DIAG_MOTORS || item >= DXL_DIAG_ITEM_COUNT)
+		return DXL_DIAG_NEVER;
+	const DXL_Diag_Motor_t *d = &diag_table[motor];
+	if (!((d->valid >> item) & 1))
+		return DXL_DIAG_NEVER;
+	return HAL_GetTick() - d->stamp[item];
+}
+
+const DXL_Diag_Report_t* DXL_Diag_Get_Report(void) {
+	return &diag_report;
+}
@@ -0,0 +1,75 @@
+/*
+ * dxl_estop.c
+ * Description: 모터 버스 비상 정지 구현부
+ * Note: 시간 측정은 DWT 사이클 카운터 (main.c의 DWT_Cycle_Init에서 활성화), 패킷은 RAM에 미리 완성해 둠
+ *       (트리거 시 CRC/체크섬 계산 없음)
+ */
+
+#include "dxl_estop.h"
+#include "dxl_2_0.h"
+#include "dxl_bus.h"
+#include "dxl_sched.h"
+
+static uint8_t estop_frames[DXL_ESTOP_FRAME_MAX];
+static DXL_Estop_Report_t estop_report = { 0, };
+static uint32_t estop_resend_stamp; // 마지막 송신 시각 (HAL_GetTick, 메인 루프에서만 사용)
+
+HAL_StatusTypeDef DXL_Estop_Init(void) {
+	estop_report.frame_len = DXL_Build_Torque_Off_Frames(estop_frames, sizeof(estop_frames));
+	if (estop_report.frame_len == 0)
+		return HAL_ERROR;
+
+	// 최악: 관절 쓰기(가장 긴 패킷)가 막 시작된 순간에 눌림 -> 그 패킷을 끝까지 보낸 뒤 토크 OFF
+	uint32_t baud = DXL_Bus_Get_Baud();
+	uint32_t worst = DXL_Get_Joint_Write_Cost().tx_bytes + estop_report.frame_len;
+	estop_report.bound_us = baud ? DXL_Sched_Wire_Us(worst, baud) + DXL_SCHED_GUARD_US : 0;
+	return HAL_OK;
+}
+
+// 토크 OFF 송신 후 걸린 시간 기록 (start: DWT 사이클)
+static void estop_send(uint32_t start) {
+	uint16_t tail;
+	if (DXL_Bus_Estop(estop_frames, estop_report.frame_len, &tail) != HAL_OK)
+		estop_report.failures++;
+
+	uint32_t us = (DWT->CYCCNT - start) / (SystemCoreClock / 1000000U);
+	if (!estop_report.latched) {
+		estop_report.tail_bytes = tail;
+		estop_report.latency_us = us;
+	}
+	if (us > estop_report.latency_max_us)
+		estop_report.latency_max_us = us;
+}
+
+void DXL_Estop_Trigger(void) {
+	uint32_t start = DWT->CYCCNT;
+
+	estop_report.triggers++;
+	if (estop_report.latched)
+		return; // 이미 정지됨 (버튼 채터링) - 재송신은 제어 루프에서
+
+	if (estop_report.frame_len == 0)
+		DXL_Estop_Init(); // 부팅 설정 중 눌린 경우
+	estop_send(start);
+	estop_report.latched = 1;
+	estop_resend_stamp = HAL_GetTick(); // ISR 안에서는 멈춰 있을 수 있으나 간격 기준으로만 사용
+}
+
+uint8_t DXL_Estop_Is_Latched(void) {
+	return estop_report.latched;
+}
+
+void DXL_Estop_Service(void) {
+	if (!estop_report.latched || estop_report.resends >= DXL_ESTOP_RESENDS)
+		return;
+	if (HAL_GetTick() - estop_resend_stamp < DXL_ESTOP_RESEND_MS)
+		return;
+
+	estop_send(DWT->CYCCNT);
+	estop_report.resends++;
+	estop_resend_stamp = HAL_GetTick();
+}
+
+const DXL_Estop_Report_t* DXL_Estop_Get_Report(void) {
+	return &estop_report;
+}
@@ -0,0 +1,112 @@
+/*
+ * dxl_health.c
+ * Description: 모터별 버스 상태 카운터 구현부
+ * Note: 호출 위치 - 송신: Sync Write 템플릿 송신, Sync Read/진단 요청, 단일 모터 요청
+ *                   응답/CRC: 관절 상태 수신(DXL_Poll_Joint_State)과 단일 모터 요청의 응답 대기
+ *                   응답 없음: 다음 Sync Read/진단 요청 시점에 이전 요청의 응답이 안 온 모터
+ */
+
+#include "dxl_health.h"
+#include <string.h>
+
+#define HEALTH_NONE 0xFF // ID 표에서 '구성에 없는 ID'
+
+static DXL_Health_t health[DXL_HEALTH_MAX_MOTORS];
+static DXL_Health_Bus_t health_bus;
+static uint8_t health_slot[256]; // 모터 ID -> health[] 번호
+
+void DXL_Health_Init(void) {
+	memset(health_slot, HEALTH_NONE, sizeof(health_slot));
+	for (int j = 0; j < JOINT_COUNT; j++) {
+		health[j].id = robot_joint_ids[j];
+		health_slot[robot_joint_ids[j]] = (uint8_t) j;
+	}
+	for (int w = 0; w < LEG_COUNT; w++) {
+		health[JOINT_COUNT + w].id = robot_wheel_ids[w];
+		health_slot[robot_wheel_ids[w]] = (uint8_t) (JOINT_COUNT + w);
+	}
+	DXL_Health_Clear();
+}
+
+void DXL_Health_Clear(void) {
+	for (int i = 0; i < DXL_HEALTH_MAX_MOTORS; i++) {
+		uint8_t id = health[i].id;
+		memset(&health[i], 0, sizeof(health[i]));
+		health[i].id = id;
+	}
+	memset(&health_bus, 0, sizeof(health_bus));
+}
+
+static inline DXL_Health_t* health_of(uint8_t id) {
+	uint8_t s = health_slot[id];
+	return (s == HEALTH_NONE) ? NULL : &health[s];
+}
+
+void DXL_Health_Sent(uint8_t id) {
+	DXL_Health_t *h = health_of(id);
+	if (h)
+		h->frames_sent++;
+}
+
+void DXL_Health_Reply(uint8_t id, uint8_t error, uint32_t request_stamp) {
+	DXL_Health_t *h = health_of(id);
+	if (h == NULL) {
+		health_bus.unknown_replies++;
+		return;
+	}
+
+	h->replies++;
+	h->last_error = error;
+	h->status_errors += (error & 0x7F) != 0;
+	h->alerts += error >> 7;
+
+	// log2 구간: 사이클을 2^SHIFT 단위로 줄인 값의 유효 비트 수 (__CLZ 1회, 나눗셈 없음)
+	uint32_t cycles = DWT->CYCCNT - request_stamp;
+	uint32_t bin = 32U - __CLZ(cycles >> DXL_HEALTH_HIST_SHIFT);
+	if (bin >= DXL_HEALTH_HIST_BINS)
+		bin = DXL_HEALTH_HIST_BINS - 1;
+	h->latency_hist[bin]++;
+	if (cycles > h->latency_max)
+		h->latency_max = cycles;
+}
+
+void DXL_Health_Crc_Error(uint8_t id) {
+	DXL_Health_t *h = health_of(id);
+	if (h)
+		h->crc_errors++;
+	else
+		health_bus.unknown_crc++;
+}
+
+void DXL_Health_Timeout(uint8_t id) {
+	DXL_Health_t *h = health_of(id);
+	if (h)
+		h->timeouts++;
+}
+
+void DXL_Health_Hw_Error(uint8_t id, uint8_t hw_error_status) {
+	DXL_Health_t *h = health_of(id);
+	if (h)
+		h->hw_error_bits |= hw_error_status;
+}
+
+const DXL_Health_t* DXL_Health_Get(uint8_t id) {
+	return health_of(id);
+}
+
+const DXL_Health_t* DXL_Health_Get_Index(uint8_t index) {
+	if (index >= DXL_HEALTH_MAX_MOTORS)
+		return NULL;
+	return &health[index];
+}
+
+const DXL_Health_Bus_t* DXL_Health_Get_Bus(void) {
+	return &health_bus;
+}
+
+uint32_t DXL_Health_Bin_Upper_Us(uint8_t bin) {
+	uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+	if (bin >= DXL_HEALTH_HIST_BINS || cycles_per_us == 0)
+		return 0;
+	return (uint32_t) (((uint64_t) 1 << (bin + DXL_HEALTH_HIST_SHIFT)) / cycles_per_us);
+}
@@ -0,0 +1,303 @@
+/*
+ * dxl_link.c
+ * Description: 다이나믹셀 버스 링크 설정 구현부
+ * Note: Baud Rate / Return Delay Time은 EEPROM 영역이므로 현재 값과 다를 때만 씀 (쓰기 수명 보호)
+ *       MX는 Baud Rate를 쓰면 이전 속도로 응답한 뒤 새 속도로 전환함
+ * 수정사항: robot_topology 배열로 모터 순회, Ping 응답 모델 번호를 구성 표와 비교
+ * 수정사항: 부팅 탐색(브로드캐스트 Ping)과 토크 ON 확인 대기 추가
+ * 수정사항: 링크 설정은 탐색에서 응답한 모터의 Ping을 생략 (모델 확인도 탐색 결과 사용)
+ */
+
+#include "dxl_link.h"
+#include "dxl_2_0.h"
+#include "dxl_bus.h"
+#include "dxl_sched.h"
+#include <string.h>
+
+#define DXL_LINK_FACTORY_RDT 250 // 읽기 실패 시 가정하는 공장 설정값 (500us)
+
+// MX(프로토콜 2.0) Baud Rate 설정값 -> 보레이트
+static const uint32_t mx_baud_table[] = { 9600, 57600, 115200, 1000000, 2000000, 3000000,
+		4000000, 4500000 };
+
+static int mx_baud_index(uint32_t baud) {
+	for (int i = 0; i < (int) (sizeof(mx_baud_table) / sizeof(mx_baud_table[0])); i++) {
+		if (mx_baud_table[i] == baud)
+			return i;
+	}
+	return -1;
+}
+
+static void link_missing(DXL_Link_Report_t *report, uint8_t id) {
+	if (report->missing_count < DXL_LINK_MAX_MOTORS)
+		report->missing_ids[report->missing_count] = id;
+	report->missing_count++;
+}
+
+// id가 목록에 있는지
+static uint8_t link_in_list(const uint8_t *ids, uint8_t count, uint8_t id) {
+	for (uint8_t i = 0; i < count && i < DXL_LINK_MAX_MOTORS; i++) {
+		if (ids[i] == id)
+			return 1;
+	}
+	return 0;
+}
+
+// 탐색에서 이미 응답을 확인한 모터인지 (탐색 결과가 없으면 0 -> Ping)
+static uint8_t link_confirmed(const DXL_Discovery_Report_t *discovery, uint8_t id) {
+	return discovery != NULL && !link_in_list(discovery->missing_ids, discovery->missing_count, id);
+}
+
+// MX Return Delay Time 확인 후 다르면 쓰기 (적용된 값 반환)
+static uint8_t link_rdt_2_0(DXL_Link_Report_t *report, uint8_t id) {
+	uint8_t rdt;
+	if (dxl_read_2_0(id, DXL_JOINT_ADDR(RETURN_DELAY_TIME), &rdt, 1) != HAL_OK) {
+		report->rdt_failed++;
+		return DXL_LINK_FACTORY_RDT;
+	}
+	if (rdt != DXL_LINK_RDT) {
+		uint8_t value = DXL_LINK_RDT;
+		if (dxl_write_2_0(id, DXL_JOINT_ADDR(RETURN_DELAY_TIME), &value, 1) != HAL_OK) {
+			report->rdt_failed++;
+			return rdt;
+		}
+		report->rdt_written++;
+	}
+	return DXL_LINK_RDT;
+}
+
+// AX Return Delay Time 확인 후 다르면 쓰기 (적용된 값 반환)
+static uint8_t link_rdt_1_0(DXL_Link_Report_t *report, uint8_t id) {
+	uint8_t rdt;
+	if (dxl_read_1_0(id, DXL_WHEEL_ADDR(RETURN_DELAY_TIME), &rdt, 1) != HAL_OK) {
+		report->rdt_failed++;
+		return DXL_LINK_FACTORY_RDT;
+	}
+	if (rdt != DXL_LINK_RDT) {
+		if (dxl_write_1_0(id, DXL_WHEEL_ADDR(RETURN_DELAY_TIME), 1, DXL_LINK_RDT) != HAL_OK) {
+			report->rdt_failed++;
+			return rdt;
+		}
+		report->rdt_written++;
+	}
+	return DXL_LINK_RDT;
+}
+
+// MX 전체 보레이트 변경 후 새 속도로 Ping 확인 (실패 시 기본 보레이트로 복귀)
+static HAL_StatusTypeDef link_upgrade_baud(DXL_Link_Report_t *report, const uint8_t *mx_ids,
+		uint8_t mx_count, uint32_t baud) {
+	uint32_t old_baud = DXL_Bus_Get_Baud();
+	uint8_t value = (uint8_t) mx_baud_index(baud);
+	uint8_t ok = 1;
+
+	for (uint8_t i = 0; i < mx_count && ok; i++)
+		ok = (dxl_write_2_0(mx_ids[i], DXL_JOINT_ADDR(BAUD_RATE), &value, 1) == HAL_OK);
+
+	if (ok) {
+		ok = (DXL_Bus_Set_Baud(baud) == HAL_OK);
+		HAL_Delay(1); // 모터가 EEPROM 저장 후 새 속도로 전환할 시간
+	}
+
+	for (uint8_t i = 0; i < mx_count && ok; i++)
+		ok = (dxl_ping_2_0(mx_ids[i], NULL) == HAL_OK);
+
+	if (ok)
+		return HAL_OK;
+
+	// 실패: 새 속도로 바뀐 모터들에게 원래 값을 브로드캐스트한 뒤 UART도 원래 속도로 복귀
+	report->baud_fallback = 1;
+	value = (uint8_t) mx_baud_index(old_baud);
+	if (DXL_Bus_Get_Baud() != baud)
+		DXL_Bus_Set_Baud(baud);
+	dxl_write_2_0(0xFE, DXL_JOINT_ADDR(BAUD_RATE), &value, 1);
+	DXL_Bus_Set_Baud(old_baud);
+	HAL_Delay(1);
+	return HAL_ERROR;
+}
+
+// 구성 표의 모터 1개 응답 처리: 처음 응답이면 1 반환 (모델이 다르면 기록)
+static uint8_t discover_mark(DXL_Discovery_Report_t *report, uint32_t *found, int index,
+		uint8_t id, uint16_t model, DXL_Model_t expect) {
+	if ((*found >> index) & 1)
+		return 0;
+	*found |= 1UL << index;
+
+	if (model != DXL_Model_Get(expect)->model_number) {
+		report->mismatch_ids[report->mismatch_count] = id;
+		report->mismatch_models[report->mismatch_count] = model;
+		report->mismatch_count++;
+	}
+	return 1;
+}
+
+// 구성 표에 없는 ID 기록 (탐색을 반복해도 한 번만)
+static void discover_unexpected(DXL_Discovery_Report_t *report, uint8_t id, uint16_t model) {
+	uint8_t n = report->unexpected_count;
+	for (uint8_t i = 0; i < n && i < DXL_DISCOVERY_MAX_EXTRA; i++) {
+		if (report->unexpected_ids[i] == id)
+			return;
+	}
+	if (n < DXL_DISCOVERY_MAX_EXTRA) {
+		report->unexpected_ids[n] = id;
+		report->unexpected_models[n] = model;
+	}
+	report->unexpected_count++;
+}
+
+HAL_StatusTypeDef DXL_Link_Discover(DXL_Discovery_Report_t *report, uint32_t timeout_ms) {
+	// 관절 j = 비트 j, 바퀴 w = 비트 JOINT_COUNT + w
+	const uint32_t all = (1UL << (JOINT_COUNT + LEG_COUNT)) - 1;
+	uint32_t found = 0;
+	uint32_t start = HAL_GetTick();
+
+	memset(report, 0, sizeof(*report));
+
+	do {
+		if (report->rounds++ > 0)
+			HAL_Delay(DXL_DISCOVERY_RETRY_MS);
+
+		// 1. 관절(MX): 브로드캐스트 Ping 1회로 모든 2.0 모터 응답 수집
+		if ((found & ((1UL << JOINT_COUNT) - 1)) != ((1UL << JOINT_COUNT) - 1)) {
+			uint8_t ids[DXL_LINK_MAX_MOTORS + DXL_DISCOVERY_MAX_EXTRA];
+			uint16_t models[DXL_LINK_MAX_MOTORS + DXL_DISCOVERY_MAX_EXTRA];
+			uint8_t n = dxl_broadcast_ping_2_0(robot_joint_ids, JOINT_COUNT, ids, models, sizeof(ids));
+			if (n > sizeof(ids))
+				n = sizeof(ids);
+
+			for (uint8_t i = 0; i < n; i++) {
+				int j = 0;
+				while (j < JOINT_COUNT && robot_joint_ids[j] != ids[i])
+					j++;
+				if (j == JOINT_COUNT)
+					discover_unexpected(report, ids[i], models[i]);
+				else
+					report->mx_found += discover_mark(report, &found, j, ids[i], models[i], robot_joint_model[j]);
+			}
+		}
+
+		// 2. 바퀴(AX): 1.0에는 브로드캐스트 Ping이 없으므로 아직 응답하지 않은 바퀴만 모델 번호 읽기
+		for (int w = 0; w < LEG_COUNT; w++) {
+			uint8_t data[2];
+			if ((found >> (JOINT_COUNT + w)) & 1)
+				continue;
+			if (dxl_read_1_0(robot_wheel_ids[w], DXL_WHEEL_ADDR(MODEL_NUMBER), data, 2) != HAL_OK)
+				continue;
+			report->ax_found += discover_mark(report, &found, JOINT_COUNT + w, robot_wheel_ids[w],
+					data[0] | (data[1] << 8), robot_wheel_model[w]);
+		}
+	} while (found != all && (HAL_GetTick() - start) < timeout_ms);
+
+	report->elapsed_ms = HAL_GetTick() - start;
+
+	for (int k = 0; k < JOINT_COUNT + LEG_COUNT; k++) {
+		if (!((found >> k) & 1))
+			report->missing_ids[report->missing_count++] =
+					(k < JOINT_COUNT) ? robot_joint_ids[k] : robot_wheel_ids[k - JOINT_COUNT];
+	}
+
+	if (report->missing_count)
+		return HAL_TIMEOUT;
+	if (report->mismatch_count || report->unexpected_count)
+		return HAL_ERROR;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef DXL_Link_Wait_Torque(uint8_t on, uint32_t timeout_ms) {
+	int32_t joints[JOINT_COUNT];
+	int32_t wheels[LEG_COUNT];
+	uint32_t start = HAL_GetTick();
+
+	do {
+		uint8_t ok = dxl_sync_read(DXL_JOINT_MODEL, DXL_FIELD_TORQUE_ENABLE, robot_joint_ids, JOINT_COUNT,
+				joints) == HAL_OK
+				&& dxl_sync_read(DXL_WHEEL_MODEL, DXL_FIELD_TORQUE_ENABLE, robot_wheel_ids, LEG_COUNT,
+						wheels) == HAL_OK;
+		for (int j = 0; ok && j < JOINT_COUNT; j++)
+			ok = (joints[j] == on);
+		for (int w = 0; ok && w < LEG_COUNT; w++)
+			ok = (wheels[w] == on);
+		if (ok)
+			return HAL_OK;
+	} while ((HAL_GetTick() - start) < timeout_ms);
+
+	return HAL_TIMEOUT;
+}
+
+HAL_StatusTypeDef DXL_Link_Setup(DXL_Link_Report_t *report, const DXL_Discovery_Report_t *discovery) {
+	uint8_t mx_ids[DXL_LINK_MAX_MOTORS];
+	uint8_t mx_count = 0;
+	uint8_t ax_configured = LEG_COUNT > 0; // 구성 표에 AX-12 바퀴가 있음
+	uint8_t rdt_max = 0;
+	HAL_StatusTypeDef status = HAL_OK;
+
+	memset(report, 0, sizeof(*report));
+
+	// EEPROM 항목은 토크가 꺼져 있어야 쓸 수 있음
+	dxl_torque_set(0, 0, 0);
+	DXL_Bus_Wait_Idle(DXL_BUS_TIMEOUT_MS);
+
+	// 1. 구성 표의 모든 모터 응답 확인 (탐색에서 응답한 모터는 생략, 나머지만 Ping) 및 Return Delay Time 조정
+	for (int j = 0; j < JOINT_COUNT; j++) {
+		uint8_t id = robot_joint_ids[j];
+		if (link_confirmed(discovery, id)) {
+			report->ping_skipped++;
+			if (link_in_list(discovery->mismatch_ids, discovery->mismatch_count, id))
+				report->model_mismatch++;
+		} else {
+			uint16_t model = 0;
+			if (dxl_ping_2_0(id, &model) != HAL_OK) {
+				link_missing(report, id);
+				continue;
+			}
+			if (model != DXL_Model_Get(robot_joint_model[j])->model_number)
+				report->model_mismatch++;
+		}
+		report->mx_found++;
+		mx_ids[mx_count++] = id;
+
+		uint8_t rdt = link_rdt_2_0(report, id);
+		if (rdt > rdt_max)
+			rdt_max = rdt;
+	}
+
+	for (int w = 0; w < LEG_COUNT; w++) {
+		uint8_t id = robot_wheel_ids[w];
+		if (link_confirmed(discovery, id)) {
+			report->ping_skipped++;
+		} else if (dxl_ping_1_0(id) != HAL_OK) {
+			link_missing(report, id);
+			continue;
+		}
+		report->ax_found++;
+
+		uint8_t rdt = link_rdt_1_0(report, id);
+		if (rdt > rdt_max)
+			rdt_max = rdt;
+	}
+
+	if (report->missing_count)
+		status = HAL_ERROR;
+
+	report->rdt_us = rdt_max * 2U;
+	DXL_Sched_Set_Return_Delay(report->rdt_us);
+
+	// 2. 보레이트: 같은 버스의 모든 모터가 지원하는 속도까지만 (AX-12가 있으면 1Mbps 상한)
+	report->max_baud = ax_configured ? DXL_LINK_AX_MAX_BAUD : DXL_LINK_MX_MAX_BAUD;
+	report->capped_by_ax = ax_configured && DXL_LINK_TARGET_BAUD > DXL_LINK_AX_MAX_BAUD;
+
+	uint32_t target = DXL_LINK_TARGET_BAUD;
+	if (target > report->max_baud)
+		target = report->max_baud;
+
+	// (응답하지 않은 모터가 있으면 그 모터만 이전 속도에 남게 되므로 올리지 않음)
+	if (target > DXL_Bus_Get_Baud() && mx_count > 0 && report->missing_count == 0
+			&& mx_baud_index(target) >= 0
+			&& mx_baud_index(DXL_Bus_Get_Baud()) >= 0 && DXL_Bus_Baud_Supported(target)) {
+		if (link_upgrade_baud(report, mx_ids, mx_count, target) != HAL_OK)
+			status = HAL_ERROR;
+	}
+
+	report->baud = DXL_Bus_Get_Baud();
+	DXL_Sched_Replan();
+	return status;
+}
@@ -0,0 +1,111 @@
+/*
+ * dxl_model.c
+ * Description: 다이나믹셀 모델별 컨트롤 테이블 등록부 구현
+ * Note: 표는 const로 플래시에 배치됨. MX-106과 MX-64는 프로토콜 2.0 컨트롤 테이블이 같으므로 같은 표를 공유함
+ *       (관절 Sync Write에 두 모델을 섞어 담을 수 있는 근거)
+ *       AX-12의 Present Speed/Load는 bit10이 방향인 부호-크기 표현이라 부호 확장 대상이 아님
+ * 수정사항: MX Moving Status(123) 추가
+ */
+
+#include "dxl_model.h"
+#include <stddef.h>
+
+// MX-106 / MX-64 (프로토콜 2.0) - e-Manual 컨트롤 테이블 기준
+static const DXL_Field_Info_t mx_2_0_fields[DXL_FIELD_COUNT] = {
+	[DXL_FIELD_MODEL_NUMBER]          = { 0,   2, DXL_ACCESS_R, 1.0f },
+	[DXL_FIELD_BAUD_RATE]             = { 8,   1, DXL_ACCESS_RW | DXL_ACCESS_EEPROM, 1.0f },
+	[DXL_FIELD_RETURN_DELAY_TIME]     = { 9,   1, DXL_ACCESS_RW | DXL_ACCESS_EEPROM, 2.0f },
+	[DXL_FIELD_DRIVE_MODE]            = { 10,  1, DXL_ACCESS_RW | DXL_ACCESS_EEPROM, 1.0f },
+	[DXL_FIELD_TORQUE_ENABLE]         = { 64,  1, DXL_ACCESS_RW, 1.0f },
+	[DXL_FIELD_LED]                   = { 65,  1, DXL_ACCESS_RW, 1.0f },
+	[DXL_FIELD_HARDWARE_ERROR_STATUS] = { 70,  1, DXL_ACCESS_R, 1.0f },
+	[DXL_FIELD_GOAL_CURRENT]          = { 102, 2, DXL_ACCESS_RW | DXL_ACCESS_SIGNED, 3.36f },
+	[DXL_FIELD_GOAL_VELOCITY]         = { 104, 4, DXL_ACCESS_RW | DXL_ACCESS_SIGNED, 0.229f },
+	[DXL_FIELD_PROFILE_ACCELERATION]  = { 108, 4, DXL_ACCESS_RW, 214.577f }, // rev/min^2 (시간 기준이면 ms)
+	[DXL_FIELD_PROFILE_VELOCITY]      = { 112, 4, DXL_ACCESS_RW, 0.229f },   // rpm (시간 기준이면 ms)
+	[DXL_FIELD_GOAL_POSITION]         = { 116, 4, DXL_ACCESS_RW, 0.088f },
+	[DXL_FIELD_MOVING]                = { 122, 1, DXL_ACCESS_R, 1.0f },
+	[DXL_FIELD_MOVING_STATUS]         = { 123, 1, DXL_ACCESS_R, 1.0f },
+	[DXL_FIELD_PRESENT_CURRENT]       = { 126, 2, DXL_ACCESS_R | DXL_ACCESS_SIGNED, 3.36f },
+	[DXL_FIELD_PRESENT_VELOCITY]      = { 128, 4, DXL_ACCESS_R | DXL_ACCESS_SIGNED, 0.229f },
+	[DXL_FIELD_PRESENT_POSITION]      = { 132, 4, DXL_ACCESS_R | DXL_ACCESS_SIGNED, 0.088f },
+	[DXL_FIELD_PRESENT_INPUT_VOLTAGE] = { 144, 2, DXL_ACCESS_R, 0.1f },
+	[DXL_FIELD_PRESENT_TEMPERATURE]   = { 146, 1, DXL_ACCESS_R, 1.0f },
+	[DXL_FIELD_INDIRECT_ADDRESS_1]    = { 168, 2, DXL_ACCESS_RW, 1.0f },
+	[DXL_FIELD_INDIRECT_DATA_1]       = { 224, 1, DXL_ACCESS_RW, 1.0f },
+};
+
+// AX-12 (프로토콜 1.0)
+static const DXL_Field_Info_t ax_1_0_fields[DXL_FIELD_COUNT] = {
+	[DXL_FIELD_MODEL_NUMBER]          = { 0,  2, DXL_ACCESS_R, 1.0f },
+	[DXL_FIELD_BAUD_RATE]             = { 4,  1, DXL_ACCESS_RW | DXL_ACCESS_EEPROM, 1.0f },
+	[DXL_FIELD_RETURN_DELAY_TIME]     = { 5,  1, DXL_ACCESS_RW | DXL_ACCESS_EEPROM, 2.0f },
+	[DXL_FIELD_TORQUE_ENABLE]         = { 24, 1, DXL_ACCESS_RW, 1.0f },
+	[DXL_FIELD_LED]                   = { 25, 1, DXL_ACCESS_RW, 1.0f },
+	[DXL_FIELD_GOAL_POSITION]         = { 30, 2, DXL_ACCESS_RW, 0.29f },
+	[DXL_FIELD_GOAL_VELOCITY]         = { 32, 2, DXL_ACCESS_RW, 0.111f }, // Moving Speed (바퀴 모드: bit10 방향)
+	[DXL_FIELD_PRESENT_POSITION]      = { 36, 2, DXL_ACCESS_R, 0.29f },
+	[DXL_FIELD_PRESENT_VELOCITY]      = { 38, 2, DXL_ACCESS_R, 0.111f },  // Present Speed (bit10 방향)
+	[DXL_FIELD_PRESENT_LOAD]          = { 40, 2, DXL_ACCESS_R, 0.1f },    // bit10 방향
+	[DXL_FIELD_PRESENT_INPUT_VOLTAGE] = { 42, 1, DXL_ACCESS_R, 0.1f },
+	[DXL_FIELD_PRESENT_TEMPERATURE]   = { 43, 1, DXL_ACCESS_R, 1.0f },
+	[DXL_FIELD_MOVING]                = { 46, 1, DXL_ACCESS_R, 1.0f },
+};
+
+static const DXL_Model_Info_t models[DXL_MODEL_COUNT] = {
+	[DXL_MODEL_MX106] = { 321, 2, mx_2_0_fields },
+	[DXL_MODEL_MX64]  = { 311, 2, mx_2_0_fields },
+	[DXL_MODEL_AX12]  = { 12,  1, ax_1_0_fields },
+};
+
+const DXL_Model_Info_t* DXL_Model_Get(DXL_Model_t model) {
+	if ((unsigned) model >= DXL_MODEL_COUNT)
+		return NULL;
+	return &models[model];
+}
+
+const DXL_Field_Info_t* DXL_Model_Field(DXL_Model_t model, DXL_Field_t field) {
+	if ((unsigned) model >= DXL_MODEL_COUNT || (unsigned) field >= DXL_FIELD_COUNT)
+		return NULL;
+	const DXL_Field_Info_t *f = &models[model].fields[field];
+	return (f->size != 0) ? f : NULL;
+}
+
+uint16_t DXL_Model_Addr(DXL_Model_t model, DXL_Field_t field) {
+	const DXL_Field_Info_t *f = DXL_Model_Field(model, field);
+	return (f != NULL) ? f->addr : DXL_ADDR_NONE;
+}
+
+uint8_t DXL_Model_Size(DXL_Model_t model, DXL_Field_t field) {
+	const DXL_Field_Info_t *f = DXL_Model_Field(model, field);
+	return (f != NULL) ? f->size : 0;
+}
+
+DXL_Model_t DXL_Model_From_Number(uint16_t model_number) {
+	for (int m = 0; m < DXL_MODEL_COUNT; m++) {
+		if (models[m].model_number == model_number)
+			return (DXL_Model_t) m;
+	}
+	return DXL_MODEL_COUNT;
+}
+
+int32_t DXL_Model_Decode(const DXL_Field_Info_t *f, const uint8_t *data) {
+	uint32_t v = 0;
+	for (int b = f->size - 1; b >= 0; b--)
+		v = (v << 8) | data[b];
+
+	if ((f->access & DXL_ACCESS_SIGNED) && f->size < 4) {
+		uint32_t sign = 1UL << (f->size * 8 - 1);
+		v = (v ^ sign) - sign; // 부호 확장
+	}
+	return (int32_t) v;
+}
+
+float DXL_Model_To_Unit(const DXL_Field_Info_t *f, int32_t raw) {
+	return (float) raw * f->scale;
+}
+
+int32_t DXL_Model_From_Unit(const DXL_Field_Info_t *f, float value) {
+	float raw = value / f->scale;
+	return (int32_t) (raw < 0.0f ? raw - 0.5f : raw + 0.5f); // 반올림
+}
@@ -0,0 +1,184 @@
+/*
+ * dxl_recovery.c
+ * Description: 관절 모터 하드웨어 오류 자동 복구 구현부
+ * Note: 재부팅하면 RAM 영역(Torque Enable, Indirect Address, 프로파일, 목표 전류)이 기본값으로 돌아감.
+ *       Drive Mode/Operating Mode는 EEPROM이라 유지되므로 다시 쓰지 않음.
+ *       Indirect Address -> 토크 ON 순서로 복원하고, 프로파일/목표 전류/목표 위치는 명령 캐시가
+ *       합류 직후 관절 쓰기 때 다시 송신함 (재부팅 직후 Goal Position = 현재 위치라 토크 ON 시 제자리 유지)
+ */
+
+#include "dxl_recovery.h"
+#include "dxl_2_0.h"
+#include "dxl_cache.h"
+
+#define RECOVERY_NONE 0xFF
+
+static DXL_Recovery_Report_t recovery = { .joint = RECOVERY_NONE };
+static uint8_t recovery_enabled = 0;
+static uint8_t recovery_tries = 0;   // 현재 관절에 보낸 Reboot 수
+static uint8_t recovery_scan = 0;    // 다음 오류 검사 시작 관절 (한 관절만 계속 잡지 않도록 순환)
+static uint32_t recovery_stamp;      // 현재 단계 시작 시각 (HAL_GetTick)
+static uint32_t recovery_profile_ms; // 합류 후 되돌릴 평소 프로파일 (0: 시간 기준 프로파일 아님)
+static uint32_t recovery_accel_ms;
+
+void DXL_Recovery_Init(uint32_t profile_ms, uint32_t accel_ms) {
+	recovery_profile_ms = profile_ms;
+	recovery_accel_ms = accel_ms;
+	recovery_enabled = 1;
+}
+
+const DXL_Recovery_Report_t* DXL_Recovery_Get_Report(void) {
+	return &recovery;
+}
+
+static void recovery_set_state(uint8_t state, uint32_t now) {
+	recovery.state = state;
+	recovery_stamp = now;
+}
+
+// Reboot 송신 (재시도 포함), 요청을 보냈으면 1
+static uint8_t recovery_reboot(uint8_t j, uint32_t now) {
+	recovery.state = DXL_RECOVERY_REBOOT;
+	if (send_joint_reboot(j) != HAL_OK)
+		return 0; // 송신 큐가 가득 참 - 다음 주기에 다시 시도
+	recovery_tries++;
+	recovery.reboots++;
+	recovery_set_state(DXL_RECOVERY_BOOT_WAIT, now);
+	return 1;
+}
+
+// 확인 실패: 횟수가 남아 있으면 다시 Reboot, 아니면 포기 (관절은 제외된 채로 둠)
+static uint8_t recovery_retry(uint8_t j, uint32_t now) {
+	if (recovery_tries < DXL_RECOVERY_MAX_TRIES)
+		return recovery_reboot(j, now);
+
+	recovery.failed++;
+	recovery.disabled |= (uint8_t) (1U << j);
+	recovery.joint = RECOVERY_NONE;
+	recovery_set_state(DXL_RECOVERY_IDLE, now);
+	return 0;
+}
+
+// 오류 관절 찾기: 찾으면 Sync Write/Read에서 빼고 Reboot 송신
+static uint8_t recovery_start(uint32_t now) {
+	uint8_t mask = DXL_Get_Joint_Read_Mask();
+
+	for (uint8_t k = 0; k < JOINT_COUNT; k++) {
+		uint8_t j = (uint8_t) ((recovery_scan + k) % JOINT_COUNT);
+		const DXL_Joint_State_t *s = DXL_Get_Joint_State(j);
+		if (!((mask >> j) & 1) || !s->valid || s->hw_error == 0)
+			continue;
+
+		recovery_scan = (uint8_t) ((j + 1) % JOINT_COUNT);
+		recovery.attempts++;
+		recovery.joint_attempts[j]++;
+		recovery.joint_hw_error[j] = s->hw_error;
+		recovery.joint = j;
+		recovery_tries = 0;
+		DXL_Cache_Set_Joint_Active(j, 0);
+		DXL_Set_Joint_Read_Mask(mask & (uint8_t) ~(1U << j));
+		return recovery_reboot(j, now);
+	}
+	return 0;
+}
+
+// 토크 ON 확인 완료: 상태 읽기와 Sync Write에 다시 포함 (복귀 프로파일로 현재 목표까지 천천히 이동)
+static void recovery_rejoin(uint8_t j, uint32_t now) {
+	DXL_Set_Joint_Read_Mask(DXL_Get_Joint_Read_Mask() | (uint8_t) (1U << j));
+	if (recovery_profile_ms)
+		DXL_Cache_Set_Joint_Profile(j, DXL_RECOVERY_BLEND_MS, DXL_RECOVERY_BLEND_MS / 4);
+	DXL_Cache_Set_Joint_Active(j, 1);
+	recovery.recovered++;
+	recovery_set_state(DXL_RECOVERY_BLEND, now);
+}
+
+// 한 단계 진행, 진단 슬롯에 요청을 넣었으면 1
+static uint8_t recovery_step(uint32_t now) {
+	uint8_t j = recovery.joint;
+	const DXL_Joint_Check_t *c = DXL_Get_Joint_Check(j);
+
+	switch (recovery.state) {
+	case DXL_RECOVERY_IDLE:
+		return recovery_start(now);
+
+	case DXL_RECOVERY_REBOOT:
+		return recovery_reboot(j, now);
+
+	case DXL_RECOVERY_BOOT_WAIT:
+		if (now - recovery_stamp < DXL_RECOVERY_BOOT_MS)
+			return 0; // 부팅 중에는 다른 관절 진단 읽기
+		send_joint_check(j);
+		recovery_set_state(DXL_RECOVERY_PROBE, now);
+		return 1;
+
+	case DXL_RECOVERY_PROBE:
+		if (!c->fresh) {
+			if (now - recovery_stamp >= DXL_RECOVERY_REPLY_MS) {
+				recovery.no_reply++;
+				return recovery_retry(j, now);
+			}
+			return send_joint_check(j) == HAL_OK; // 부팅이 늦어질 수 있으므로 다시 요청
+		}
+		if (c->hw_error != 0) {
+			recovery.still_faulted++;
+			return recovery_retry(j, now);
+		}
+		if (!DXL_Indirect_Is_Ready()) {
+			send_joint_torque(j, 1);
+			recovery_set_state(DXL_RECOVERY_VERIFY, now);
+			return 1;
+		}
+		send_joint_indirect_map(j, 0);
+		recovery_set_state(DXL_RECOVERY_MAP_STATE, now);
+		return 1;
+
+	case DXL_RECOVERY_MAP_STATE:
+		send_joint_indirect_map(j, 1);
+		recovery_set_state(DXL_RECOVERY_TORQUE, now);
+		return 1;
+
+	case DXL_RECOVERY_TORQUE:
+		send_joint_torque(j, 1);
+		recovery_set_state(DXL_RECOVERY_VERIFY, now);
+		return 1;
+
+	case DXL_RECOVERY_VERIFY:
+		send_joint_check(j);
+		recovery_set_state(DXL_RECOVERY_CONFIRM, now);
+		return 1;
+
+	case DXL_RECOVERY_CONFIRM:
+		if (!c->fresh) {
+			if (now - recovery_stamp < DXL_RECOVERY_REPLY_MS)
+				return 0;
+			recovery.no_reply++;
+			return recovery_retry(j, now);
+		}
+		if (c->torque != 1 || c->hw_error != 0 || c->write_error) {
+			recovery.verify_failed++;
+			return recovery_retry(j, now);
+		}
+		recovery_rejoin(j, now);
+		return 0;
+
+	case DXL_RECOVERY_BLEND:
+		if (recovery_profile_ms && now - recovery_stamp < DXL_RECOVERY_BLEND_MS)
+			return 0;
+		if (recovery_profile_ms)
+			DXL_Cache_Set_Joint_Profile(j, recovery_profile_ms, recovery_accel_ms);
+		recovery.joint = RECOVERY_NONE;
+		recovery_set_state(DXL_RECOVERY_IDLE, now);
+		return 0;
+
+	default:
+		recovery.joint = RECOVERY_NONE;
+		recovery_set_state(DXL_RECOVERY_IDLE, now);
+		return 0;
+	}
+}
+
+void DXL_Recovery_Slot(void) {
+	if (recovery_enabled && recovery_step(HAL_GetTick()))
+		return;
+	send_diag_read_next();
+}
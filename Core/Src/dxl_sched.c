@@ -0,0 +1,200 @@
+/*
+ * dxl_sched.c
+ * Description: 다이나믹셀 버스 시간 분할 스케줄러 구현부
+ * Note: 선로 시간 모델 = 송신 바이트 x 10비트 / 보레이트
+ *                      + 응답 수 x Return Delay Time + 응답 바이트 x 10비트 / 보레이트 + 여유
+ *       시각 기준은 DWT 사이클 카운터 (SysTick 1ms 해상도로는 슬롯을 나눌 수 없음, main.c의 DWT_Cycle_Init에서 활성화)
+ * 수정사항: 대기 중 콜백 호출 (상태 패킷을 도착 직후 해석하여 응답 지연 측정)
+ * 수정사항: 주기 대기 중 남는 버스 시간에 채움 슬롯 실행 (들어가지 않으면 다음 주기로 미룸)
+ */
+
+#include "dxl_sched.h"
+#include "dxl_bus.h"
+#include <string.h>
+
+static DXL_Sched_Slot_t sched_slots[DXL_SLOT_COUNT];
+static DXL_Sched_Report_t sched_report = { .period_us = DXL_SCHED_PERIOD_US, .active_us =
+		DXL_SCHED_PERIOD_US, .rdt_us = DXL_SCHED_RDT_US };
+
+static uint32_t sched_cycles_per_us = 1;
+static uint32_t sched_period_start;    // 현재 주기 시작 시각 (DWT 사이클)
+static uint8_t sched_period_valid = 0; // 0: 아직 첫 주기 시작 전
+static DXL_Slot_Fn sched_idle_fn = NULL; // 대기 중 반복 호출
+static DXL_Slot_Fn sched_fill_fn = NULL;       // 남는 버스 시간에 호출
+static DXL_Slot_Cost_Fn sched_fill_cost = NULL;
+static uint32_t sched_bus_end;         // 이번 주기 고정 슬롯의 선로 시간이 끝나는 시각 (DWT 사이클)
+static uint8_t sched_bus_valid = 0;    // 1: DXL_Sched_Run 이후 채움 슬롯을 아직 검토하지 않음
+
+// 지정 시각(DWT 사이클)까지 대기
+static void sched_wait_until(uint32_t target) {
+	while ((int32_t) (DWT->CYCCNT - target) < 0) {
+		if (sched_idle_fn)
+			sched_idle_fn();
+	}
+}
+
+void DXL_Sched_Set_Idle_Callback(DXL_Slot_Fn fn) {
+	sched_idle_fn = fn;
+}
+
+uint32_t DXL_Sched_Wire_Us(uint32_t bytes, uint32_t baud) {
+	if (baud == 0)
+		return 0;
+	return (uint32_t) (((uint64_t) bytes * 10U * 1000000U + baud - 1) / baud); // 올림
+}
+
+void DXL_Sched_Set_Fill(DXL_Slot_Fn fn, DXL_Slot_Cost_Fn cost_fn) {
+	sched_fill_fn = fn;
+	sched_fill_cost = cost_fn;
+}
+
+// 슬롯 비용 -> 선로 점유 시간 (송신 + 응답 지연 + 응답 + 여유)
+static uint32_t sched_cost_us(const DXL_Frame_Cost_t *c, uint32_t baud) {
+	if (c->tx_bytes == 0)
+		return 0;
+	return DXL_Sched_Wire_Us(c->tx_bytes, baud) + c->replies * sched_report.rdt_us
+			+ DXL_Sched_Wire_Us(c->rx_bytes, baud) + DXL_SCHED_GUARD_US;
+}
+
+void DXL_Sched_Config_Slot(DXL_Slot_t slot, DXL_Slot_Fn fn, DXL_Slot_Cost_Fn cost_fn) {
+	if (slot >= DXL_SLOT_COUNT)
+		return;
+	sched_slots[slot].fn = fn;
+	sched_slots[slot].cost_fn = cost_fn;
+}
+
+HAL_StatusTypeDef DXL_Sched_Replan(void) {
+	uint32_t baud = DXL_Bus_Get_Baud();
+	uint32_t offset = 0;
+
+	for (int i = 0; i < DXL_SLOT_COUNT; i++) {
+		DXL_Sched_Slot_t *s = &sched_slots[i];
+
+		if (s->fn && s->cost_fn)
+			s->cost = s->cost_fn();
+		else
+			memset(&s->cost, 0, sizeof(s->cost));
+
+		s->wire_us = sched_cost_us(&s->cost, baud);
+		s->offset_us = offset;
+		offset += s->wire_us;
+	}
+
+	sched_report.baud = baud;
+	sched_report.bus_us = offset;
+
+	// 예산 초과: 마감을 조용히 놓치지 않도록 주기를 필요한 만큼 늘려서 적용하고 보고
+	uint32_t need = DXL_SCHED_COMPUTE_US + offset;
+	if (need > sched_report.period_us) {
+		sched_report.over_us = need - sched_report.period_us;
+		sched_report.active_us = need;
+		return HAL_ERROR;
+	}
+
+	sched_report.over_us = 0;
+	sched_report.active_us = sched_report.period_us;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef DXL_Sched_Init(uint32_t period_us) {
+	sched_cycles_per_us = SystemCoreClock / 1000000U;
+	sched_report.period_us = period_us;
+	sched_period_valid = 0;
+
+	return DXL_Sched_Replan();
+}
+
+HAL_StatusTypeDef DXL_Sched_Set_Return_Delay(uint32_t rdt_us) {
+	sched_report.rdt_us = rdt_us;
+	return DXL_Sched_Replan();
+}
+
+// 고정 슬롯이 끝난 뒤 next(다음 주기 시작)까지 남은 시간에 채움 슬롯이 들어가면 실행
+static void sched_fill(uint32_t next) {
+	if (!sched_bus_valid)
+		return;
+	sched_bus_valid = 0;
+	if (!sched_fill_fn || !sched_fill_cost)
+		return;
+
+	// 마지막 슬롯의 응답이 끝날 때까지 대기 (대기 콜백이 응답을 해석)
+	sched_wait_until(sched_bus_end);
+	int32_t left = (int32_t) (next - DWT->CYCCNT);
+	uint32_t avail = (left > 0) ? (uint32_t) left / sched_cycles_per_us : 0;
+	sched_report.fill_us = avail;
+
+	DXL_Frame_Cost_t c = sched_fill_cost();
+	uint32_t need = sched_cost_us(&c, sched_report.baud);
+	if (need == 0)
+		return; // 보낼 요청 없음
+	if (need > avail) {
+		sched_report.fill_deferred++;
+		return;
+	}
+	sched_fill_fn();
+	DXL_Bus_Flush();
+	sched_report.fill_runs++;
+}
+
+void DXL_Sched_Wait_Period(void) {
+	uint32_t now = DWT->CYCCNT;
+
+	if (!sched_period_valid) {
+		sched_period_start = now;
+		sched_period_valid = 1;
+		return;
+	}
+
+	uint32_t next = sched_period_start + sched_report.active_us * sched_cycles_per_us;
+	if ((int32_t) (now - next) > 0) {
+		// 이번 주기의 연산이 너무 길었음: 밀린 주기를 몰아서 실행하지 않고 지금부터 다시 시작
+		sched_report.late_cycles++;
+		sched_bus_valid = 0;
+		sched_period_start = now;
+	} else {
+		sched_fill(next);
+		sched_wait_until(next);
+		sched_period_start = next;
+	}
+	sched_report.cycles++;
+}
+
+void DXL_Sched_Run(void) {
+	// 읽기 방식 전환(Fast -> 일반 Sync Read) 등으로 슬롯 비용이 바뀌었으면 다시 계산
+	for (int i = 0; i < DXL_SLOT_COUNT; i++) {
+		DXL_Sched_Slot_t *s = &sched_slots[i];
+		if (!s->fn || !s->cost_fn)
+			continue;
+
+		DXL_Frame_Cost_t c = s->cost_fn();
+		if (c.tx_bytes != s->cost.tx_bytes || c.rx_bytes != s->cost.rx_bytes
+				|| c.replies != s->cost.replies) {
+			sched_report.replans++;
+			DXL_Sched_Replan();
+			break;
+		}
+	}
+
+	uint32_t t0 = DWT->CYCCNT;
+	for (int i = 0; i < DXL_SLOT_COUNT; i++) {
+		DXL_Sched_Slot_t *s = &sched_slots[i];
+		if (!s->fn)
+			continue;
+
+		sched_wait_until(t0 + s->offset_us * sched_cycles_per_us);
+		s->fn();
+		DXL_Bus_Flush();
+	}
+	sched_bus_end = t0 + sched_report.bus_us * sched_cycles_per_us;
+	sched_bus_valid = 1;
+}
+
+const DXL_Sched_Report_t* DXL_Sched_Get_Report(void) {
+	return &sched_report;
+}
+
+const DXL_Sched_Slot_t* DXL_Sched_Get_Slot(DXL_Slot_t slot) {
+	if (slot >= DXL_SLOT_COUNT)
+		return NULL;
+	return &sched_slots[slot];
+}
@@ -0,0 +1,223 @@
+/*
+ * dxl_status.c
+ * Description: 다이나믹셀 프로토콜 2.0 상태 패킷 스트리밍 디코더 구현부
+ * 패킷 구조: FF FF FD 00 | ID | LEN_L LEN_H | INST(0x55) | ERR | PARAM... | CRC_L CRC_H
+ * Note: 송신 측은 INST ~ PARAM 구간에 FF FF FD가 나오면 뒤에 FD를 하나 끼워 넣음 (바이트 스터핑).
+ *       LEN과 CRC는 스터핑된 상태 기준이므로, CRC는 받은 그대로 계산하고 파라미터에서만 FD를 제거함.
+ *       따라서 본문에서 FF FF FD 다음에 FD가 아닌 바이트가 오면 새 헤더이며, 앞 프레임은 끊긴 것임
+ * 수정사항: 마지막 파라미터와 CRC 사이에서 구간이 끊기면 params가 지난 구간을 가리키던 문제 수정 (내부 버퍼로 복사)
+ */
+
+#include "dxl_status.h"
+#include "dxl_crc.h"
+#include <string.h>
+
+// 디코더 상태
+enum {
+	ST_HEADER = 0, // FF FF FD 00 탐색
+	ST_ID,
+	ST_LEN_L,
+	ST_LEN_H,
+	ST_INST,
+	ST_ERR,
+	ST_PARAM,
+	ST_SKIP,       // 상태 패킷이 아닌 프레임 (CRC 포함 길이만큼 건너뜀)
+	ST_CRC_L,
+	ST_CRC_H
+};
+
+static const uint8_t status_header[4] = { 0xFF, 0xFF, 0xFD, 0x00 };
+
+// 헤더 일치 후 새 프레임 시작 (헤더 4바이트의 CRC부터 누적)
+static void status_begin(DXL_Status_Parser_t *parser) {
+	parser->state = ST_ID;
+	parser->hdr = 0;
+	parser->stuff = 0;
+	parser->crc = DXL_CRC_Update(0, status_header, 4);
+}
+
+// 무복사 모드 종료: 지금까지의 파라미터를 내부 버퍼로 옮김
+static void status_materialize(DXL_Status_Parser_t *parser) {
+	if (parser->param_len)
+		memcpy(parser->params, parser->zc, parser->param_len);
+	parser->zc = NULL;
+	parser->copy = 1;
+}
+
+void DXL_Status_Reset(DXL_Status_Parser_t *parser) {
+	parser->state = ST_HEADER;
+	parser->hdr = 0;
+	parser->stuff = 0;
+	parser->zc = NULL;
+}
+
+void DXL_Status_Init(DXL_Status_Parser_t *parser) {
+	memset(parser, 0, sizeof(*parser));
+	DXL_Status_Reset(parser);
+}
+
+uint8_t DXL_Status_Parse(DXL_Status_Parser_t *parser, const uint8_t *data, uint16_t len,
+		uint16_t *used, DXL_Status_Packet_t *out) {
+	// CRC는 바이트마다 갱신하지 않고, 아직 반영하지 않은 연속 구간의 시작만 기억했다가 한 번에 계산
+	const uint8_t *run = (parser->state >= ST_ID && parser->state <= ST_PARAM) ? data : NULL;
+
+	for (uint16_t i = 0; i < len; i++) {
+		uint8_t b = data[i];
+
+		// 본문(INST ~ PARAM, 건너뛰는 프레임은 CRC 제외)에서 FF FF FD 추적
+		if ((parser->state >= ST_INST && parser->state <= ST_PARAM)
+				|| (parser->state == ST_SKIP && parser->remain > 2)) {
+			if (parser->stuff == 3) {
+				parser->stuff = 0;
+				if (b == 0xFD) {
+					// 스터핑 바이트: 길이와 CRC에는 포함되지만 파라미터에서는 제거
+					parser->unstuffed++;
+					if (parser->state == ST_PARAM && !parser->copy)
+						status_materialize(parser);
+					if (--parser->remain == 0)
+						parser->state = ST_CRC_L;
+					continue;
+				}
+
+				// 새 헤더 등장: 앞 프레임을 버리고 동기를 다시 잡음
+				parser->resyncs++;
+				if (b == 0x00) {
+					status_begin(parser);
+					run = &data[i + 1];
+				} else {
+					parser->state = ST_HEADER;
+					parser->hdr = (b == 0xFF);
+					run = NULL;
+				}
+				continue;
+			}
+			if (b == 0xFF)
+				parser->stuff = parser->stuff ? 2 : 1;
+			else
+				parser->stuff = (parser->stuff == 2 && b == 0xFD) ? 3 : 0;
+		}
+
+		switch (parser->state) {
+		case ST_HEADER:
+			if (b == status_header[parser->hdr]) {
+				if (++parser->hdr == 4) {
+					status_begin(parser);
+					run = &data[i + 1];
+				}
+			} else {
+				// FF FF FF FD 처럼 FF가 더 이어지는 경우도 헤더로 인정
+				parser->dropped++;
+				parser->hdr = (b == 0xFF) ? ((parser->hdr == 2) ? 2 : 1) : 0;
+			}
+			break;
+
+		case ST_ID:
+			parser->id = b;
+			parser->state = ST_LEN_L;
+			break;
+
+		case ST_LEN_L:
+			parser->remain = b;
+			parser->state = ST_LEN_H;
+			break;
+
+		case ST_LEN_H:
+			parser->remain |= (uint16_t) b << 8;
+			if (parser->remain < 3 || parser->remain > DXL_STATUS_MAX_PARAMS + 4) {
+				// 최소 INST + CRC, 최대 INST + ERR + 파라미터 버퍼 + CRC
+				// (헤더 직후 프레임이 끊겨 다음 헤더의 FF FF를 길이로 읽은 경우도 여기서 걸러짐)
+				if (parser->remain < 3)
+					parser->resyncs++;
+				else
+					parser->oversize++;
+				parser->state = ST_HEADER;
+				run = NULL;
+				break;
+			}
+			parser->remain -= 2; // 이후 remain = CRC를 제외한 본문 길이
+			parser->state = ST_INST;
+			break;
+
+		case ST_INST:
+			parser->remain--;
+			if (b != DXL_INST_STATUS) {
+				// 반이중 선로에서 되돌아온 송신 프레임 등: CRC까지 길이만큼 건너뜀
+				parser->echoes++;
+				parser->remain += 2;
+				parser->state = ST_SKIP;
+				run = NULL;
+			} else if (parser->remain == 0) { // Error 필드 없음
+				parser->resyncs++;
+				parser->state = ST_HEADER;
+				run = NULL;
+			} else {
+				parser->state = ST_ERR;
+			}
+			break;
+
+		case ST_ERR:
+			parser->error = b;
+			parser->param_len = 0;
+			parser->copy = 0;
+			parser->zc = NULL;
+			parser->state = (--parser->remain) ? ST_PARAM : ST_CRC_L;
+			break;
+
+		case ST_PARAM:
+			if (!parser->copy) {
+				if (!parser->zc)
+					parser->zc = &data[i];
+				parser->param_len++;
+			} else {
+				parser->params[parser->param_len++] = b;
+			}
+			if (--parser->remain == 0)
+				parser->state = ST_CRC_L;
+			break;
+
+		case ST_SKIP:
+			if (--parser->remain == 0)
+				parser->state = ST_HEADER;
+			break;
+
+		case ST_CRC_L:
+			if (run) {
+				parser->crc = DXL_CRC_Update(parser->crc, run, &data[i] - run);
+				run = NULL;
+			}
+			parser->crc_rx = b;
+			parser->state = ST_CRC_H;
+			break;
+
+		case ST_CRC_H:
+			parser->state = ST_HEADER;
+			if ((uint16_t) (parser->crc_rx | (b << 8)) != parser->crc) {
+				parser->crc_errors++;
+				parser->crc_error_id = parser->id;
+				break;
+			}
+
+			parser->packets++;
+			out->id = parser->id;
+			out->error = parser->error;
+			out->params = parser->copy ? parser->params : parser->zc;
+			out->param_len = parser->param_len;
+			*used = i + 1;
+			return 1;
+
+		default:
+			DXL_Status_Reset(parser);
+			break;
+		}
+	}
+
+	// 구간 끝: 남은 CRC를 반영하고, 파라미터나 CRC가 다음 구간으로 이어지면 내부 버퍼로 옮김
+	// (파라미터 직후에서 끊겨도 패킷은 다음 구간에서 완성되므로 이번 구간을 가리키면 안 됨)
+	if (run)
+		parser->crc = DXL_CRC_Update(parser->crc, run, &data[len] - run);
+	if (parser->state >= ST_PARAM && parser->state != ST_SKIP && !parser->copy)
+		status_materialize(parser);
+
+	*used = len;
+	return 0;
+}
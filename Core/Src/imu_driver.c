@@ -2,79 +2,382 @@
  * imu_driver.c
  * Description: IMU 센서 데이터 파싱 및 링버퍼 처리 구현체 (수정본)
  * Note: 인터럽트 부하를 줄이기 위해 파싱 로직을 메인 루프로 이동시킴
+ * 수정사항: 버퍼 전체 memcpy 제거 - DMA 남은 개수(NDTR)로 쓰기 위치를 구해 새 바이트만 훑고,
+ *           완성된 프레임은 링 안에서 바로 파싱 (링 끝을 걸친 프레임만 복사), 파싱 중 덮어쓰기 검출
+ * 수정사항: strtof(newlib) 대신 길이 기반 EBIMU 파서 사용 - NUL 종료 불필요, 필드별 형식 오류 기록
+ * 수정사항: 초기화 시 바이너리 출력 설정 명령 송신, "<ok>" 응답 바이트에서 바로 바이너리 프레임 추적으로 전환
+ *           (응답이 없으면 ASCII 유지), 바이너리는 고정 길이 프레임을 체크섬 검증 후 디코딩
+ * 수정사항: 부팅 시 후보 보레이트를 차례로 시도해 센서 보레이트 탐지, 921600bps/출력 주기 설정 후
+ *           USART2를 맞춰 재설정 (확인 실패 시 재탐지), 수신 프레임 속도 측정
+ * 수정사항: 한 바퀴에 응답이 없으면 IMU_BOOT_TIMEOUT_MS까지 후보 전체를 다시 시도 (센서 부팅이 MCU보다 느린 경우)
  */
 #include "imu_driver.h"
-#include <stdio.h>
+#include "imu_ebimu.h"
 #include <string.h>
-#include <stdlib.h>
 
-#define IMU_BUF_SIZE 128
+#define IMU_RING_MASK (IMU_RING_SIZE - 1)
 
 UART_HandleTypeDef *imu_uart;
-uint8_t imu_rx_buf[IMU_BUF_SIZE]; // DMA가 직접 채우는 수신 버퍼
+static uint8_t imu_ring[IMU_RING_SIZE]; // DMA가 직접 채우는 수신 링 (Circular)
 
-// 파싱을 위해 데이터를 잠시 복사해둘 버퍼와 플래그
-char imu_parsing_buf[IMU_BUF_SIZE];
-volatile uint8_t imu_data_ready = 0; // 1이면 새로운 데이터가 왔다는 뜻
+// 다음에 훑을 바이트의 누적 번호 (링 인덱스 = imu_rx_pos & IMU_RING_MASK)
+// 프레임 위치도 누적 번호로 기록 -> 파싱 도중 DMA가 한 바퀴 돌았는지는 누적 번호 차이로 판단
+static uint32_t imu_rx_pos = 0;
+static uint8_t imu_in_frame = 0;   // 프레임 시작('*' 또는 SOP 2바이트)을 받고 끝을 기다리는 중
+static uint32_t imu_frame_start;   // 현재 프레임 첫 바이트의 누적 번호
+static uint8_t imu_sop_count = 0;  // 바이너리: 연속으로 받은 SOP 바이트 수
 
+// 출력 형식과 설정 명령 응답 추적 (모드 전환은 "<ok>" 마지막 바이트에서 ISR이 수행 -> 그 뒤 바이트부터 바이너리)
+static volatile uint8_t imu_mode = IMU_MODE_ASCII;
+static volatile uint8_t imu_switch_binary = 0; // 1: 다음 "<ok>"에서 바이너리로 전환
+static volatile uint8_t imu_acked = 0;         // "<ok>" 수신
+static uint8_t imu_ack_pos = 0;                // "<ok>" 중 맞춘 글자 수
+
+// ISR이 메인 루프에 넘기는 최신 완성 프레임 (첫 바이트 누적 번호, 길이, 형식)
+// ASCII: '*'부터 줄바꿈 직전까지, 바이너리: SOP부터 체크섬까지 EBIMU_BIN_FRAME_LEN
+static volatile uint8_t imu_frame_ready = 0;
+static uint32_t imu_ready_start;
+static uint16_t imu_ready_len;
+static uint8_t imu_ready_mode;
+
+static uint8_t imu_wrap_buf[IMU_FRAME_MAX]; // 링 끝을 걸친 프레임만 이어 붙여 파싱
+
+static IMU_Stats_t imu_stats = { 0, };
 IMU_Data_t current_imu_data = { 0, };
 
-// IMU 초기화 및 DMA Circular 수신 모드 시작
-void IMU_Init(UART_HandleTypeDef *huart) {
+// 링 수신 (재)시작 - 진행 중이던 프레임은 버림
+// DMA는 링 처음부터 다시 쓰므로 누적 번호를 다음 바퀴 경계로 맞추고 한 바퀴를 더 건너뜀
+// (메인 루프가 파싱 중이던 재시작 전 프레임은 덮어쓰기 검사에서 걸러짐)
+static void imu_start_rx(void) {
+	imu_rx_pos = ((imu_rx_pos + IMU_RING_MASK) & ~(uint32_t) IMU_RING_MASK) + IMU_RING_SIZE;
+	imu_frame_ready = 0;
+	imu_in_frame = 0;
+	imu_sop_count = 0;
+	HAL_UART_Receive_DMA(imu_uart, imu_ring, IMU_RING_SIZE);
+}
+
+// DMA 쓰기 위치 (링 인덱스)
+static uint16_t imu_rx_head(void) {
+	uint16_t head = IMU_RING_SIZE - (uint16_t) __HAL_DMA_GET_COUNTER(imu_uart->hdmarx);
+	return (head >= IMU_RING_SIZE) ? 0 : head;
+}
+
+// 완성 프레임을 메인 루프에 넘김 (아직 안 가져간 프레임은 더 새 프레임으로 교체)
+static void imu_publish(uint32_t start, uint16_t len) {
+	imu_stats.frames++;
+	if (imu_frame_ready)
+		imu_stats.skipped++;
+	imu_ready_start = start;
+	imu_ready_len = len;
+	imu_ready_mode = imu_mode;
+	imu_frame_ready = 1;
+}
+
+// ASCII 바이트 1개: '*' ~ CR/LF 프레임 경계와 설정 명령 응답("<ok>") 추적
+static void imu_scan_ascii(uint8_t c, uint32_t pos) {
+	if (c == (uint8_t) EBIMU_ACK[imu_ack_pos]) {
+		if (++imu_ack_pos == sizeof(EBIMU_ACK) - 1) {
+			imu_ack_pos = 0;
+			imu_acked = 1;
+			if (imu_switch_binary) {
+				// 응답 직후부터 바이너리 출력 -> 진행 중이던 ASCII 프레임은 버림
+				imu_switch_binary = 0;
+				imu_mode = IMU_MODE_BINARY;
+				imu_stats.mode = IMU_MODE_BINARY;
+				imu_in_frame = 0;
+				imu_sop_count = 0;
+				return;
+			}
+		}
+	} else {
+		imu_ack_pos = (c == (uint8_t) EBIMU_ACK[0]);
+	}
+
+	if (c == '*') {
+		// 프레임 시작 (이전 프레임이 줄바꿈 없이 끊겼으면 여기서 재동기화)
+		imu_in_frame = 1;
+		imu_frame_start = pos;
+		return;
+	}
+	if (!imu_in_frame)
+		return;
+
+	uint32_t len = pos - imu_frame_start;
+	if (c == '\r' || c == '\n') {
+		imu_in_frame = 0;
+		imu_publish(imu_frame_start, (uint16_t) len);
+	} else if (len >= IMU_FRAME_MAX) {
+		imu_in_frame = 0;
+		imu_stats.oversize++;
+	}
+}
+
+// 바이너리 바이트 1개: SOP 2바이트 이후 고정 길이만큼 받으면 프레임 완성 (체크섬은 메인 루프에서 검증)
+static void imu_scan_binary(uint8_t c, uint32_t pos) {
+	if (!imu_in_frame) {
+		if (c != EBIMU_BIN_SOP) {
+			imu_sop_count = 0;
+		} else if (++imu_sop_count == 2) {
+			imu_sop_count = 0;
+			imu_in_frame = 1;
+			imu_frame_start = pos - 1;
+		}
+		return;
+	}
+	if (pos - imu_frame_start == 2 && c == EBIMU_BIN_SOP) {
+		// SOP가 3번 이상 이어짐 -> 앞의 것은 잡음 (roll 상위 바이트 0x55는 218도 이상이라 정상 값이 아님)
+		imu_frame_start++;
+		return;
+	}
+	if (pos - imu_frame_start == EBIMU_BIN_FRAME_LEN - 1) {
+		imu_in_frame = 0;
+		imu_publish(imu_frame_start, EBIMU_BIN_FRAME_LEN);
+	}
+}
+
+// 지난 호출 이후 새로 들어온 바이트만 훑어 프레임 경계를 찾음
+// (인터럽트 또는 인터럽트 금지 구간에서만 호출, DMA 절반/완료 인터럽트로 한 바퀴 안에 반드시 호출됨)
+static void imu_scan(void) {
+	uint16_t head = imu_rx_head();
+	uint16_t n = (uint16_t) ((head - imu_rx_pos) & IMU_RING_MASK);
+
+	if (n > imu_stats.max_chunk)
+		imu_stats.max_chunk = n;
+
+	while (n--) {
+		uint32_t pos = imu_rx_pos++;
+		uint8_t c = imu_ring[pos & IMU_RING_MASK];
+		imu_stats.rx_bytes++;
+
+		if (imu_mode == IMU_MODE_BINARY)
+			imu_scan_binary(c, pos);
+		else
+			imu_scan_ascii(c, pos);
+	}
+}
+
+// 메인 루프용: 인터럽트를 잠시 막고 훑기 (ISR과 같은 상태를 건드리므로)
+static void imu_scan_locked(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	imu_scan();
+	__set_PRIMASK(primask);
+}
+
+// 설정 명령 1개 송신 후 "<ok>" 응답 대기 (binary: 1이면 응답 바이트에서 바이너리 추적으로 전환)
+static HAL_StatusTypeDef imu_send_command(const char *cmd, uint8_t binary) {
+	imu_scan_locked();
+	imu_acked = 0;
+	imu_switch_binary = binary;
+
+	if (HAL_UART_Transmit(imu_uart, (const uint8_t*) cmd, (uint16_t) strlen(cmd), IMU_ACK_TIMEOUT_MS) != HAL_OK) {
+		imu_switch_binary = 0;
+		return HAL_ERROR;
+	}
+
+	uint32_t start = HAL_GetTick();
+	while (!imu_acked && (HAL_GetTick() - start) < IMU_ACK_TIMEOUT_MS)
+		imu_scan_locked(); // 응답 뒤 IDLE 전에도 바로 확인
+	imu_switch_binary = 0;
+	return imu_acked ? HAL_OK : HAL_TIMEOUT;
+}
+
+// USART2 보레이트 변경 후 링 수신 재시작 (오버샘플링은 분주비에 맞춰 선택, 핀/DMA 설정은 유지)
+static HAL_StatusTypeDef imu_set_baud(uint32_t baud) {
+	HAL_UART_Abort(imu_uart); // RX DMA 정지
+
+	imu_uart->Init.BaudRate = baud;
+	imu_uart->Init.OverSampling = (HAL_RCC_GetPCLK1Freq() / baud >= 16) ? UART_OVERSAMPLING_16 : UART_OVERSAMPLING_8;
+	if (HAL_UART_Init(imu_uart) != HAL_OK)
+		return HAL_ERROR;
+
+	__HAL_UART_ENABLE_IT(imu_uart, UART_IT_IDLE);
+	imu_stats.baud = baud;
+	imu_start_rx();
+	return HAL_OK;
+}
+
+// 센서 보레이트 탐지: 후보마다 출력 항목 설정 명령(<sof1>)을 보내 "<ok>"가 오는 보레이트를 찾음
+// (목표 보레이트 -> 공장 설정 -> 나머지 빠른 순, 응답이 없으면 0)
+// 한 바퀴(최대 약 0.8초)에 응답이 없으면 리셋 후 deadline_ms가 지날 때까지 반복 (최소 1바퀴)
+static uint32_t imu_detect_baud(uint32_t deadline_ms) {
+	uint32_t candidates[EBIMU_BAUD_COUNT];
+	uint8_t count = 0;
+
+	candidates[count++] = IMU_BAUD_TARGET;
+	candidates[count++] = EBIMU_BAUD_DEFAULT;
+	for (uint8_t code = EBIMU_BAUD_COUNT; code >= 1; code--) {
+		uint32_t baud = EBIMU_Baud_Of_Code(code);
+		if (baud != IMU_BAUD_TARGET && baud != EBIMU_BAUD_DEFAULT)
+			candidates[count++] = baud;
+	}
+
+	do {
+		imu_stats.detect_sweeps++;
+		for (uint8_t i = 0; i < count; i++) {
+			if (imu_set_baud(candidates[i]) == HAL_OK && imu_send_command(EBIMU_CMD_EULER, 0) == HAL_OK)
+				return candidates[i];
+		}
+	} while (HAL_GetTick() < deadline_ms);
+	return 0;
+}
+
+// 수신 프레임 속도 측정 (IMU_RATE_WINDOW_MS마다 갱신)
+static uint32_t imu_rate_tick;
+static uint32_t imu_rate_frames;
+
+static void imu_measure_rate(void) {
+	uint32_t now = HAL_GetTick();
+	uint32_t elapsed = now - imu_rate_tick;
+	if (elapsed < IMU_RATE_WINDOW_MS)
+		return;
+
+	uint32_t frames = imu_stats.frames;
+	imu_stats.frame_hz = (uint16_t) ((frames - imu_rate_frames) * 1000U / elapsed);
+	imu_rate_tick = now;
+	imu_rate_frames = frames;
+}
+
+// IMU 초기화: DMA Circular 수신 시작 -> 보레이트 탐지 -> 목표 보레이트/출력 주기/바이너리 출력 설정
+HAL_StatusTypeDef IMU_Init(UART_HandleTypeDef *huart) {
+	HAL_StatusTypeDef status = HAL_OK;
+	char cmd[EBIMU_CMD_MAX];
+
 	imu_uart = huart;
+	imu_mode = IMU_MODE_ASCII;
+	imu_stats.mode = IMU_MODE_ASCII;
+	imu_stats.baud = imu_uart->Init.BaudRate;
 
 	// UART IDLE 라인 감지 인터럽트 활성화
 	__HAL_UART_ENABLE_IT(imu_uart, UART_IT_IDLE);
 
-	// DMA Circular 모드를 통한 연속 데이터 수신 시작
-	HAL_UART_Receive_DMA(imu_uart, imu_rx_buf, IMU_BUF_SIZE);
+	// DMA Circular 모드를 통한 연속 데이터 수신 시작 (절반/완료 인터럽트도 함께 켜짐)
+	imu_start_rx();
+
+	// 1. 현재 센서 보레이트 탐지 (탐지 명령이 출력 항목을 오일러 각으로 맞춤)
+	// 센서가 부팅 중이면 IMU_BOOT_TIMEOUT_MS까지 반복, 끝내 응답이 없으면 공장 설정 보레이트에서 ASCII 프레임을 계속 파싱
+	uint32_t found = imu_detect_baud(IMU_BOOT_TIMEOUT_MS);
+	imu_stats.detected_baud = found;
+	if (found == 0) {
+		imu_set_baud(EBIMU_BAUD_DEFAULT);
+		status = HAL_TIMEOUT;
+	}
+
+	// 2. 목표 보레이트로 전환: 응답은 기존 보레이트로 온 뒤 센서가 바뀜 -> USART2를 맞추고 다시 응답 확인
+	// 확인되지 않으면 센서 보레이트를 다시 탐지하여 그 보레이트로 계속
+	if (status == HAL_OK && found != IMU_BAUD_TARGET) {
+		EBIMU_Format_Command(cmd, "sb", EBIMU_Baud_Code(IMU_BAUD_TARGET));
+		if (imu_send_command(cmd, 0) != HAL_OK || imu_set_baud(IMU_BAUD_TARGET) != HAL_OK
+				|| imu_send_command(EBIMU_CMD_EULER, 0) != HAL_OK) {
+			imu_stats.baud_fallback = 1;
+			status = HAL_ERROR;
+			if (imu_detect_baud(0) == 0) { // 센서는 이미 응답했으므로 1바퀴만
+				imu_set_baud(EBIMU_BAUD_DEFAULT);
+				status = HAL_TIMEOUT;
+			}
+		}
+	}
+
+	// 3. 출력 주기와 바이너리 출력 설정 (실패해도 현재 설정으로 계속 수신)
+	if (status != HAL_TIMEOUT) {
+		EBIMU_Format_Command(cmd, "sor", IMU_OUTPUT_PERIOD_MS);
+		if (imu_send_command(cmd, 0) != HAL_OK)
+			status = HAL_ERROR;
+		if (imu_send_command(EBIMU_CMD_BINARY, 1) != HAL_OK)
+			status = HAL_ERROR;
+	}
+
+	imu_rate_tick = HAL_GetTick();
+	imu_rate_frames = imu_stats.frames;
+	return status;
 }
 
-// [인터럽트] IDLE 감지 시 호출됨 - 최대한 짧고 빠르게 끝내야 함
+// [인터럽트] USART2 인터럽트마다 호출됨 - IDLE일 때만 새 바이트 훑기 (복사 없음)
 void IMU_IDLE_Callback(void) {
-	// 1. UART IDLE 인터럽트 플래그 클리어
+	if (imu_uart == NULL) // IMU_Init 이전 (main.c는 모터 설정 뒤에 초기화)
+		return;
+	if (__HAL_UART_GET_FLAG(imu_uart, UART_FLAG_IDLE) == RESET)
+		return;
+
+	// UART IDLE 인터럽트 플래그 클리어
 	__HAL_UART_CLEAR_IDLEFLAG(imu_uart);
+	imu_stats.idle_events++;
+	imu_scan();
+}
 
-	// 2. DMA 버퍼 데이터를 파싱용 버퍼로 '복사'만 수행 (계산 X)
-	// 이렇게 하면 인터럽트 처리가 순식간에 끝나서 스택이 터지지 않음
-	memcpy(imu_parsing_buf, (char*) imu_rx_buf, IMU_BUF_SIZE);
+// [인터럽트] DMA 절반/완료 - 프레임 사이 IDLE이 없이 계속 들어와도 한 바퀴 안에 위치를 따라잡음
+void IMU_DMA_Callback(void) {
+	imu_scan();
+}
 
-	// 3. 메인 루프에게 "데이터 도착했으니 처리해라"라고 깃발 들기
-	imu_data_ready = 1;
+// [인터럽트] 수신 오류: 노이즈/프레이밍 오류는 수신이 계속되고, 오버런 등으로 수신이 중단되었으면 재시작
+void IMU_Error_Callback(void) {
+	imu_stats.uart_errors++;
+	if (imu_uart->RxState == HAL_UART_STATE_READY)
+		imu_start_rx();
 }
 
-// [메인 루프용] 실제 데이터 파싱 및 변환 수행 (sscanf 사용)
+// [메인 루프용] 최신 완성 프레임을 링 안에서 바로 파싱
 void IMU_Process_Data(void) {
-    if (imu_data_ready == 1) {
-        imu_data_ready = 0; // 플래그 내림
+	imu_measure_rate();
 
-        // 1. 가장 최근 데이터 패킷 찾기 ('*' 문자로 시작)
-        char *start_ptr = strrchr(imu_parsing_buf, '*');
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	imu_scan(); // IDLE 전에 이미 받은 프레임도 가져옴
+	if (!imu_frame_ready) {
+		__set_PRIMASK(primask);
+		return;
+	}
+	uint32_t start = imu_ready_start;
+	uint16_t len = imu_ready_len;
+	uint8_t mode = imu_ready_mode;
+	imu_frame_ready = 0;
+	__set_PRIMASK(primask);
 
-        if (start_ptr != NULL) {
-            // 예시 데이터: "* -10.5, 5.3, 90.1"
-            start_ptr++; // '*' 다음 문자로 이동
+	// 예시 데이터: "*-10.5,5.3,90.1\r\n" (len은 '*'부터 줄바꿈 직전까지) 또는 바이너리 10바이트
+	uint16_t off = (uint16_t) (start & IMU_RING_MASK);
+	const uint8_t *frame;
+	if (off + len <= IMU_RING_SIZE) {
+		// 링 안에 연속 -> 복사 없이 파싱
+		frame = &imu_ring[off];
+	} else {
+		// 링 끝을 걸침 -> 두 조각을 이어 붙임
+		uint16_t first = IMU_RING_SIZE - off;
+		memcpy(imu_wrap_buf, &imu_ring[off], first);
+		memcpy(&imu_wrap_buf[first], imu_ring, len - first);
+		imu_stats.wraps++;
+		frame = imu_wrap_buf;
+	}
 
-            // 2. 콤마(,)를 기준으로 문자열 자르기
-            char *token;
-            char *context = NULL; // strtok_r용 문맥 포인터
+	IMU_Data_t data;
+	EBIMU_Result_t result;
+	if (mode == IMU_MODE_BINARY)
+		result = EBIMU_Parse_Binary(frame, len, &data);
+	else
+		result = EBIMU_Parse_Ascii(frame + 1, len - 1, &data);
 
-            // Roll 파싱
-            token = strtok_r(start_ptr, ",", &context);
-            if (token != NULL) current_imu_data.roll = strtof(token, NULL);
+	// 파싱하는 동안 DMA가 한 바퀴 돌아 '*' 위치를 덮어썼으면 찢어진 값이므로 버림
+	imu_scan_locked();
+	if (imu_rx_pos - start >= IMU_RING_SIZE) {
+		imu_stats.overruns++;
+		return;
+	}
 
-            // Pitch 파싱 (우리가 필요한 값)
-            token = strtok_r(NULL, ",", &context);
-            if (token != NULL) current_imu_data.pitch = strtof(token, NULL);
-
-            // Yaw 파싱
-            token = strtok_r(NULL, ",", &context);
-            if (token != NULL) current_imu_data.yaw = strtof(token, NULL);
-        }
-    }
+	if (result == EBIMU_OK) {
+		current_imu_data = data;
+		imu_stats.parsed++;
+	} else {
+		imu_stats.parse_errors++;
+		imu_stats.last_parse_error = (uint8_t) result;
+	}
 }
 
 // 외부에서 최신 IMU 데이터를 조회하기 위한 인터페이스
 IMU_Data_t IMU_Get_Data(void) {
 	return current_imu_data;
 }
+
+// 수신/파싱 통계 조회
+const IMU_Stats_t* IMU_Get_Stats(void) {
+	return &imu_stats;
+}
@@ -0,0 +1,200 @@
+/*
+ * imu_ebimu.c
+ * Description: EBIMU 출력 프레임 파서 구현체
+ * Note: 숫자는 정수 가수부와 소수 자릿수로 모은 뒤 10의 거듭제곱으로 한 번 나눔
+ *       (가수부가 2^24 미만이면 나눗셈 1회의 반올림만 생기므로 strtof와 같은 값)
+ * 수정사항: 바이너리 프레임 디코더 추가 (SOP/체크섬 검증 후 int16 3개 변환)
+ * 수정사항: 보레이트 표와 숫자 인자 명령 생성 추가 (snprintf 없이)
+ */
+#include "imu_ebimu.h"
+#include <string.h>
+#include <stdlib.h>
+
+// <sbN> 번호 순서의 보레이트 (N = 인덱스 + 1)
+static const uint32_t ebimu_bauds[EBIMU_BAUD_COUNT] = {
+		9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600 };
+
+// 소수 자릿수별 나눗수 (EBIMU_MAX_DIGITS까지 float로 정확히 표현됨)
+static const float ebimu_pow10[EBIMU_MAX_DIGITS + 1] = {
+		1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f };
+
+// ---------------------------------------------------------------------------
+// 1. ASCII 프레임 파서
+// ---------------------------------------------------------------------------
+
+EBIMU_Result_t EBIMU_Parse_Ascii(const uint8_t *p, uint16_t len, IMU_Data_t *out) {
+	float v[EBIMU_ASCII_FIELDS];
+	uint16_t i = 0;
+
+	for (int f = 0; f < EBIMU_ASCII_FIELDS; f++) {
+		int32_t mant = 0;
+		uint8_t digits = 0, frac = 0, dot = 0, neg = 0;
+
+		// [공백] [부호] 숫자 [. 숫자] [공백]
+		while (i < len && p[i] == ' ')
+			i++;
+		if (i < len && (p[i] == '-' || p[i] == '+')) {
+			neg = (p[i] == '-');
+			i++;
+		}
+		for (; i < len; i++) {
+			uint8_t c = p[i];
+			if (c >= '0' && c <= '9') {
+				if (++digits > EBIMU_MAX_DIGITS)
+					return EBIMU_ERR_DIGITS;
+				mant = mant * 10 + (c - '0');
+				frac += dot;
+			} else if (c == '.' && !dot) {
+				dot = 1;
+			} else {
+				break;
+			}
+		}
+		if (digits == 0)
+			return (i < len && p[i] != ',') ? EBIMU_ERR_CHAR : EBIMU_ERR_EMPTY;
+		while (i < len && p[i] == ' ')
+			i++;
+
+		// 필드 구분: 마지막 필드가 아니면 콤마가 있어야 함
+		if (f < EBIMU_ASCII_FIELDS - 1) {
+			if (i >= len)
+				return EBIMU_ERR_FIELDS;
+			if (p[i] != ',')
+				return EBIMU_ERR_CHAR;
+			i++;
+		}
+
+		float x = (float) mant / ebimu_pow10[frac];
+		if (x > EBIMU_ANGLE_LIMIT)
+			return EBIMU_ERR_RANGE;
+		v[f] = neg ? -x : x;
+	}
+
+	// 세 값 뒤에 남은 문자가 있으면 오류 (출력 항목 설정이 다른 경우 포함)
+	if (i < len)
+		return (p[i] == ',') ? EBIMU_ERR_FIELDS : EBIMU_ERR_CHAR;
+
+	out->roll = v[0];
+	out->pitch = v[1];
+	out->yaw = v[2];
+	return EBIMU_OK;
+}
+
+// ---------------------------------------------------------------------------
+// 2. 바이너리 프레임 디코더
+// ---------------------------------------------------------------------------
+
+EBIMU_Result_t EBIMU_Parse_Binary(const uint8_t *p, uint16_t len, IMU_Data_t *out) {
+	if (len != EBIMU_BIN_FRAME_LEN || p[0] != EBIMU_BIN_SOP || p[1] != EBIMU_BIN_SOP)
+		return EBIMU_ERR_CHECKSUM;
+
+	uint16_t sum = 0;
+	for (int i = 0; i < EBIMU_BIN_FRAME_LEN - 2; i++)
+		sum += p[i];
+	if (sum != (uint16_t) ((p[8] << 8) | p[9]))
+		return EBIMU_ERR_CHECKSUM;
+
+	out->roll = (int16_t) ((p[2] << 8) | p[3]) / EBIMU_BIN_DIV;
+	out->pitch = (int16_t) ((p[4] << 8) | p[5]) / EBIMU_BIN_DIV;
+	out->yaw = (int16_t) ((p[6] << 8) | p[7]) / EBIMU_BIN_DIV;
+	return EBIMU_OK;
+}
+
+// ---------------------------------------------------------------------------
+// 3. 설정 명령
+// ---------------------------------------------------------------------------
+
+uint8_t EBIMU_Baud_Code(uint32_t baud) {
+	for (uint8_t i = 0; i < EBIMU_BAUD_COUNT; i++) {
+		if (ebimu_bauds[i] == baud)
+			return i + 1;
+	}
+	return 0;
+}
+
+uint32_t EBIMU_Baud_Of_Code(uint8_t code) {
+	return (code >= 1 && code <= EBIMU_BAUD_COUNT) ? ebimu_bauds[code - 1] : 0;
+}
+
+uint16_t EBIMU_Format_Command(char *buf, const char *name, uint16_t value) {
+	char digits[5];
+	uint8_t n = 0;
+	uint16_t len = 0;
+
+	buf[len++] = '<';
+	while (*name)
+		buf[len++] = *name++;
+	do {
+		digits[n++] = (char) ('0' + value % 10);
+		value /= 10;
+	} while (value);
+	while (n)
+		buf[len++] = digits[--n];
+	buf[len++] = '>';
+	buf[len] = '\0';
+	return len;
+}
+
+// ---------------------------------------------------------------------------
+// 4. 벤치마크 (Cortex-M7 DWT 사이클 카운터)
+// ---------------------------------------------------------------------------
+
+// 비교 기준: 기존 IMU_Process_Data()의 newlib 방식 (NUL 종료 복사본 필요)
+static void ebimu_parse_libc(const uint8_t *frame, uint16_t len, IMU_Data_t *out) {
+	char buf[IMU_FRAME_MAX + 1];
+	memcpy(buf, frame, len);
+	buf[len] = '\0';
+
+	char *start_ptr = strrchr(buf, '*');
+	if (start_ptr == NULL)
+		return;
+	start_ptr++;
+
+	char *context = NULL;
+	char *token = strtok_r(start_ptr, ",", &context);
+	if (token != NULL) out->roll = strtof(token, NULL);
+	token = strtok_r(NULL, ",", &context);
+	if (token != NULL) out->pitch = strtof(token, NULL);
+	token = strtok_r(NULL, ",", &context);
+	if (token != NULL) out->yaw = strtof(token, NULL);
+}
+
+void EBIMU_Benchmark(EBIMU_Bench_t *result, uint32_t iterations) {
+	static const uint8_t frame[] = "*-12.34,5.67,178.90";
+	const uint16_t len = sizeof(frame) - 1;
+	IMU_Data_t data[2] = { 0, };
+	volatile float sink[2];
+
+	if (iterations == 0)
+		iterations = 1;
+
+	uint32_t start = DWT->CYCCNT;
+	for (uint32_t n = 0; n < iterations; n++) {
+		ebimu_parse_libc(frame, len, &data[0]);
+		sink[0] = data[0].yaw;
+	}
+	result->cycles_libc = (DWT->CYCCNT - start) / iterations;
+
+	start = DWT->CYCCNT;
+	for (uint32_t n = 0; n < iterations; n++) {
+		EBIMU_Parse_Ascii(&frame[1], len - 1, &data[1]);
+		sink[1] = data[1].yaw;
+	}
+	result->cycles_fast = (DWT->CYCCNT - start) / iterations;
+
+	// 같은 각도의 바이너리 프레임 (-1234, 567, 17890 x 0.01도)
+	static const uint8_t bin[EBIMU_BIN_FRAME_LEN] = {
+			0x55, 0x55, 0xFB, 0x2E, 0x02, 0x37, 0x45, 0xE2, 0x03, 0x33 };
+	IMU_Data_t data_bin;
+	start = DWT->CYCCNT;
+	for (uint32_t n = 0; n < iterations; n++) {
+		EBIMU_Parse_Binary(bin, sizeof(bin), &data_bin);
+		sink[0] = data_bin.yaw;
+	}
+	result->cycles_binary = (DWT->CYCCNT - start) / iterations;
+
+	result->frame_len = len;
+	result->match = (data[0].roll == data[1].roll) && (data[0].pitch == data[1].pitch)
+			&& (data[0].yaw == data[1].yaw) && (data_bin.roll == data[1].roll)
+			&& (data_bin.pitch == data[1].pitch) && (sink[0] == sink[1]);
+}
@@ -27,6 +27,17 @@
 #include <math.h>       // sin, cos, acos 등 삼각함수 연산용
 #include "dxl_2_0.h"    // 다이나믹셀 모터 통합 제어 드라이버
 #include "imu_driver.h" // IMU 센서 데이터 수신 드라이버
+#include "imu_ebimu.h"  // EBIMU 프레임 파서 (Debug 빌드 벤치마크)
+#include "dxl_bus.h"    // 모터 버스 비동기(DMA) 송신 엔진
+#include "dxl_crc.h"    // 프로토콜 2.0 CRC16 (하드웨어/소프트웨어)
+#include "dxl_sched.h"  // 모터 버스 시간 분할 스케줄러
+#include "dxl_link.h"   // 모터 버스 보레이트/응답 지연 설정
+#include "dxl_cache.h"  // 바뀐 모터만 송신하는 명령 캐시
+#include "robot_topology.h" // 다리/관절/바퀴 구성 (ID, 방향, 영점)
+#include "dxl_health.h" // 모터별 송수신/오류 카운터, 응답 지연 분포
+#include "dxl_recovery.h" // 하드웨어 오류 관절 자동 재부팅/복귀
+#include "dxl_estop.h"   // 버튼 비상 정지 (미리 만든 토크 OFF 패킷, 정지 잠금)
+#include "dxl_diag.h"    // 남는 버스 시간에 모터 전체 온도/전압/부하/오류 순환 읽기
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -36,7 +47,9 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+// 관절 시간 기준 프로파일: 경유점 사이를 모터가 직접 보간 (제어 주기 2개에 걸쳐 이동, 앞뒤 1/4은 가감속)
+#define JOINT_PROFILE_MS       (2 * DXL_SCHED_PERIOD_US / 1000)
+#define JOINT_PROFILE_ACCEL_MS (JOINT_PROFILE_MS / 4)
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -55,14 +68,34 @@ extern UART_HandleTypeDef huart3; // 모터 제어용 UART
 float L1 = 170.0f; // 허벅지 길이 (고관절 중심부터 무릎 중심까지)
 float L2 = 150.0f; // 종아리 길이 (무릎 중심부터 바퀴 축 중심까지)
 
-// 모터 제어값 저장용 배열
-uint32_t hip_goals[4] = { 2048, 2048, 2048, 2048 }; // 고관절 목표 위치
-uint32_t knee_goals[4] = { 2048, 2048, 2048, 2048 }; // 무릎관절 목표 위치
-int16_t wheel_speeds[4] = { 0, 0, 0, 0 };           // 바퀴 회전 속도
+// 모터 제어값 저장용 배열 (관절 인덱스 = 다리 * JOINTS_PER_LEG + 0: 고관절, 1: 무릎)
+float joint_angles[JOINT_COUNT];       // 관절 각도 (rad, 영점 기준 - 역기구학 결과)
+uint32_t joint_goals[JOINT_COUNT];     // 관절 목표 위치 (방향/영점 반영)
+int16_t wheel_speeds[LEG_COUNT] = { 0 }; // 바퀴 회전 속도 (로봇 기준, 전진 +)
+static int16_t wheel_goals[LEG_COUNT];   // 바퀴 목표 속도 (장착 방향 반영)
 
 int toggle_state = 0; // 0: 일어서기 동작 수행, 1: 앉기(스쿼트) 동작 수행
 // 디버깅 모니터링을 위해 전역 변수로 선언
 IMU_Data_t imu;
+HAL_StatusTypeDef sched_status; // HAL_ERROR: 버스 슬롯이 제어 주기 안에 들어가지 않음 (주기가 늘어난 상태)
+DXL_Link_Report_t link_report;  // 모터 응답 여부, 보레이트/Return Delay Time 설정 결과
+HAL_StatusTypeDef link_status;  // HAL_ERROR: 응답 없는 모터가 있거나 보레이트 변경 실패
+HAL_StatusTypeDef indirect_status; // HAL_ERROR: Indirect 매핑 실패 (상태 읽기는 기존 10바이트 블록 유지)
+HAL_StatusTypeDef drive_mode_status; // HAL_ERROR: 시간 기준 프로파일 설정 실패 (프로파일 없이 목표 위치로 바로 이동)
+DXL_Discovery_Report_t discovery_report; // 부팅 탐색: 응답 없는/모델이 다른/예상 밖 모터, 걸린 시간
+HAL_StatusTypeDef discovery_status; // HAL_TIMEOUT: 응답 없는 모터, HAL_ERROR: 모델 불일치 또는 예상 밖 ID
+HAL_StatusTypeDef torque_status;    // HAL_TIMEOUT: 토크 ON이 확인되지 않은 모터가 있음
+const DXL_Health_t *bus_health; // 모터별 송신/응답/오류/지연 분포 (DXL_HEALTH_MAX_MOTORS개, 관절 인덱스 다음 바퀴 순서)
+const DXL_Recovery_Report_t *recovery_report; // 하드웨어 오류 복구 시도/성공/실패, 복구 중인 관절
+const DXL_Estop_Report_t *estop_report; // 비상 정지 잠금 여부, 버튼 ~ 마지막 바이트 시간(측정 최대값/계산 상한)
+const DXL_Diag_Motor_t *motor_diag;    // 모터별 온도/전압/부하/Moving/하드웨어 오류와 항목별 갱신 시각 (DXL_DIAG_MOTORS개)
+const DXL_Diag_Report_t *sweep_report; // 진단 스윕 요청 수, 한 바퀴 걸린 시간
+const IMU_Stats_t *imu_stats; // IMU 수신 바이트/프레임/파싱 오류/덮어쓰기 횟수, 출력 형식, 보레이트, 수신 프레임 속도(Hz)
+HAL_StatusTypeDef imu_status;  // HAL_TIMEOUT: 어느 보레이트에서도 응답 없음, HAL_ERROR: 보레이트/출력 주기/바이너리 설정 일부 실패
+#ifdef DEBUG
+DXL_CRC_Bench_t crc_bench; // [Debug 빌드] CRC 엔진별 패킷 1개당 사이클 (부팅 시 1회 측정, match=0이면 엔진 불일치)
+EBIMU_Bench_t imu_bench; // [Debug 빌드] IMU 파서 프레임 1개당 사이클 (기존 newlib / ASCII / 바이너리, match=0이면 결과 불일치)
+#endif
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -70,7 +103,8 @@ void SystemClock_Config(void);
 static void MPU_Config(void);
 /* USER CODE BEGIN PFP */
 // 역기구학 연산: 목표 높이(H)를 넣으면 모터가 움직여야 할 각도를 계산해줌
-void calculate_leg_ik(float H, uint32_t *hip_out, uint32_t *knee_out) {
+// (모터 방향/영점은 robot_topology 표에서 반영하므로 여기서는 관절 각도만 계산)
+void calculate_leg_ik(float H, float *hip_rad, float *knee_rad) {
 	// 코사인 법칙을 활용하여 관절 각도 도출
 	float cos_knee = (H * H - L1 * L1 - L2 * L2) / (2.0f * L1 * L2);
 
@@ -80,18 +114,28 @@ void calculate_leg_ik(float H, uint32_t *hip_out, uint32_t *knee_out) {
 	if (cos_knee < -1.0f)
 		cos_knee = -1.0f;
 
-	float angle_knee_rad = acosf(cos_knee);
-	float angle_hip_rad = asinf((L2 * sinf(angle_knee_rad)) / H);
-
-	// 계산된 라디안 각도를 모터 제어 단위(0~4095)로 변환
-	*hip_out = 2048 + (uint32_t) (angle_hip_rad * (4096.0f / (2.0f * M_PI)));
-	*knee_out = 2048 - (uint32_t) (angle_knee_rad * (4096.0f / (2.0f * M_PI)));
+	*knee_rad = acosf(cos_knee);
+	*hip_rad = asinf((L2 * sinf(*knee_rad)) / H);
 }
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+// 버스 스케줄러 슬롯: 각 슬롯 시작 시각에 호출되어 패킷을 송신 큐에 넣음
+// (명령 캐시를 거치므로 값이 바뀐 모터만 송신, 절약된 시간은 상태/진단 읽기 여유로 남음)
+static void slot_joint_write(void) {
+	DXL_Cache_Write_Joints(joint_goals);
+}
+
+static void slot_wheel_write(void) {
+	Robot_Wheel_Speeds_To_Goals(wheel_speeds, wheel_goals);
+	DXL_Cache_Write_Wheels(wheel_goals);
+}
 
+// 슬롯 사이 대기 중: 도착한 상태 패킷을 바로 해석 (응답 지연이 해석 시각 기준이므로)
+static void bus_idle_poll(void) {
+	DXL_Poll_Joint_State();
+}
 /* USER CODE END 0 */
 
 /**
@@ -120,7 +164,7 @@ int main(void) {
 	SystemClock_Config();
 
 	/* USER CODE BEGIN SysInit */
-
+	DWT_Cycle_Init(); // 스케줄러/응답 지연/벤치마크가 쓰는 사이클 카운터
 	/* USER CODE END SysInit */
 
 	/* Initialize all configured peripherals */
@@ -129,19 +173,65 @@ int main(void) {
 	MX_USART2_UART_Init();
 	MX_USART3_UART_Init();
 	/* USER CODE BEGIN 2 */
-	HAL_Delay(1000);
-
-	IMU_Init(&huart2);
+	DXL_Bus_Init(&huart3);
+	DXL_CRC_Init(); // CRC 주변장치 자체 검증 실패 시 소프트웨어 테이블 사용
+#ifdef DEBUG
+	DXL_CRC_Benchmark(&crc_bench, 1000); // 엔진 4개 x 1000회 (수 ms, Release 빌드에서는 생략)
+	EBIMU_Benchmark(&imu_bench, 1000);   // 방식 3개 x 1000회
+#endif
+	DXL_Init();     // robot_topology 구성 기반 Sync Write 패킷 템플릿 생성
+	Robot_Joint_Angles_To_Goals(joint_angles, joint_goals); // 초기 목표 = 관절 영점
+	bus_health = DXL_Health_Get_Index(0);
+	DXL_Diag_Init();
+	motor_diag = DXL_Diag_Get(0);
+	sweep_report = DXL_Diag_Get_Report();
+	// 모터 전원 인가 대기: 고정 1초 대신 구성 표의 모든 모터가 응답하는 즉시 진행 (최대 2초)
+	discovery_status = DXL_Link_Discover(&discovery_report, DXL_DISCOVERY_TIMEOUT_MS);
+	link_status = DXL_Link_Setup(&link_report, &discovery_report); // 토크 OFF 상태에서 보레이트/응답 지연 조정 (탐색에서 응답한 모터는 Ping 생략)
+	indirect_status = DXL_Indirect_Setup();     // 토크 ON 전에 명령/상태 블록 매핑
+	drive_mode_status = DXL_Set_Drive_Mode(1);  // 프로파일 단위를 시간(ms)으로 (EEPROM, 토크 OFF 필요)
+	if (drive_mode_status == HAL_OK)
+		DXL_Cache_Set_Joint_Profile(JOINT_COUNT, JOINT_PROFILE_MS, JOINT_PROFILE_ACCEL_MS);
+
+	// IMU: 고정 1초 부팅 대기 대신 센서가 "<ok>"로 응답할 때까지 보레이트 탐지 반복 (리셋 후 최대 IMU_BOOT_TIMEOUT_MS)
+	// 모터 탐색/설정 뒤에 호출해 그동안 센서 부팅이 함께 진행되도록 함 (imu_stats->detect_sweeps > 1이면 센서를 기다림)
+	imu_status = IMU_Init(&huart2);
+	imu_stats = IMU_Get_Stats();
+
+	// 비상 정지용 토크 OFF 패킷 준비 (보레이트/Indirect 설정이 끝난 뒤 - 최악 시간 계산에 사용)
+	DXL_Estop_Init();
+	estop_report = DXL_Estop_Get_Report();
 
 	dxl_torque_set(1, 1, 1);
-	HAL_Delay(1000);
+	torque_status = DXL_Link_Wait_Torque(1, DXL_TORQUE_TIMEOUT_MS); // 모든 모터의 토크 ON이 읽히면 바로 진행
+	// 토크 ON 이후부터 하드웨어 오류 관절 자동 복구 (합류 후 평소 프로파일로 되돌림)
+	if (drive_mode_status == HAL_OK)
+		DXL_Recovery_Init(JOINT_PROFILE_MS, JOINT_PROFILE_ACCEL_MS);
+	else
+		DXL_Recovery_Init(0, 0);
+	recovery_report = DXL_Recovery_Get_Report();
+
+	// 제어 주기 슬롯 구성: 관절 쓰기 -> 바퀴 쓰기 -> 상태 읽기 -> 진단/복구 (순서대로 송신)
+	DXL_Sched_Config_Slot(DXL_SLOT_JOINT_WRITE, slot_joint_write, DXL_Get_Joint_Write_Cost);
+	DXL_Sched_Config_Slot(DXL_SLOT_WHEEL_WRITE, slot_wheel_write, DXL_Get_Wheel_Write_Cost);
+	DXL_Sched_Config_Slot(DXL_SLOT_SYNC_READ, send_sync_read_joint_state, DXL_Get_Joint_Read_Cost);
+	DXL_Sched_Config_Slot(DXL_SLOT_DIAG, DXL_Recovery_Slot, DXL_Get_Diag_Cost); // 복구 요청이 없으면 순환 진단 읽기
+	DXL_Sched_Set_Fill(DXL_Diag_Sweep_Slot, DXL_Diag_Sweep_Cost); // 슬롯이 남긴 시간에만 진단 스윕 (들어가지 않으면 미룸)
+	DXL_Sched_Set_Idle_Callback(bus_idle_poll);
+	sched_status = DXL_Sched_Init(DXL_SCHED_PERIOD_US); // 예산 초과 시 DXL_Sched_Get_Report()->over_us 확인
 	/* USER CODE END 2 */
 
 	/* Infinite loop */
 	/* USER CODE BEGIN WHILE */
 	while (1) {
+		// 다음 제어 주기 시작까지 대기 (50Hz)
+		DXL_Sched_Wait_Period();
+
 		// 인터럽트 대신 여기서 파싱 수행
-		IMU_Process_Data(); // sscanf를 안전하게 수행함
+		IMU_Process_Data(); // 최신 완성 프레임을 DMA 링 안에서 바로 파싱
+
+		// 지난 주기에 요청한 관절 상태(위치/속도/전류) 응답 해석
+		DXL_Poll_Joint_State();
 
 		// 1. 최신 IMU 데이터 읽기 (전역 변수에 저장)
 		imu = IMU_Get_Data();
@@ -149,24 +239,21 @@ int main(void) {
 		float base_H = 250.0f; // 기준 높이 (mm)
 		float compensation = imu.pitch * 2.0f; // 기울기에 따른 높이 보정값 (P제어 예시)
 
-		// 2. 기울기에 맞춰 앞/뒤 다리 높이 차등 계산
-		// 몸체가 앞으로 쏠리면 앞다리를 늘리고 뒷다리를 줄여 수평 유지
-		float front_H = base_H + compensation;
-		float rear_H = base_H - compensation;
-
-		// 3. 역기구학 적용 (앞다리: 0, 1번 / 뒷다리: 2, 3번)
-		for (int i = 0; i < 2; i++) {
-			calculate_leg_ik(front_H, &hip_goals[i], &knee_goals[i]); // 앞다리 계산
-		}
-		for (int i = 2; i < 4; i++) {
-			calculate_leg_ik(rear_H, &hip_goals[i], &knee_goals[i]);  // 뒷다리 계산
+		// 2~3. 기울기에 맞춰 다리별 높이를 차등 계산하고 역기구학 적용
+		// 몸체가 앞으로 쏠리면 앞다리(피치 부호 +1)를 늘리고 뒷다리(-1)를 줄여 수평 유지
+		for (int leg = 0; leg < LEG_COUNT; leg++) {
+			float H = base_H + robot_leg_pitch_sign[leg] * compensation;
+			calculate_leg_ik(H, &joint_angles[leg * JOINTS_PER_LEG], &joint_angles[leg * JOINTS_PER_LEG + 1]);
 		}
-
-		// 4. 계산된 각도와 휠 속도를 모터로 전송
-		send_sync_write_2_joints(hip_goals, knee_goals);
-		send_sync_write_1_wheel(wheel_speeds);
-
-		HAL_Delay(20); // 50Hz 주기로 제어 루프 반복
+		Robot_Joint_Angles_To_Goals(joint_angles, joint_goals); // 방향/영점 반영 (관절 순서대로 연속 처리)
+
+		// 4. 버스 슬롯 실행: 계산된 각도/휠 속도 송신 후 상태 읽기와 진단 읽기 요청
+		// (각 슬롯은 앞 슬롯의 송신과 응답이 끝나는 시각에 시작하므로 응답끼리 충돌하지 않음)
+		// 비상 정지 후에는 슬롯을 실행하지 않고 토크 OFF 재송신만 (리셋 전까지 유지)
+		if (DXL_Estop_Is_Latched())
+			DXL_Estop_Service();
+		else
+			DXL_Sched_Run();
 	}
 	/* USER CODE END WHILE */
 
@@ -223,7 +310,12 @@ void SystemClock_Config(void) {
 }
 
 /* USER CODE BEGIN 4 */
-
+// DWT 사이클 카운터 활성화 (Cortex-M7은 LAR 잠금 해제 필요)
+void DWT_Cycle_Init(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->LAR = 0xC5ACCE55;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
 /* USER CODE END 4 */
 
 /* MPU Configuration */
@@ -0,0 +1,46 @@
+/*
+ * robot_topology.c
+ * Description: 로봇 모터 구성 표를 항목별 상수 배열로 전개 (플래시 배치)
+ * Note: 송신/역기구학 코드는 이 배열들을 관절 인덱스 순서로 연속 접근함
+ */
+
+#include "robot_topology.h"
+
+#define TWO_PI_F 6.28318530718f
+#define TICKS_PER_RAD (4096.0f / TWO_PI_F) // MX 1회전 = 4096틱
+
+// 표 항목에서 열 하나씩 꺼내는 매크로
+#define JOINT_ID(leg, id, model, dir, zero)    id,
+#define JOINT_LEG(leg, id, model, dir, zero)   leg,
+#define JOINT_MODEL(leg, id, model, dir, zero) model,
+#define JOINT_DIR(leg, id, model, dir, zero)   dir,
+#define JOINT_ZERO(leg, id, model, dir, zero)  zero,
+#define WHEEL_ID(leg, id, model, dir)          id,
+#define WHEEL_MODEL(leg, id, model, dir)       model,
+#define WHEEL_DIR(leg, id, model, dir)         dir,
+#define LEG_PITCH(name, pitch)                 pitch,
+
+const uint8_t robot_joint_ids[JOINT_COUNT] = { ROBOT_JOINT_TABLE(JOINT_ID) };
+const uint8_t robot_joint_leg[JOINT_COUNT] = { ROBOT_JOINT_TABLE(JOINT_LEG) };
+const DXL_Model_t robot_joint_model[JOINT_COUNT] = { ROBOT_JOINT_TABLE(JOINT_MODEL) };
+const int8_t robot_joint_dir[JOINT_COUNT] = { ROBOT_JOINT_TABLE(JOINT_DIR) };
+const uint16_t robot_joint_zero[JOINT_COUNT] = { ROBOT_JOINT_TABLE(JOINT_ZERO) };
+const uint8_t robot_wheel_ids[LEG_COUNT] = { ROBOT_WHEEL_TABLE(WHEEL_ID) };
+const DXL_Model_t robot_wheel_model[LEG_COUNT] = { ROBOT_WHEEL_TABLE(WHEEL_MODEL) };
+const int8_t robot_wheel_dir[LEG_COUNT] = { ROBOT_WHEEL_TABLE(WHEEL_DIR) };
+const int8_t robot_leg_pitch_sign[LEG_COUNT] = { ROBOT_LEG_TABLE(LEG_PITCH) };
+
+// 관절 인덱스 = 다리 * JOINTS_PER_LEG + 역할 이므로 표 길이가 맞아야 함
+_Static_assert(JOINT_COUNT == LEG_COUNT * JOINTS_PER_LEG, "관절 표: 다리마다 고관절, 무릎 2개");
+_Static_assert(sizeof(robot_wheel_ids) == LEG_COUNT, "바퀴 표: 다리마다 바퀴 1개");
+
+void Robot_Joint_Angles_To_Goals(const float *angle_rad, uint32_t *goals) {
+	for (int j = 0; j < JOINT_COUNT; j++)
+		goals[j] = (uint32_t) ((int32_t) robot_joint_zero[j]
+				+ robot_joint_dir[j] * (int32_t) (angle_rad[j] * TICKS_PER_RAD));
+}
+
+void Robot_Wheel_Speeds_To_Goals(const int16_t *speed, int16_t *goals) {
+	for (int w = 0; w < LEG_COUNT; w++)
+		goals[w] = (int16_t) (robot_wheel_dir[w] * speed[w]);
+}
@@ -59,6 +59,7 @@
 extern DMA_HandleTypeDef hdma_usart2_tx;
 extern DMA_HandleTypeDef hdma_usart2_rx;
 extern DMA_HandleTypeDef hdma_usart3_tx;
+extern DMA_HandleTypeDef hdma_usart3_rx;
 extern UART_HandleTypeDef huart2;
 extern UART_HandleTypeDef huart3;
 /* USER CODE BEGIN EV */
@@ -244,13 +245,27 @@ void DMA1_Stream2_IRQHandler(void)
   /* USER CODE END DMA1_Stream2_IRQn 1 */
 }
 
+/**
+  * @brief This function handles DMA1 stream3 global interrupt.
+  */
+void DMA1_Stream3_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Stream3_IRQn 0 */
+
+  /* USER CODE END DMA1_Stream3_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart3_rx);
+  /* USER CODE BEGIN DMA1_Stream3_IRQn 1 */
+
+  /* USER CODE END DMA1_Stream3_IRQn 1 */
+}
+
 /**
   * @brief This function handles USART2 global interrupt.
   */
 void USART2_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_IRQn 0 */
-	// UART IDLE(수신 대기) 라인 감지: 수신된 IMU 데이터 패킷 파싱 및 처리
+	// UART IDLE(수신 대기) 라인 감지: 새로 들어온 IMU 바이트만 훑어 프레임 경계 기록 (파싱은 메인 루프)
 	IMU_IDLE_Callback();
   /* USER CODE END USART2_IRQn 0 */
   HAL_UART_IRQHandler(&huart2);
@@ -289,13 +304,46 @@ void EXTI15_10_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 #include "dxl_2_0.h" // 모터 제어 함수 사용을 위한 헤더 포함
+#include "dxl_bus.h" // 모터 버스 비동기 송신 엔진
+#include "dxl_estop.h" // 비상 정지 (미리 만든 토크 OFF 패킷)
 
 // 하드웨어 인터럽트 발생 시 자동으로 호출되는 콜백 함수
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
 	// PC13 버튼(B1) 인터럽트 신호인지 확인
 	if (GPIO_Pin == GPIO_PIN_13) {
-		// 12개 모터 전력 즉시 차단 (비상 정지)
-		DXL_Emergency_All_Off();
+		// 12개 모터 전력 즉시 차단 (송신 중인 DMA를 끊고 토크 OFF 송신, 대기 없음 - 이후 정지 잠금)
+		DXL_Estop_Trigger();
+	}
+}
+
+// UART 송신 완료(TC) 시 HAL이 호출하는 콜백 함수
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+	// USART3(모터 버스): 마지막 비트 송신 완료 -> RS-485 수신 모드 복귀
+	if (huart->Instance == USART3) {
+		DXL_Bus_TxCplt_Callback();
+	}
+}
+
+// UART 수신 DMA 절반/완료 시 HAL이 호출하는 콜백 함수
+// USART2(IMU): IDLE 없이 계속 수신되어도 링 한 바퀴 안에 쓰기 위치를 따라잡음
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart) {
+	if (huart->Instance == USART2) {
+		IMU_DMA_Callback();
+	}
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
+	if (huart->Instance == USART2) {
+		IMU_DMA_Callback();
+	}
+}
+
+// UART/DMA 오류 발생 시 HAL이 호출하는 콜백 함수
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+	if (huart->Instance == USART3) {
+		DXL_Bus_Error_Callback();
+	} else if (huart->Instance == USART2) {
+		IMU_Error_Callback();
 	}
 }
 /* USER CODE END 1 */
@@ -7,9 +7,22 @@
 C_SRCS += \
 ../Core/Src/dma.c \
 ../Core/Src/dxl_2_0.c \
+../Core/Src/dxl_bus.c \
+../Core/Src/dxl_cache.c \
+../Core/Src/dxl_crc.c \
+../Core/Src/dxl_diag.c \
+../Core/Src/dxl_estop.c \
+../Core/Src/dxl_health.c \
+../Core/Src/dxl_link.c \
+../Core/Src/dxl_model.c \
+../Core/Src/dxl_recovery.c \
+../Core/Src/dxl_sched.c \
+../Core/Src/dxl_status.c \
 ../Core/Src/gpio.c \
 ../Core/Src/imu_driver.c \
+../Core/Src/imu_ebimu.c \
 ../Core/Src/main.c \
+../Core/Src/robot_topology.c \
 ../Core/Src/stm32h7xx_hal_msp.c \
 ../Core/Src/stm32h7xx_it.c \
 ../Core/Src/syscalls.c \
@@ -20,9 +33,22 @@ C_SRCS += \
 OBJS += \
 ./Core/Src/dma.o \
 ./Core/Src/dxl_2_0.o \
+./Core/Src/dxl_bus.o \
+./Core/Src/dxl_cache.o \
+./Core/Src/dxl_crc.o \
+./Core/Src/dxl_diag.o \
+./Core/Src/dxl_estop.o \
+./Core/Src/dxl_health.o \
+./Core/Src/dxl_link.o \
+./Core/Src/dxl_model.o \
+./Core/Src/dxl_recovery.o \
+./Core/Src/dxl_sched.o \
+./Core/Src/dxl_status.o \
 ./Core/Src/gpio.o \
 ./Core/Src/imu_driver.o \
+./Core/Src/imu_ebimu.o \
 ./Core/Src/main.o \
+./Core/Src/robot_topology.o \
 ./Core/Src/stm32h7xx_hal_msp.o \
 ./Core/Src/stm32h7xx_it.o \
 ./Core/Src/syscalls.o \
@@ -33,9 +59,22 @@ OBJS += \
 C_DEPS += \
 ./Core/Src/dma.d \
 ./Core/Src/dxl_2_0.d \
+./Core/Src/dxl_bus.d \
+./Core/Src/dxl_cache.d \
+./Core/Src/dxl_crc.d \
+./Core/Src/dxl_diag.d \
+./Core/Src/dxl_estop.d \
+./Core/Src/dxl_health.d \
+./Core/Src/dxl_link.d \
+./Core/Src/dxl_model.d \
+./Core/Src/dxl_recovery.d \
+./Core/Src/dxl_sched.d \
+./Core/Src/dxl_status.d \
 ./Core/Src/gpio.d \
 ./Core/Src/imu_driver.d \
+./Core/Src/imu_ebimu.d \
 ./Core/Src/main.d \
+./Core/Src/robot_topology.d \
 ./Core/Src/stm32h7xx_hal_msp.d \
 ./Core/Src/stm32h7xx_it.d \
 ./Core/Src/syscalls.d \
@@ -51,7 +90,7 @@ Core/Src/%.o Core/Src/%.su Core/Src/%.cyclo: ../Core/Src/%.c Core/Src/subdir.mk
 clean: clean-Core-2f-Src
 
 clean-Core-2f-Src:
-	-$(RM) ./Core/Src/dma.cyclo ./Core/Src/dma.d ./Core/Src/dma.o ./Core/Src/dma.su ./Core/Src/dxl_2_0.cyclo ./Core/Src/dxl_2_0.d ./Core/Src/dxl_2_0.o ./Core/Src/dxl_2_0.su ./Core/Src/gpio.cyclo ./Core/Src/gpio.d ./Core/Src/gpio.o ./Core/Src/gpio.su ./Core/Src/imu_driver.cyclo ./Core/Src/imu_driver.d ./Core/Src/imu_driver.o ./Core/Src/imu_driver.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/stm32h7xx_hal_msp.cyclo ./Core/Src/stm32h7xx_hal_msp.d ./Core/Src/stm32h7xx_hal_msp.o ./Core/Src/stm32h7xx_hal_msp.su ./Core/Src/stm32h7xx_it.cyclo ./Core/Src/stm32h7xx_it.d ./Core/Src/stm32h7xx_it.o ./Core/Src/stm32h7xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32h7xx.cyclo ./Core/Src/system_stm32h7xx.d ./Core/Src/system_stm32h7xx.o ./Core/Src/system_stm32h7xx.su ./Core/Src/usart.cyclo ./Core/Src/usart.d ./Core/Src/usart.o ./Core/Src/usart.su
+	-$(RM) ./Core/Src/dma.cyclo ./Core/Src/dma.d ./Core/Src/dma.o ./Core/Src/dma.su ./Core/Src/dxl_2_0.cyclo ./Core/Src/dxl_2_0.d ./Core/Src/dxl_2_0.o ./Core/Src/dxl_2_0.su ./Core/Src/dxl_bus.cyclo ./Core/Src/dxl_bus.d ./Core/Src/dxl_bus.o ./Core/Src/dxl_bus.su ./Core/Src/dxl_cache.cyclo ./Core/Src/dxl_cache.d ./Core/Src/dxl_cache.o ./Core/Src/dxl_cache.su ./Core/Src/dxl_crc.cyclo ./Core/Src/dxl_crc.d ./Core/Src/dxl_crc.o ./Core/Src/dxl_crc.su ./Core/Src/dxl_diag.cyclo ./Core/Src/dxl_diag.d ./Core/Src/dxl_diag.o ./Core/Src/dxl_diag.su ./Core/Src/dxl_estop.cyclo ./Core/Src/dxl_estop.d ./Core/Src/dxl_estop.o ./Core/Src/dxl_estop.su ./Core/Src/dxl_health.cyclo ./Core/Src/dxl_health.d ./Core/Src/dxl_health.o ./Core/Src/dxl_health.su ./Core/Src/dxl_link.cyclo ./Core/Src/dxl_link.d ./Core/Src/dxl_link.o ./Core/Src/dxl_link.su ./Core/Src/dxl_model.cyclo ./Core/Src/dxl_model.d ./Core/Src/dxl_model.o ./Core/Src/dxl_model.su ./Core/Src/dxl_recovery.cyclo ./Core/Src/dxl_recovery.d ./Core/Src/dxl_recovery.o ./Core/Src/dxl_recovery.su ./Core/Src/dxl_sched.cyclo ./Core/Src/dxl_sched.d ./Core/Src/dxl_sched.o ./Core/Src/dxl_sched.su ./Core/Src/dxl_status.cyclo ./Core/Src/dxl_status.d ./Core/Src/dxl_status.o ./Core/Src/dxl_status.su ./Core/Src/gpio.cyclo ./Core/Src/gpio.d ./Core/Src/gpio.o ./Core/Src/gpio.su ./Core/Src/imu_driver.cyclo ./Core/Src/imu_driver.d ./Core/Src/imu_driver.o ./Core/Src/imu_driver.su ./Core/Src/imu_ebimu.cyclo ./Core/Src/imu_ebimu.d ./Core/Src/imu_ebimu.o ./Core/Src/imu_ebimu.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/robot_topology.cyclo ./Core/Src/robot_topology.d ./Core/Src/robot_topology.o ./Core/Src/robot_topology.su ./Core/Src/stm32h7xx_hal_msp.cyclo ./Core/Src/stm32h7xx_hal_msp.d ./Core/Src/stm32h7xx_hal_msp.o ./Core/Src/stm32h7xx_hal_msp.su ./Core/Src/stm32h7xx_it.cyclo ./Core/Src/stm32h7xx_it.d ./Core/Src/stm32h7xx_it.o ./Core/Src/stm32h7xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32h7xx.cyclo ./Core/Src/system_stm32h7xx.d ./Core/Src/system_stm32h7xx.o ./Core/Src/system_stm32h7xx.su ./Core/Src/usart.cyclo ./Core/Src/usart.d ./Core/Src/usart.o ./Core/Src/usart.su
 
 .PHONY: clean-Core-2f-Src
 
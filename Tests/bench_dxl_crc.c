@@ -0,0 +1,60 @@
+/*
+ * bench_dxl_crc.c
+ * Description: dxl_crc 소프트웨어 엔진별 호스트 처리 시간 비교 (패킷 길이별 ns/패킷)
+ * Note: 보드 수치는 Debug 빌드 부팅 시 DXL_CRC_Benchmark 결과(main.c의 crc_bench)를 확인
+ *       호스트 수치는 엔진 간 상대 비교용 (캐시/분기 예측이 Cortex-M7과 다름)
+ */
+#include "dxl_crc.h"
+#include "host_test.h"
+#include <stdlib.h>
+
+typedef uint16_t (*crc_fn_t)(uint16_t, const uint8_t*, uint16_t);
+
+static const struct {
+	const char *name;
+	crc_fn_t fn;
+} engines[] = {
+		{ "byte", DXL_CRC_Update_Byte },
+		{ "slice4", DXL_CRC_Update_Slice4 },
+		{ "slice8", DXL_CRC_Update_Slice8 },
+};
+#define ENGINE_COUNT (sizeof(engines) / sizeof(engines[0]))
+
+// 측정 길이: Ping, 바퀴 Sync Write, 관절 8개 Sync Write (DXL_CRC_Benchmark와 같은 길이), Indirect 명령, 최대 버스트
+static const uint16_t lengths[] = { 8, 26, 52, 132, 256 };
+#define LENGTH_COUNT (sizeof(lengths) / sizeof(lengths[0]))
+
+int main(int argc, char **argv) {
+	uint32_t iterations = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 10) : 2000000;
+	static uint8_t buf[256];
+	volatile uint16_t sink = 0;
+
+	for (unsigned i = 0; i < sizeof(buf); i++)
+		buf[i] = (uint8_t) (i * 37u + 0xFD);
+
+	printf("%-8s", "len");
+	for (unsigned e = 0; e < ENGINE_COUNT; e++)
+		printf("%12s", engines[e].name);
+	printf("   (ns/packet, %u회 평균)\n", iterations);
+
+	for (unsigned l = 0; l < LENGTH_COUNT; l++) {
+		printf("%-8u", lengths[l]);
+		for (unsigned e = 0; e < ENGINE_COUNT; e++) {
+			uint16_t crc = 0;
+			uint64_t start = host_now_ns();
+			for (uint32_t n = 0; n < iterations; n++)
+				crc = engines[e].fn(crc, buf, lengths[l]); // 앞 결과를 이어받아 루프 밖으로 빼지 못하게 함
+			uint64_t ns = host_now_ns() - start;
+			sink ^= crc;
+			printf("%12.2f", (double) ns / iterations);
+		}
+		printf("\n");
+	}
+
+	// 보드용 벤치마크 함수도 같은 코드 경로로 실행해 엔진 결과 일치 여부 확인 (사이클 값은 호스트에서 0)
+	DXL_CRC_Bench_t bench;
+	DXL_CRC_Benchmark(&bench, 1000);
+	printf("DXL_CRC_Benchmark: frame_len=%u match=%u\n", bench.frame_len, bench.match);
+	(void) sink;
+	return bench.match ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+/*
+ * bench_dxl_sync.cpp
+ * Description: 관절 위치 Sync Write 큐 추가 시간 비교 (C 경로 send_sync_write_joints / C++ JointPositionWrite, ns/패킷)
+ * C++ 경로가 C 경로 + 허용 오차보다 느리면 실패 (컴파일 시점 생성의 이점이 사라진 회귀)
+ * 사용법: bench_dxl_sync [iterations] [tolerance_%]  (기본 2000000회, 10%)
+ * Note: 보드 수치는 bench_joint_write() (DWT 사이클)로 확인, 호스트 수치는 두 경로의 상대 비교용
+ */
+#include "dxl_sync.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" {
+#include "host_bus.h"
+#include "host_test.h"
+}
+
+using namespace dxl;
+
+#define ROUNDS 5 // 회차별 최솟값 사용 (다른 프로세스로 인한 튐 제외)
+
+// 값 기록 + CRC + 송신 큐 복사 시간 (송신 자체와 host_bus 통계 초기화는 제외)
+static uint64_t time_c(uint32_t *goals, uint32_t iterations) {
+	uint64_t start = host_now_ns();
+	for (uint32_t n = 0; n < iterations; n++) {
+		goals[0] = n & 4095;
+		send_sync_write_joints(goals);
+		host_bus_tx_len = 0;
+	}
+	return host_now_ns() - start;
+}
+
+static uint64_t time_cpp(uint32_t *goals, uint32_t iterations) {
+	JointPositionWrite w;
+	uint64_t start = host_now_ns();
+	for (uint32_t n = 0; n < iterations; n++) {
+		goals[0] = n & 4095;
+		for (std::size_t j = 0; j < JOINT_COUNT; j++)
+			w.set(j, Ticks { static_cast<int32_t>(goals[j]) });
+		w.queue();
+		host_bus_tx_len = 0;
+	}
+	return host_now_ns() - start;
+}
+
+int main(int argc, char **argv) {
+	uint32_t iterations = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 2000000;
+	double tolerance = (argc > 2) ? std::atof(argv[2]) : 10.0;
+	uint32_t goals[JOINT_COUNT];
+	uint64_t best_c = UINT64_MAX, best_cpp = UINT64_MAX;
+
+	if (iterations == 0)
+		iterations = 1;
+	for (int j = 0; j < JOINT_COUNT; j++)
+		goals[j] = 2048 + 10 * j;
+
+	DXL_Init();
+	host_bus_reset();
+	for (int r = 0; r < ROUNDS; r++) {
+		uint64_t c = time_c(goals, iterations);
+		uint64_t cpp = time_cpp(goals, iterations);
+		if (c < best_c)
+			best_c = c;
+		if (cpp < best_cpp)
+			best_cpp = cpp;
+	}
+	host_bus_reset();
+
+	double c_ns = static_cast<double>(best_c) / iterations;
+	double cpp_ns = static_cast<double>(best_cpp) / iterations;
+	std::printf("joint position Sync Write (%u joints, %u회 x %d): C %.1f ns/frame, C++ %.1f ns/frame (허용 C + %.0f%%)\n",
+			JOINT_COUNT, iterations, ROUNDS, c_ns, cpp_ns, tolerance);
+	CHECK(cpp_ns <= c_ns * (1.0 + tolerance / 100.0));
+
+	std::printf("bench_dxl_sync: %s\n", host_test_failures ? "FAIL" : "OK");
+	return host_test_failures != 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * bench_ebimu.c
+ * Description: imu_ebimu 파서 호스트 처리 시간 비교 (기존 newlib 방식 / EBIMU_Parse_Ascii / EBIMU_Parse_Binary, ns/프레임)
+ * Note: 보드 수치는 Debug 빌드 부팅 시 EBIMU_Benchmark 결과(main.c의 imu_bench)를 확인
+ *       호스트 수치는 방식 간 상대 비교용 (glibc strtof는 newlib보다 빠름)
+ */
+#include "imu_ebimu.h"
+#include "host_test.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 기존 IMU_Process_Data()의 방식 (EBIMU_Benchmark의 비교 기준과 같은 코드)
+static void parse_libc(const uint8_t *frame, uint16_t len, IMU_Data_t *out) {
+	char buf[IMU_FRAME_MAX + 1];
+	memcpy(buf, frame, len);
+	buf[len] = '\0';
+
+	char *start_ptr = strrchr(buf, '*');
+	if (start_ptr == NULL)
+		return;
+	start_ptr++;
+
+	char *context = NULL;
+	char *token = strtok_r(start_ptr, ",", &context);
+	if (token != NULL) out->roll = strtof(token, NULL);
+	token = strtok_r(NULL, ",", &context);
+	if (token != NULL) out->pitch = strtof(token, NULL);
+	token = strtok_r(NULL, ",", &context);
+	if (token != NULL) out->yaw = strtof(token, NULL);
+}
+
+// 측정 프레임: 짧은 값 / 보통 값 / 자릿수 최대
+static const char *frames[] = { "*0.0,0.0,0.0", "*-12.34,5.67,178.90", "*-179.9999,-89.99999,359.9999" };
+#define FRAME_COUNT (sizeof(frames) / sizeof(frames[0]))
+
+int main(int argc, char **argv) {
+	uint32_t iterations = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 10) : 2000000;
+	static const uint8_t bin[EBIMU_BIN_FRAME_LEN] = {
+			0x55, 0x55, 0xFB, 0x2E, 0x02, 0x37, 0x45, 0xE2, 0x03, 0x33 };
+	IMU_Data_t data;
+	volatile float sink = 0;
+
+	printf("%-32s%12s%12s   (ns/frame, %u회 평균)\n", "frame", "libc", "fast", iterations);
+	for (unsigned f = 0; f < FRAME_COUNT; f++) {
+		const uint8_t *p = (const uint8_t*) frames[f];
+		uint16_t len = (uint16_t) strlen(frames[f]);
+
+		uint64_t start = host_now_ns();
+		for (uint32_t n = 0; n < iterations; n++) {
+			parse_libc(p, len, &data);
+			sink += data.yaw;
+		}
+		uint64_t ns_libc = host_now_ns() - start;
+
+		start = host_now_ns();
+		for (uint32_t n = 0; n < iterations; n++) {
+			EBIMU_Parse_Ascii(&p[1], len - 1, &data);
+			sink += data.yaw;
+		}
+		uint64_t ns_fast = host_now_ns() - start;
+
+		printf("%-32s%12.2f%12.2f\n", frames[f], (double) ns_libc / iterations, (double) ns_fast / iterations);
+	}
+
+	uint64_t start = host_now_ns();
+	for (uint32_t n = 0; n < iterations; n++) {
+		EBIMU_Parse_Binary(bin, sizeof(bin), &data);
+		sink += data.yaw;
+	}
+	printf("%-32s%24.2f\n", "binary (10 B)", (double) (host_now_ns() - start) / iterations);
+
+	// 보드용 벤치마크 함수도 같은 코드 경로로 실행해 세 방식의 결과 일치 여부 확인 (사이클 값은 호스트에서 0)
+	EBIMU_Bench_t bench;
+	EBIMU_Benchmark(&bench, 1000);
+	printf("EBIMU_Benchmark: frame_len=%u match=%u\n", bench.frame_len, bench.match);
+	(void) sink;
+	return bench.match ? 0 : 1;
+}
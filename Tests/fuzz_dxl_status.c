@@ -0,0 +1,214 @@
+/*
+ * fuzz_dxl_status.c
+ * Description: dxl_status 스트리밍 디코더 퍼저 하니스 (libFuzzer 진입점 LLVMFuzzerTestOneInput)
+ * 입력 바이트를 "프레임 만들기 명령"으로 해석해 선로 바이트열을 만들고, 임의 크기 구간으로 잘라 디코더에 공급
+ *   - 정상 상태 패킷 / 송신 에코(2.0 명령 패킷, 1.0 패킷) / 끊긴 프레임 / 잡음 / CRC 오류 프레임
+ * 검사 항목
+ *   - used/반환값 규약, params가 현재 구간 또는 디코더 내부 버퍼 안을 가리키는지 (구간은 정확한 크기로 할당 -> ASan)
+ *   - 디코딩된 패킷을 기준 인코더로 다시 만들면 선로 바이트열의 그 위치(끝 = 소비 위치)와 같아야 함
+ *   - 온전한 프레임(또는 스트림 시작) 바로 뒤의 정상 상태 패킷은 하나도 빠짐없이 나와야 함
+ */
+#include "dxl_status.h"
+#include "host_test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STREAM_MAX 16384
+#define EXPECT_MAX 1024
+#define FRAME_MAX  (11 + 2 * DXL_STATUS_MAX_PARAMS + 8)
+
+// 입력 읽기 (끝나면 0)
+typedef struct {
+	const uint8_t *p;
+	size_t n;
+} Input_t;
+
+static uint8_t rd(Input_t *in) {
+	if (in->n == 0)
+		return 0;
+	in->n--;
+	return *in->p++;
+}
+
+// 파라미터 바이트: 절반은 FF/FD로 몰아 스터핑 패턴이 자주 나오게 함
+static uint8_t rd_param(Input_t *in) {
+	uint8_t v = rd(in);
+	if (v & 0x80)
+		return (v & 1) ? 0xFF : 0xFD;
+	return rd(in);
+}
+
+// 기준 2.0 인코더: INST ~ PARAM 구간에서 FF FF FD가 나오면 FD 추가 (err < 0이면 Error 필드 없음)
+static uint16_t ref_frame(uint8_t *o, uint8_t id, uint8_t inst, int err, const uint8_t *p, uint16_t n) {
+	uint16_t k = 7;
+	o[0] = 0xFF;
+	o[1] = 0xFF;
+	o[2] = 0xFD;
+	o[3] = 0x00;
+	o[4] = id;
+	o[k++] = inst;
+	if (err >= 0)
+		o[k++] = (uint8_t) err;
+	for (uint16_t i = 0; i < n; i++) {
+		o[k++] = p[i];
+		if (k - 7 >= 3 && o[k - 3] == 0xFF && o[k - 2] == 0xFF && o[k - 1] == 0xFD)
+			o[k++] = 0xFD;
+	}
+	uint16_t len = (uint16_t) (k - 7 + 2);
+	o[5] = (uint8_t) len;
+	o[6] = (uint8_t) (len >> 8);
+	uint16_t crc = host_ref_crc(0, o, k);
+	o[k++] = (uint8_t) crc;
+	o[k++] = (uint8_t) (crc >> 8);
+	return k;
+}
+
+// 길이 필드가 디코더 상한 안인지 (넘으면 길이 직후부터 헤더를 다시 찾으므로 본문 끝과 CRC가 가짜 헤더가 될 수 있음)
+#define LEN_OK(f) (((f)[5] | (f)[6] << 8) <= DXL_STATUS_MAX_PARAMS + 4)
+
+static uint8_t stream[STREAM_MAX];
+static uint16_t stream_len;
+static uint16_t expect_end[EXPECT_MAX]; // 반드시 나와야 하는 상태 패킷의 끝 위치
+static uint16_t expect_count;
+
+static void emit(const uint8_t *d, uint16_t n) {
+	memcpy(&stream[stream_len], d, n);
+	stream_len += n;
+}
+
+// 입력 명령으로 선로 바이트열 생성
+static void build_stream(Input_t *in) {
+	static const uint8_t echo_inst[] = { 0x83, 0x82, 0x8A, 0x03, 0x02, 0x01, 0x08, 0x55 };
+	uint8_t frame[FRAME_MAX], p[DXL_STATUS_MAX_PARAMS];
+	uint8_t clean = 1; // 1: 직전 프레임이 온전히 끝남 (다음 상태 패킷은 반드시 디코딩되어야 함)
+
+	stream_len = 0;
+	expect_count = 0;
+	while (in->n && stream_len + FRAME_MAX <= STREAM_MAX && expect_count < EXPECT_MAX) {
+		uint8_t op = rd(in) % 6;
+		uint8_t id = rd(in);
+		uint16_t n = rd(in) % (DXL_STATUS_MAX_PARAMS + 1);
+		for (uint16_t i = 0; i < n; i++)
+			p[i] = rd_param(in);
+
+		switch (op) {
+		case 0: { // 정상 상태 패킷
+			uint16_t k = ref_frame(frame, id, DXL_INST_STATUS, rd(in), p, n);
+			emit(frame, k);
+			if (clean && LEN_OK(frame))
+				expect_end[expect_count++] = stream_len;
+			clean = LEN_OK(frame);
+			break;
+		}
+		case 1: { // 송신 에코 (2.0 명령 패킷, Error 필드 없음)
+			uint8_t inst = echo_inst[rd(in) % sizeof(echo_inst)];
+			uint16_t k = ref_frame(frame, id, inst, -1, p, n);
+			emit(frame, k);
+			clean = LEN_OK(frame);
+			break;
+		}
+		case 2: { // 끊긴 상태 패킷
+			uint16_t k = ref_frame(frame, id, DXL_INST_STATUS, rd(in), p, n);
+			emit(frame, (uint16_t) (1 + rd(in) % (k - 1)));
+			clean = 0;
+			break;
+		}
+		case 3: // 잡음 (파라미터 바이트를 그대로)
+			emit(p, n % 16);
+			clean = 0;
+			break;
+		case 4: { // 1.0 패킷 에코 (바퀴 AX-12): FF FF ID LEN INST PARAM... CKSUM
+			uint8_t m = (uint8_t) (n % 16);
+			uint8_t sum = 0;
+			frame[0] = 0xFF;
+			frame[1] = 0xFF;
+			frame[2] = id;
+			frame[3] = (uint8_t) (m + 2);
+			frame[4] = 0x03;
+			memcpy(&frame[5], p, m);
+			for (uint8_t i = 2; i < 5 + m; i++)
+				sum += frame[i];
+			frame[5 + m] = (uint8_t) ~sum;
+			emit(frame, (uint16_t) (6 + m));
+			clean = 0;
+			break;
+		}
+		default: { // CRC 오류 상태 패킷 (길이만큼 받은 뒤 버려지므로 다음 프레임은 영향 없음)
+			uint16_t k = ref_frame(frame, id, DXL_INST_STATUS, rd(in), p, n);
+			frame[k - 1 - (rd(in) & 1)] ^= (uint8_t) (1u << (rd(in) & 7));
+			emit(frame, k);
+			clean = LEN_OK(frame);
+			break;
+		}
+		}
+	}
+}
+
+#define FUZZ_ASSERT(cond) do { \
+	if (!(cond)) { \
+		fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+		abort(); \
+	} \
+} while (0)
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	static DXL_Status_Parser_t parser;
+	Input_t in = { data, size };
+	uint32_t split = 0x9E3779B9u ^ rd(&in) ^ ((uint32_t) rd(&in) << 8);
+	uint8_t max_chunk = rd(&in);
+
+	build_stream(&in);
+	DXL_Status_Init(&parser);
+
+	uint16_t pos = 0, next_expect = 0;
+	while (pos < stream_len) {
+		// 구간 크기: 1바이트 ~ 최대 max_chunk+1 (DMA 링에서 Peek로 받는 연속 구간을 흉내)
+		split = split * 1664525u + 1013904223u;
+		uint16_t chunk = (uint16_t) (1 + (split >> 16) % ((uint16_t) max_chunk + 1));
+		if (chunk > stream_len - pos)
+			chunk = stream_len - pos;
+		uint8_t *buf = malloc(chunk);
+		memcpy(buf, &stream[pos], chunk);
+
+		uint16_t off = 0;
+		while (off < chunk) {
+			DXL_Status_Packet_t pkt;
+			uint16_t used = 0xFFFF;
+			uint8_t got = DXL_Status_Parse(&parser, &buf[off], chunk - off, &used, &pkt);
+			FUZZ_ASSERT(used <= chunk - off);
+			FUZZ_ASSERT(got ? used > 0 : used == chunk - off);
+			off += used;
+			if (!got)
+				continue;
+
+			// params 위치와 길이
+			FUZZ_ASSERT(pkt.param_len <= DXL_STATUS_MAX_PARAMS);
+			if (pkt.param_len) {
+				uint8_t in_chunk = (pkt.params >= buf && pkt.params + pkt.param_len <= &buf[off]);
+				uint8_t in_parser = (pkt.params >= parser.params
+						&& pkt.params + pkt.param_len <= parser.params + DXL_STATUS_MAX_PARAMS);
+				FUZZ_ASSERT(in_chunk || in_parser);
+			}
+
+			// 다시 인코딩한 프레임이 선로의 그 위치에 실제로 있어야 함
+			uint8_t frame[FRAME_MAX];
+			uint16_t end = (uint16_t) (pos + off);
+			uint16_t k = ref_frame(frame, pkt.id, DXL_INST_STATUS, pkt.error, pkt.params, pkt.param_len);
+			FUZZ_ASSERT(k <= end && memcmp(frame, &stream[end - k], k) == 0);
+
+			// 반드시 나와야 하는 패킷을 건너뛰지 않았는지 (끝 위치 순서로 확인)
+			while (next_expect < expect_count && expect_end[next_expect] < end) {
+				fprintf(stderr, "빠진 상태 패킷: 끝 위치 %u\n", expect_end[next_expect]);
+				abort();
+			}
+			if (next_expect < expect_count && expect_end[next_expect] == end)
+				next_expect++;
+		}
+		free(buf);
+		pos += chunk;
+	}
+
+	FUZZ_ASSERT(next_expect == expect_count);
+	return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * fuzz_ebimu.c
+ * Description: imu_ebimu 파서 퍼저 하니스 (libFuzzer 진입점 LLVMFuzzerTestOneInput)
+ * 입력 첫 바이트로 대상을 고름
+ *   - ASCII (입력 그대로): 임의 바이트 -> 대부분 오류 경로
+ *   - ASCII (필드 조립): 입력 바이트로 공백/부호/자릿수/소수점 위치/구분자를 골라 정상 프레임과 경계 형식이 자주 나오게 함
+ *   - 바이너리: SOP/체크섬을 입력에 따라 맞추거나 깨뜨린 프레임, 임의 길이
+ * 검사 항목
+ *   - 기준 문법(엄격한 형식 검사 + strtof)과 성공/실패가 같고, 성공 시 세 값이 strtof 결과와 비트 단위로 같음
+ *   - 실패 시 출력을 건드리지 않음, 입력은 정확한 크기로 할당 -> 범위 밖 읽기는 ASan
+ */
+#include "imu_ebimu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_ASSERT(cond) do { \
+	if (!(cond)) { \
+		fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+		abort(); \
+	} \
+} while (0)
+
+// 기준 ASCII 문법: 필드 3개를 콤마로 구분, 필드 = 공백* [+-] (숫자 [. 숫자*] | . 숫자) 공백*
+// 숫자는 합쳐서 1 ~ EBIMU_MAX_DIGITS개, 절대값 EBIMU_ANGLE_LIMIT 이하 / 값은 필드 문자열을 strtof로 변환
+static int ref_parse_ascii(const uint8_t *p, uint16_t len, float *v) {
+	uint16_t i = 0;
+
+	for (int f = 0; f < EBIMU_ASCII_FIELDS; f++) {
+		char text[EBIMU_MAX_DIGITS + 3];
+		uint16_t n = 0, digits = 0;
+		uint8_t dot = 0;
+
+		while (i < len && p[i] == ' ')
+			i++;
+		if (i < len && (p[i] == '-' || p[i] == '+'))
+			text[n++] = (char) p[i++];
+		for (; i < len; i++) {
+			if (p[i] >= '0' && p[i] <= '9') {
+				if (++digits > EBIMU_MAX_DIGITS)
+					return 0;
+			} else if (p[i] == '.' && !dot) {
+				dot = 1;
+			} else {
+				break;
+			}
+			text[n++] = (char) p[i];
+		}
+		if (digits == 0)
+			return 0;
+		text[n] = '\0';
+		while (i < len && p[i] == ' ')
+			i++;
+		if (f < EBIMU_ASCII_FIELDS - 1) {
+			if (i >= len || p[i] != ',')
+				return 0;
+			i++;
+		}
+
+		char *end;
+		v[f] = strtof(text, &end);
+		if (*end != '\0' || v[f] > EBIMU_ANGLE_LIMIT || v[f] < -EBIMU_ANGLE_LIMIT)
+			return 0;
+	}
+	return i == len;
+}
+
+static void check_ascii(const uint8_t *p, uint16_t len) {
+	static const IMU_Data_t sentinel = { 1234.5f, -1234.5f, 999.0f };
+	IMU_Data_t out = sentinel;
+	float want[EBIMU_ASCII_FIELDS];
+
+	uint8_t *buf = malloc(len ? len : 1);
+	memcpy(buf, p, len);
+	EBIMU_Result_t r = EBIMU_Parse_Ascii(buf, len, &out);
+	free(buf);
+
+	FUZZ_ASSERT(r <= EBIMU_ERR_RANGE);
+	if (ref_parse_ascii(p, len, want)) {
+		FUZZ_ASSERT(r == EBIMU_OK);
+		FUZZ_ASSERT(memcmp(&out.roll, &want[0], sizeof(float)) == 0);
+		FUZZ_ASSERT(memcmp(&out.pitch, &want[1], sizeof(float)) == 0);
+		FUZZ_ASSERT(memcmp(&out.yaw, &want[2], sizeof(float)) == 0);
+	} else {
+		FUZZ_ASSERT(r != EBIMU_OK);
+		FUZZ_ASSERT(memcmp(&out, &sentinel, sizeof(out)) == 0);
+	}
+}
+
+static void check_binary(const uint8_t *p, uint16_t len) {
+	static const IMU_Data_t sentinel = { 1234.5f, -1234.5f, 999.0f };
+	IMU_Data_t out = sentinel;
+
+	uint8_t *buf = malloc(len ? len : 1);
+	memcpy(buf, p, len);
+	EBIMU_Result_t r = EBIMU_Parse_Binary(buf, len, &out);
+	free(buf);
+
+	uint8_t ok = (len == EBIMU_BIN_FRAME_LEN && p[0] == EBIMU_BIN_SOP && p[1] == EBIMU_BIN_SOP);
+	if (ok) {
+		uint32_t sum = 0;
+		for (int i = 0; i < 8; i++)
+			sum += p[i];
+		ok = ((sum & 0xFFFF) == ((uint32_t) p[8] << 8 | p[9]));
+	}
+	if (ok) {
+		FUZZ_ASSERT(r == EBIMU_OK);
+		FUZZ_ASSERT(out.roll == (float) (int16_t) (p[2] << 8 | p[3]) / EBIMU_BIN_DIV);
+		FUZZ_ASSERT(out.pitch == (float) (int16_t) (p[4] << 8 | p[5]) / EBIMU_BIN_DIV);
+		FUZZ_ASSERT(out.yaw == (float) (int16_t) (p[6] << 8 | p[7]) / EBIMU_BIN_DIV);
+	} else {
+		FUZZ_ASSERT(r == EBIMU_ERR_CHECKSUM);
+		FUZZ_ASSERT(memcmp(&out, &sentinel, sizeof(out)) == 0);
+	}
+}
+
+// 입력 읽기 (끝나면 0)
+typedef struct {
+	const uint8_t *p;
+	size_t n;
+} Input_t;
+
+static uint8_t rd(Input_t *in) {
+	if (in->n == 0)
+		return 0;
+	in->n--;
+	return *in->p++;
+}
+
+// 필드 EBIMU_ASCII_FIELDS개 안팎을 조립 (자릿수 0 ~ EBIMU_MAX_DIGITS+1, 가끔 잘못된 문자/구분자)
+static uint16_t build_ascii(Input_t *in, uint8_t *o, uint16_t max) {
+	static const char odd[] = "-+.,*\r\n\t x";
+	uint16_t k = 0;
+	uint8_t sel = rd(in) % 8;
+	uint8_t fields = (sel == 0) ? EBIMU_ASCII_FIELDS - 1 : (sel == 1) ? EBIMU_ASCII_FIELDS + 1 : EBIMU_ASCII_FIELDS;
+
+	for (uint8_t f = 0; f < fields && k + 24 < max; f++) {
+		uint8_t ctl = rd(in);
+		uint8_t digits = rd(in) % (EBIMU_MAX_DIGITS + 2);
+		uint8_t dot_at = rd(in) % (digits + 2); // digits+1이면 소수점 없음
+
+		for (uint8_t s = 0; s < (ctl & 0x03); s++)
+			o[k++] = ' ';
+		if (ctl & 0x04)
+			o[k++] = (ctl & 0x08) ? '-' : '+';
+		for (uint8_t d = 0; d <= digits; d++) {
+			if (d == dot_at)
+				o[k++] = '.';
+			if (d < digits)
+				o[k++] = (uint8_t) ('0' + rd(in) % 10);
+		}
+		if (ctl & 0x10)
+			o[k++] = ' ';
+		if ((ctl & 0xE0) == 0xE0) // 1/8: 잘못된 문자 삽입
+			o[k++] = (uint8_t) odd[rd(in) % (sizeof(odd) - 1)];
+		if (f + 1 < fields)
+			o[k++] = ',';
+	}
+	return k;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	uint8_t frame[IMU_FRAME_MAX * 2];
+
+	if (size == 0)
+		return 0;
+	uint8_t mode = data[0] % 3;
+	data++;
+	size--;
+	if (size > sizeof(frame))
+		size = sizeof(frame);
+
+	switch (mode) {
+	case 0:
+		check_ascii(data, (uint16_t) size);
+		break;
+	case 1: { // 필드 조립
+		Input_t in = { data, size };
+		check_ascii(frame, build_ascii(&in, frame, sizeof(frame)));
+		break;
+	}
+	default: { // 바이너리: 첫 바이트 비트로 SOP/체크섬 보정 여부 결정, 길이는 대부분 정상
+		if (size == 0)
+			return 0;
+		uint8_t ctl = data[0];
+		uint16_t len = (ctl & 0x08) ? (uint16_t) (size - 1) : EBIMU_BIN_FRAME_LEN;
+		memset(frame, 0, sizeof(frame));
+		memcpy(frame, &data[1], (size - 1 < len) ? size - 1 : len);
+		if (len >= EBIMU_BIN_FRAME_LEN) {
+			if (!(ctl & 0x01)) {
+				frame[0] = EBIMU_BIN_SOP;
+				frame[1] = EBIMU_BIN_SOP;
+			}
+			if (!(ctl & 0x02)) {
+				uint16_t sum = 0;
+				for (int i = 0; i < 8; i++)
+					sum += frame[i];
+				frame[8] = (uint8_t) (sum >> 8);
+				frame[9] = (uint8_t) sum;
+			}
+		}
+		check_binary(frame, len);
+		break;
+	}
+	}
+	return 0;
+}
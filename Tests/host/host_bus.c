@@ -0,0 +1,103 @@
+/*
+ * host_bus.c (호스트 테스트용)
+ * Description: dxl_bus.h / dxl_estop.h 중 dxl_2_0.c가 쓰는 함수의 기록용 구현
+ */
+#include "host_bus.h"
+#include "dxl_estop.h"
+#include <string.h>
+
+uint8_t host_bus_tx[HOST_BUS_TX_SIZE];
+uint16_t host_bus_tx_len;
+uint16_t host_bus_frames;
+uint16_t host_bus_slot_overflows;
+
+static uint8_t host_bus_rx[HOST_BUS_RX_SIZE];
+static uint16_t host_bus_rx_len, host_bus_rx_pos;
+static DXL_Bus_Stats_t host_bus_stats;
+static uint16_t host_bus_slot_max; // 마지막 Slot_Acquire 요청 크기
+
+void host_bus_reset(void) {
+	host_bus_tx_len = 0;
+	host_bus_frames = 0;
+	host_bus_slot_overflows = 0;
+	host_bus_rx_len = host_bus_rx_pos = 0;
+	memset(&host_bus_stats, 0, sizeof(host_bus_stats));
+}
+
+void host_bus_rx_push(const uint8_t *data, uint16_t len) {
+	if (len > HOST_BUS_RX_SIZE - host_bus_rx_len)
+		len = HOST_BUS_RX_SIZE - host_bus_rx_len;
+	memcpy(&host_bus_rx[host_bus_rx_len], data, len);
+	host_bus_rx_len += len;
+}
+
+// 슬롯은 송신 기록의 끝을 그대로 빌려줌 (Commit한 길이만큼만 기록으로 남음)
+uint8_t* DXL_Bus_Slot_Acquire(uint16_t max_size) {
+	if (max_size > HOST_BUS_TX_SIZE - host_bus_tx_len)
+		return NULL;
+	host_bus_slot_max = max_size;
+	return &host_bus_tx[host_bus_tx_len];
+}
+
+void DXL_Bus_Slot_Commit(uint16_t size) {
+	if (size > host_bus_slot_max)
+		host_bus_slot_overflows++;
+	host_bus_tx_len += size;
+	host_bus_frames++;
+	host_bus_stats.tx_frames++;
+	host_bus_stats.tx_bytes += size;
+}
+
+HAL_StatusTypeDef DXL_Bus_Enqueue(const uint8_t *data, uint16_t size) {
+	uint8_t *slot = DXL_Bus_Slot_Acquire(size);
+	if (slot == NULL) {
+		host_bus_stats.tx_dropped++;
+		return HAL_ERROR;
+	}
+	memcpy(slot, data, size);
+	DXL_Bus_Slot_Commit(size);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef DXL_Bus_Flush(void) {
+	host_bus_stats.tx_bursts++;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef DXL_Bus_Transmit(const uint8_t *data, uint16_t size) {
+	if (DXL_Bus_Enqueue(data, size) != HAL_OK)
+		return HAL_ERROR;
+	return DXL_Bus_Flush();
+}
+
+HAL_StatusTypeDef DXL_Bus_Wait_Idle(uint32_t timeout_ms) {
+	(void) timeout_ms;
+	return HAL_OK;
+}
+
+DXL_Bus_Stats_t DXL_Bus_Get_Stats(void) {
+	return host_bus_stats;
+}
+
+uint32_t DXL_Bus_Get_Baud(void) {
+	return 1000000;
+}
+
+uint16_t DXL_Bus_Rx_Peek(const uint8_t **data) {
+	*data = &host_bus_rx[host_bus_rx_pos];
+	return host_bus_rx_len - host_bus_rx_pos;
+}
+
+void DXL_Bus_Rx_Consume(uint16_t n) {
+	host_bus_rx_pos += n;
+	host_bus_stats.rx_bytes += n;
+	if (host_bus_rx_pos >= host_bus_rx_len)
+		host_bus_rx_len = host_bus_rx_pos = 0;
+}
+
+void DXL_Bus_Rx_Discard(void) {
+	host_bus_rx_len = host_bus_rx_pos = 0;
+}
+
+void DXL_Estop_Trigger(void) {
+}
@@ -0,0 +1,32 @@
+/*
+ * host_bus.h (호스트 테스트용)
+ * Description: dxl_bus 송수신 API 대체 - 송신 패킷을 버퍼에 순서대로 기록하고, 수신은 테스트가 넣은 바이트를 돌려줌
+ */
+
+#ifndef HOST_BUS_H_
+#define HOST_BUS_H_
+
+#include "dxl_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_BUS_TX_SIZE 8192
+#define HOST_BUS_RX_SIZE 4096
+
+extern uint8_t host_bus_tx[HOST_BUS_TX_SIZE]; // 큐에 들어온 패킷들을 이어 붙인 바이트열 (Flush 여부와 무관)
+extern uint16_t host_bus_tx_len;
+extern uint16_t host_bus_frames;              // 큐에 들어온 패킷 수
+extern uint16_t host_bus_slot_overflows;      // Slot_Acquire로 요청한 크기보다 많이 Commit한 횟수 (0이어야 함)
+
+// 송신 기록/수신 버퍼 비우기
+void host_bus_reset(void);
+// 수신 버퍼 뒤에 바이트 추가 (모터 응답 흉내)
+void host_bus_rx_push(const uint8_t *data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_BUS_H_ */
@@ -0,0 +1,71 @@
+/*
+ * host_hal.c (호스트 테스트용)
+ * Description: stm32h7xx_hal.h(호스트용)에 선언한 레지스터 변수와 HAL 함수 대체 구현
+ */
+#include "main.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+GPIO_TypeDef host_gpioa, host_gpiob;
+CRC_TypeDef host_crc;
+CoreDebug_Type host_core_debug;
+DWT_Type host_dwt;
+uint32_t host_primask;
+uint32_t host_tick;
+uint32_t SystemCoreClock = 480000000;
+
+uint32_t HAL_GetTick(void) {
+	return host_tick;
+}
+
+void HAL_Delay(uint32_t delay) {
+	host_tick += delay;
+}
+
+// ---------------------------------------------------------------------------
+// CRC 주변장치 모델 (RM0433 CRC 계산 유닛 중 dxl_crc가 쓰는 동작만)
+//   - CR에 RESET을 쓰면 DR = INIT (RESET 비트는 바로 0으로 돌아옴)
+//   - DR에 쓰면 쓴 크기만큼 (32비트: 4바이트, 16비트: 2바이트, 8비트: 1바이트) 상위 바이트부터 계산
+//   - 16비트 다항식(POLYSIZE=01), 입출력 비반사만 지원 (다른 설정은 모델이 없으므로 중단)
+// ---------------------------------------------------------------------------
+
+uint8_t host_crc_fault;
+
+static void host_crc_feed_byte(uint8_t byte) {
+	uint16_t crc = (uint16_t) host_crc.DR ^ (uint16_t) (byte << 8);
+	for (int b = 0; b < 8; b++)
+		crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ host_crc.POL) : (uint16_t) (crc << 1);
+	host_crc.DR = crc;
+}
+
+static void host_crc_write_dr(size_t size, uint32_t value) {
+	if ((host_crc.CR & CRC_CR_POLYSIZE) != CRC_CR_POLYSIZE_0 || (host_crc.CR & (CRC_CR_REV_IN | CRC_CR_REV_OUT))) {
+		fprintf(stderr, "CRC 모델: 지원하지 않는 설정 CR=0x%08X\n", (unsigned) host_crc.CR);
+		abort();
+	}
+	for (size_t i = size; i-- > 0;)
+		host_crc_feed_byte((uint8_t) (value >> (8 * i)));
+	if (host_crc_fault)
+		host_crc.DR ^= 1u;
+}
+
+void host_write_reg(volatile void *reg, size_t size, uint32_t value) {
+	if (reg == &host_crc.DR) {
+		host_crc_write_dr(size, value);
+	} else if (reg == &host_crc.CR) {
+		host_crc.CR = value & ~CRC_CR_RESET;
+		if (value & CRC_CR_RESET)
+			host_crc.DR = host_crc.INIT;
+	} else if (size == 4) {
+		*(volatile uint32_t*) reg = value;
+	} else if (size == 2) {
+		*(volatile uint16_t*) reg = (uint16_t) value;
+	} else {
+		*(volatile uint8_t*) reg = (uint8_t) value;
+	}
+}
+
+void Error_Handler(void) {
+	fprintf(stderr, "Error_Handler\n");
+	abort();
+}
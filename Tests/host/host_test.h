@@ -0,0 +1,58 @@
+/*
+ * host_test.h (호스트 테스트용)
+ * Description: 테스트/벤치마크 공용 검사 매크로, 기준 CRC와 시간 측정
+ */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static int host_test_failures = 0;
+
+// 실패해도 계속 진행하고 마지막에 main이 실패 수로 종료 코드 결정
+#define CHECK(cond) do { \
+	if (!(cond)) { \
+		fprintf(stderr, "%s:%d: CHECK(%s) 실패\n", __FILE__, __LINE__, #cond); \
+		host_test_failures++; \
+	} \
+} while (0)
+
+// 기대 바이트열 비교 (다르면 두 바이트열을 모두 출력)
+static inline int host_check_bytes(const char *what, const uint8_t *got, uint16_t got_len,
+		const uint8_t *want, uint16_t want_len) {
+	int same = (got_len == want_len);
+	for (uint16_t i = 0; same && i < got_len; i++)
+		same = (got[i] == want[i]);
+	if (!same) {
+		fprintf(stderr, "%s: 바이트열 불일치\n  got :", what);
+		for (uint16_t i = 0; i < got_len; i++)
+			fprintf(stderr, " %02X", got[i]);
+		fprintf(stderr, "\n  want:");
+		for (uint16_t i = 0; i < want_len; i++)
+			fprintf(stderr, " %02X", want[i]);
+		fprintf(stderr, "\n");
+		host_test_failures++;
+	}
+	return same;
+}
+
+// 기준 CRC-16 (다항식 0x8005, 비반사, 비트 단위 - dxl_crc 테이블/주변장치와 독립)
+static inline uint16_t host_ref_crc(uint16_t crc, const uint8_t *data, uint16_t len) {
+	while (len--) {
+		crc ^= (uint16_t) (*data++ << 8);
+		for (int b = 0; b < 8; b++)
+			crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x8005) : (uint16_t) (crc << 1);
+	}
+	return crc;
+}
+
+static inline uint64_t host_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,128 @@
+/*
+ * stm32h7xx_hal.h (호스트 테스트용)
+ * Description: Core/Inc/main.h가 포함하는 HAL 헤더를 PC에서 대신하는 최소 정의
+ * Core/Src 모듈을 수정 없이 gcc/g++로 빌드하기 위해 쓰는 타입/레지스터/매크로만 둠
+ * Note: 주변장치 레지스터는 메모리 변수 (host_hal.c), WRITE_REG로 들어오는 쓰기 중
+ *       CRC 주변장치 레지스터는 host_hal.c의 CRC 모델이 처리 (dxl_crc 하드웨어 백엔드가 호스트에서도 동작)
+ * Note: DWT->CYCCNT는 테스트가 직접 올리는 값 (시간 측정은 각 벤치마크가 clock_gettime으로 함)
+ */
+
+#ifndef HOST_STM32H7XX_HAL_H_
+#define HOST_STM32H7XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __IO volatile
+
+// 레지스터 접근 (CMSIS와 같은 이름): 쓰기는 크기와 함께 host_write_reg로 넘겨 주변장치 모델이 처리
+void host_write_reg(volatile void *reg, size_t size, uint32_t value);
+#define WRITE_REG(REG, VAL) host_write_reg(&(REG), sizeof(REG), (uint32_t) (VAL))
+#define READ_REG(REG)       ((REG))
+
+typedef enum {
+	HAL_OK = 0x00,
+	HAL_ERROR = 0x01,
+	HAL_BUSY = 0x02,
+	HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+// ---------------------------------------------------------------------------
+// GPIO / UART (헤더의 선언과 핀 정의만 만족)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+	__IO uint32_t ODR;
+} GPIO_TypeDef;
+
+#define GPIO_PIN_4  ((uint16_t) 0x0010)
+#define GPIO_PIN_12 ((uint16_t) 0x1000)
+
+extern GPIO_TypeDef host_gpioa, host_gpiob;
+#define GPIOA (&host_gpioa)
+#define GPIOB (&host_gpiob)
+
+typedef struct {
+	uint32_t BaudRate;
+	uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct {
+	void *Instance;
+	UART_InitTypeDef Init;
+} UART_HandleTypeDef;
+
+// ---------------------------------------------------------------------------
+// CRC 주변장치 (dxl_crc 하드웨어 백엔드)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+	__IO uint32_t DR;
+	__IO uint32_t IDR;
+	__IO uint32_t CR;
+	uint32_t RESERVED;
+	__IO uint32_t INIT;
+	__IO uint32_t POL;
+} CRC_TypeDef;
+
+extern CRC_TypeDef host_crc;
+#define CRC (&host_crc)
+#define CRC_CR_RESET      (1u << 0)
+#define CRC_CR_POLYSIZE_0 (1u << 3)
+#define CRC_CR_POLYSIZE   (3u << 3)
+#define CRC_CR_REV_IN     (3u << 5)
+#define CRC_CR_REV_OUT    (1u << 7)
+
+#define __HAL_RCC_CRC_CLK_ENABLE() do { } while (0)
+
+// 1이면 CRC 모델 결과의 최하위 비트를 뒤집음 (자체 검증 실패 -> 소프트웨어 백엔드 경로 확인용)
+extern uint8_t host_crc_fault;
+
+// ---------------------------------------------------------------------------
+// 코어 (인터럽트 마스크, 비트 연산, DWT 사이클 카운터)
+// ---------------------------------------------------------------------------
+
+extern uint32_t host_primask;
+static inline uint32_t __get_PRIMASK(void) { return host_primask; }
+static inline void __set_PRIMASK(uint32_t v) { host_primask = v; }
+static inline void __disable_irq(void) { host_primask = 1; }
+static inline void __enable_irq(void) { host_primask = 0; }
+static inline uint32_t __REV(uint32_t v) { return __builtin_bswap32(v); }
+static inline uint32_t __CLZ(uint32_t v) { return v ? (uint32_t) __builtin_clz(v) : 32u; }
+
+typedef struct {
+	__IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+	__IO uint32_t CTRL;
+	__IO uint32_t CYCCNT;
+	__IO uint32_t LAR;
+} DWT_Type;
+
+extern CoreDebug_Type host_core_debug;
+extern DWT_Type host_dwt;
+#define CoreDebug (&host_core_debug)
+#define DWT (&host_dwt)
+#define CoreDebug_DEMCR_TRCENA_Msk (1u << 24)
+#define DWT_CTRL_CYCCNTENA_Msk     (1u << 0)
+
+extern uint32_t SystemCoreClock;
+
+// ---------------------------------------------------------------------------
+// 시간 (host_tick을 테스트가 직접 진행, HAL_Delay는 그만큼 더함)
+// ---------------------------------------------------------------------------
+
+extern uint32_t host_tick;
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t delay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_STM32H7XX_HAL_H_ */
@@ -0,0 +1,169 @@
+/*
+ * test_dxl_crc.c
+ * Description: dxl_crc 소프트웨어 엔진(바이트/slice-by-4/slice-by-8)을 비트 단위 기준 CRC와 비교하고,
+ * CRC 주변장치 백엔드(호스트 주변장치 모델)를 slice-by-8과 비교
+ * 기준: CRC-16/BUYPASS (다항식 0x8005, 비반사, 최종 XOR 없음) - DYNAMIXEL 2.0 CRC와 같은 정의
+ * Note: 주변장치 모델은 RM0433의 동작(RESET 시 INIT 적재, 쓰기 크기만큼 상위 바이트부터 처리)을 따름
+ *       보드 주변장치 자체의 검증은 부팅 시 DXL_CRC_Init의 자체 검증이 담당
+ */
+#include "dxl_crc.h"
+#include "host_test.h"
+#include <string.h>
+
+typedef uint16_t (*crc_fn_t)(uint16_t, const uint8_t*, uint16_t);
+
+static const struct {
+	const char *name;
+	crc_fn_t fn;
+} engines[] = {
+		{ "byte", DXL_CRC_Update_Byte },
+		{ "slice4", DXL_CRC_Update_Slice4 },
+		{ "slice8", DXL_CRC_Update_Slice8 },
+		{ "update", DXL_CRC_Update },
+};
+#define ENGINE_COUNT (sizeof(engines) / sizeof(engines[0]))
+
+static uint32_t rng = 0xC0FFEEu;
+
+static uint8_t next_byte(void) {
+	rng = rng * 1103515245u + 12345u;
+	return (uint8_t) (rng >> 16);
+}
+
+// 알려진 값: 표준 검사 문자열과 e-Manual의 Ping 예제 패킷
+static void test_known_vectors(void) {
+	static const uint8_t check[] = "123456789";
+	static const uint8_t ping[] = { 0xFF, 0xFF, 0xFD, 0x00, 0x01, 0x03, 0x00, 0x01 };
+
+	CHECK(host_ref_crc(0, check, 9) == 0xFEE8);
+	CHECK(host_ref_crc(0, ping, sizeof(ping)) == 0x4E19);
+	for (unsigned e = 0; e < ENGINE_COUNT; e++) {
+		CHECK(engines[e].fn(0, check, 9) == 0xFEE8);
+		CHECK(engines[e].fn(0, ping, sizeof(ping)) == 0x4E19);
+		CHECK(engines[e].fn(0x1234, check, 0) == 0x1234);
+	}
+}
+
+// 테이블 k번째 = 바이트 v 뒤에 0x00이 k개 이어질 때의 CRC
+static void test_tables(void) {
+	uint8_t buf[8] = { 0, };
+	for (int k = 0; k < 8; k++) {
+		for (int v = 0; v < 256; v++) {
+			buf[0] = (uint8_t) v;
+			if (dxl_crc_table[k][v] != host_ref_crc(0, buf, (uint16_t) (k + 1))) {
+				fprintf(stderr, "table[%d][0x%02X] = 0x%04X, 기준 0x%04X\n", k, v,
+						dxl_crc_table[k][v], host_ref_crc(0, buf, (uint16_t) (k + 1)));
+				host_test_failures++;
+			}
+		}
+	}
+}
+
+// 길이 0~300, 시작 정렬 0~7, 여러 초기값에서 모든 엔진이 기준과 같은지
+static void test_lengths_and_alignment(void) {
+	static uint8_t buf[300 + 8];
+	for (unsigned i = 0; i < sizeof(buf); i++)
+		buf[i] = next_byte();
+
+	for (uint16_t off = 0; off < 8; off++) {
+		for (uint16_t len = 0; len <= 300; len++) {
+			uint16_t init = (uint16_t) (len * 0x1021u + off);
+			uint16_t want = host_ref_crc(init, &buf[off], len);
+			for (unsigned e = 0; e < ENGINE_COUNT; e++) {
+				uint16_t got = engines[e].fn(init, &buf[off], len);
+				if (got != want) {
+					fprintf(stderr, "%s: off=%u len=%u init=0x%04X -> 0x%04X, 기준 0x%04X\n",
+							engines[e].name, off, len, init, got, want);
+					host_test_failures++;
+				}
+			}
+		}
+	}
+}
+
+// 나눠서 계산해도 같은 결과 (송신 경로는 헤더/데이터를 이어서 계산)
+static void test_split(void) {
+	uint8_t buf[96];
+	for (unsigned i = 0; i < sizeof(buf); i++)
+		buf[i] = next_byte();
+
+	uint16_t want = host_ref_crc(0, buf, sizeof(buf));
+	for (uint16_t cut = 0; cut <= sizeof(buf); cut++) {
+		for (unsigned e = 0; e < ENGINE_COUNT; e++) {
+			uint16_t crc = engines[e].fn(0, buf, cut);
+			crc = engines[e].fn(crc, &buf[cut], (uint16_t) (sizeof(buf) - cut));
+			CHECK(crc == want);
+		}
+	}
+}
+
+// 무작위 길이/내용 (FF FF FD 같은 헤더 패턴이 섞이도록 일부 바이트는 0xFF/0xFD로 고정)
+static void test_random(void) {
+	uint8_t buf[1024];
+	for (int r = 0; r < 20000; r++) {
+		uint16_t len = (uint16_t) (next_byte() | (next_byte() << 8)) % sizeof(buf);
+		for (uint16_t i = 0; i < len; i++) {
+			uint8_t v = next_byte();
+			buf[i] = (v < 0x20) ? 0xFF : (v < 0x30) ? 0xFD : v;
+		}
+		uint16_t init = (uint16_t) (next_byte() << 8 | next_byte());
+		uint16_t want = host_ref_crc(init, buf, len);
+		for (unsigned e = 0; e < ENGINE_COUNT; e++)
+			CHECK(engines[e].fn(init, buf, len) == want);
+	}
+}
+
+// CRC 주변장치 백엔드 (host_hal.c의 주변장치 모델: 32비트 DR 쓰기 = 상위 바이트부터 4바이트, 8비트 쓰기 = 1바이트)
+// 길이를 4로 나눈 나머지 전부, 시작 정렬 0~3에서 slice-by-8과 같은지 (__REV 바이트 순서, 8비트 나머지 쓰기, INIT 적재)
+static void test_hw_backend(void) {
+	static const uint8_t check[] = "123456789";
+	uint8_t buf[260 + 4];
+
+	CHECK(DXL_CRC_Init() == DXL_CRC_BACKEND_HW);
+	CHECK(DXL_CRC_Get_Backend() == DXL_CRC_BACKEND_HW);
+	uint32_t calls = DXL_CRC_Get_Stats().hw_calls;
+	CHECK(DXL_CRC_HW_Update(0, check, 9) == 0xFEE8);
+
+	for (int r = 0; r < 4000; r++) {
+		uint16_t off = (uint16_t) (r & 3);
+		uint16_t len = (uint16_t) ((r / 4) % 260);
+		for (uint16_t i = 0; i < len; i++)
+			buf[off + i] = next_byte();
+		uint16_t init = (uint16_t) (next_byte() << 8 | next_byte());
+		uint16_t want = DXL_CRC_Update_Slice8(init, &buf[off], len);
+		uint16_t got = DXL_CRC_HW_Update(init, &buf[off], len);
+		if (got != want) {
+			fprintf(stderr, "hw: off=%u len=%u (len%%4=%u) init=0x%04X -> 0x%04X, slice8 0x%04X\n",
+					off, len, len % 4, init, got, want);
+			host_test_failures++;
+		}
+		CHECK(DXL_CRC_Update(init, &buf[off], len) == want); // 기본 경로도 주변장치 사용
+	}
+	CHECK(DXL_CRC_Get_Stats().hw_calls == calls + 1 + 2 * 4000);
+	CHECK(DXL_CRC_Get_Stats().sw_fallbacks == 0);
+}
+
+// 주변장치 결과가 틀리면 자체 검증에서 걸러 소프트웨어 백엔드로 남고, 하드웨어 함수는 소프트웨어로 대체
+static void test_hw_self_test_fail(void) {
+	static const uint8_t check[] = "123456789";
+
+	host_crc_fault = 1;
+	CHECK(DXL_CRC_Init() == DXL_CRC_BACKEND_SW);
+	CHECK(DXL_CRC_HW_Update(0, check, 9) == 0xFEE8);
+	CHECK(DXL_CRC_Update(0, check, 9) == 0xFEE8);
+	CHECK(DXL_CRC_Get_Stats().sw_fallbacks == 1);
+	host_crc_fault = 0;
+}
+
+int main(void) {
+	test_known_vectors();
+	test_tables();
+	test_lengths_and_alignment();
+	test_split();
+	test_random();
+	test_hw_backend();
+	test_hw_self_test_fail();
+
+	printf("test_dxl_crc: %s\n", host_test_failures ? "FAIL" : "OK");
+	return host_test_failures != 0;
+}
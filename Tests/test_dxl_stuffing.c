@@ -0,0 +1,299 @@
+/*
+ * test_dxl_stuffing.c
+ * Description: 2.0 Sync Write 송신 경로(tpl_finish_and_queue / tpl_queue_stuffed)의 바이트 스터핑 검증
+ * 실제 dxl_2_0.c를 빌드해 공개 함수로 패킷을 만들고, 송신 큐에 들어간 바이트를
+ * 독립 기준 인코더(스터핑 + 비트 단위 CRC)와 손으로 적은 기준 바이트열에 비교
+ *   - FF FF FD가 목표값 바이트 안 / 첫 데이터(ID 직후) / 마지막 데이터(CRC 직전) / 필드 경계에 걸친 경우
+ *   - 길이 필드가 스터핑만큼 늘어나는지, 본문의 주소/데이터 길이 필드에 패턴이 있는 경우 (dxl_stuff_copy)
+ *   - DXL_STUFF_FREE_LIMIT 미만은 스터핑 검사를 생략해도 되는지 (무작위 값으로 기준과 비교)
+ */
+#include "dxl_2_0.h"
+#include "host_bus.h"
+#include "host_test.h"
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+// 기준 인코더 (dxl_2_0.c와 독립)
+// ---------------------------------------------------------------------------
+
+// 출력 끝 3바이트가 FF FF FD가 될 때마다 FD 추가
+static uint16_t ref_stuff(uint8_t *out, const uint8_t *in, uint16_t len) {
+	uint16_t k = 0;
+	for (uint16_t i = 0; i < len; i++) {
+		out[k++] = in[i];
+		if (k >= 3 && out[k - 3] == 0xFF && out[k - 2] == 0xFF && out[k - 1] == 0xFD)
+			out[k++] = 0xFD;
+	}
+	return k;
+}
+
+// Sync Write: data는 모터마다 size바이트씩 이어 붙인 값
+static uint16_t ref_sync_write(uint8_t *out, uint16_t addr, uint8_t size, const uint8_t *ids,
+		const uint8_t *data, uint8_t count) {
+	uint8_t body[512];
+	uint16_t n = 0;
+	body[n++] = 0x83;
+	body[n++] = (uint8_t) addr;
+	body[n++] = (uint8_t) (addr >> 8);
+	body[n++] = size;
+	body[n++] = 0x00;
+	for (uint8_t i = 0; i < count; i++) {
+		body[n++] = ids[i];
+		memcpy(&body[n], &data[i * size], size);
+		n += size;
+	}
+
+	uint16_t k = 7 + ref_stuff(&out[7], body, n);
+	uint16_t len = (uint16_t) (k - 7 + 2);
+	out[0] = 0xFF;
+	out[1] = 0xFF;
+	out[2] = 0xFD;
+	out[3] = 0x00;
+	out[4] = 0xFE;
+	out[5] = (uint8_t) len;
+	out[6] = (uint8_t) (len >> 8);
+	uint16_t crc = host_ref_crc(0, out, k);
+	out[k++] = (uint8_t) crc;
+	out[k++] = (uint8_t) (crc >> 8);
+	return k;
+}
+
+static void le32(uint8_t *d, uint32_t v) {
+	for (int b = 0; b < 4; b++)
+		d[b] = (uint8_t) (v >> (8 * b));
+}
+
+// 송신 큐에 정확히 패킷 1개가 들어갔고 기준과 같은지
+static void expect_one(const char *what, const uint8_t *want, uint16_t want_len) {
+	CHECK(host_bus_frames == 1);
+	CHECK(host_bus_slot_overflows == 0);
+	host_check_bytes(what, host_bus_tx, host_bus_tx_len, want, want_len);
+	host_bus_reset();
+}
+
+static uint32_t rng = 0x5EEDu;
+
+static uint8_t next_byte(void) {
+	rng = rng * 1103515245u + 12345u;
+	return (uint8_t) (rng >> 16);
+}
+
+// 패턴이 자주 나오도록 FF/FD/00에 몰린 바이트
+static uint8_t pattern_byte(void) {
+	uint8_t v = next_byte();
+	return (v < 0x50) ? 0xFF : (v < 0x90) ? 0xFD : (v < 0xA0) ? 0x00 : next_byte();
+}
+
+// ---------------------------------------------------------------------------
+// 1. dxl_stuff_copy (tpl_queue_stuffed가 INST ~ 마지막 데이터 구간에 사용)
+// ---------------------------------------------------------------------------
+
+static void test_stuff_copy(void) {
+	static const struct {
+		const char *name;
+		uint8_t in[12], in_len;
+		uint8_t out[16], out_len;
+	} cases[] = {
+		// 본문 주소 0xFFFF + 데이터 길이 0x00FD: Sync Write 길이 필드 안의 패턴
+		{ "addr/length field", { 0x83, 0xFF, 0xFF, 0xFD, 0x00, 0x01 }, 6,
+				{ 0x83, 0xFF, 0xFF, 0xFD, 0xFD, 0x00, 0x01 }, 7 },
+		{ "back to back", { 0xFF, 0xFF, 0xFD, 0xFF, 0xFF, 0xFD }, 6,
+				{ 0xFF, 0xFF, 0xFD, 0xFD, 0xFF, 0xFF, 0xFD, 0xFD }, 8 },
+		{ "leading FF", { 0xFF, 0xFF, 0xFF, 0xFD, 0x00 }, 5,
+				{ 0xFF, 0xFF, 0xFF, 0xFD, 0xFD, 0x00 }, 6 },
+		{ "FD after pattern", { 0xFF, 0xFF, 0xFD, 0xFD }, 4,
+				{ 0xFF, 0xFF, 0xFD, 0xFD, 0xFD }, 5 },
+		{ "pattern at end", { 0x01, 0xFF, 0xFF, 0xFD }, 4,
+				{ 0x01, 0xFF, 0xFF, 0xFD, 0xFD }, 5 },
+		{ "broken pattern", { 0xFF, 0xFD, 0xFF, 0xFF, 0x00, 0xFD }, 6,
+				{ 0xFF, 0xFD, 0xFF, 0xFF, 0x00, 0xFD }, 6 },
+	};
+
+	for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		uint8_t out[32];
+		uint16_t n = dxl_stuff_copy(out, cases[c].in, cases[c].in_len);
+		host_check_bytes(cases[c].name, out, n, cases[c].out, cases[c].out_len);
+	}
+
+	// 무작위: 기준과 같고, 출력이 len + len/3을 넘지 않음 (호출자의 버퍼 크기 계산 근거)
+	for (int r = 0; r < 20000; r++) {
+		uint8_t in[96], out[128], want[128];
+		uint16_t len = next_byte() % sizeof(in);
+		for (uint16_t i = 0; i < len; i++)
+			in[i] = pattern_byte();
+		uint16_t n = dxl_stuff_copy(out, in, len);
+		uint16_t m = ref_stuff(want, in, len);
+		CHECK(n <= len + len / 3);
+		if (!host_check_bytes("random stuff_copy", out, n, want, m))
+			break;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// 2. 관절 목표 위치 Sync Write (DXL_STUFF_FREE_LIMIT 이상이면 스터핑 경로)
+// ---------------------------------------------------------------------------
+
+static void check_joints(const char *what, const uint32_t *goals) {
+	uint8_t data[JOINT_COUNT * 4], want[256];
+	for (int j = 0; j < JOINT_COUNT; j++)
+		le32(&data[j * 4], goals[j]);
+	uint16_t n = ref_sync_write(want, DXL_JOINT_ADDR(GOAL_POSITION), 4, robot_joint_ids, data, JOINT_COUNT);
+
+	send_sync_write_joints(goals);
+	expect_one(what, want, n);
+}
+
+static void test_joint_goals(void) {
+	uint32_t goals[JOINT_COUNT];
+
+	for (int j = 0; j < JOINT_COUNT; j++)
+		goals[j] = 2048;
+	check_joints("joints normal", goals);
+
+	// 첫 관절 데이터가 FF FF FD로 시작 (ID 직후)
+	goals[0] = 0x00FDFFFF;
+	check_joints("joints first data", goals);
+
+	// 마지막 관절 데이터가 FF FF FD로 끝남 (CRC 직전에 스터핑 바이트)
+	goals[0] = 2048;
+	goals[JOINT_COUNT - 1] = 0xFDFFFF00;
+	check_joints("joints last data", goals);
+
+	// FF FF FD FF: 패턴 뒤에 FF가 이어져도 스터핑 1바이트
+	goals[JOINT_COUNT - 1] = 0xFFFDFFFF;
+	check_joints("joints FF FF FD FF", goals);
+
+	// 모든 관절에 패턴: 길이 필드가 관절 수만큼 늘어나고 스케줄러 비용(최악의 경우) 안에 들어가야 함
+	for (int j = 0; j < JOINT_COUNT; j++)
+		goals[j] = 0x00FDFFFF;
+	check_joints("joints all stuffed", goals);
+	send_sync_write_joints(goals);
+	CHECK(host_bus_tx[5] == (uint8_t) (7 + JOINT_COUNT * 5 + JOINT_COUNT));
+	CHECK(host_bus_tx_len <= DXL_Get_Joint_Write_Cost().tx_bytes);
+	host_bus_reset();
+
+	// 제한 바로 아래 값은 빠른 경로 (패턴이 없어야 함)
+	for (int j = 0; j < JOINT_COUNT; j++)
+		goals[j] = DXL_STUFF_FREE_LIMIT - 1;
+	check_joints("joints below limit", goals);
+
+	// 무작위 값 (제한 미만/이상 섞임): 빠른 경로가 스터핑을 놓치지 않는지
+	for (int r = 0; r < 5000; r++) {
+		for (int j = 0; j < JOINT_COUNT; j++) {
+			uint8_t b[4];
+			for (int k = 0; k < 4; k++)
+				b[k] = pattern_byte();
+			goals[j] = (next_byte() & 1) ? (uint32_t) (b[0] | b[1] << 8 | b[2] << 16) // 3바이트 (제한 근처)
+					: (uint32_t) (b[0] | b[1] << 8 | b[2] << 16 | (uint32_t) b[3] << 24);
+		}
+		check_joints("joints random", goals);
+	}
+}
+
+// 일부 관절 Sync Write (부팅 시 템플릿이 아닌 임시 템플릿 경로)
+static void test_joint_subset(void) {
+	uint32_t pos[JOINT_COUNT];
+	const uint8_t joints[2] = { 0, JOINT_COUNT - 1 };
+	uint8_t ids[2] = { robot_joint_ids[0], robot_joint_ids[JOINT_COUNT - 1] };
+	uint8_t data[8], want[64];
+
+	for (int j = 0; j < JOINT_COUNT; j++)
+		pos[j] = 1000;
+	pos[0] = 0xFDFFFF00;
+	pos[JOINT_COUNT - 1] = 0x00FDFFFF;
+	le32(&data[0], pos[0]);
+	le32(&data[4], pos[JOINT_COUNT - 1]);
+	uint16_t n = ref_sync_write(want, DXL_JOINT_ADDR(GOAL_POSITION), 4, ids, data, 2);
+
+	send_sync_write_joints_subset(joints, pos, 2);
+	expect_one("joints subset", want, n);
+}
+
+// ---------------------------------------------------------------------------
+// 3. 프로파일 Sync Write: 가속도(4) + 속도(4) 필드 경계에 걸친 패턴
+// ---------------------------------------------------------------------------
+
+static void test_profile_boundary(void) {
+	DXL_Joint_Command_t cmd[JOINT_COUNT] = { 0, };
+	const uint8_t joints[1] = { 1 };
+	uint8_t data[8], want[64];
+
+	cmd[1].profile_acceleration = 0xFFFF0000; // ... FF FF | FD ...
+	cmd[1].profile_velocity = 0x000000FD;
+	le32(&data[0], cmd[1].profile_acceleration);
+	le32(&data[4], cmd[1].profile_velocity);
+	uint16_t n = ref_sync_write(want, DXL_JOINT_ADDR(PROFILE_ACCELERATION), 8, &robot_joint_ids[1], data, 1);
+
+	send_sync_write_joint_profiles_subset(joints, cmd, 1);
+	expect_one("profile field boundary", want, n);
+}
+
+// ---------------------------------------------------------------------------
+// 4. 등록부 기반 범용 Sync Write + 손으로 적은 기준 바이트열
+// ---------------------------------------------------------------------------
+
+static void test_generic_reference_bytes(void) {
+	// ID 1 Goal Position(116) = 0x00FDFFFF
+	// 본문 83 74 00 04 00 01 FF FF FD [FD] 00 (11바이트) -> 길이 = 11 + 2 = 0x0D
+	static const uint8_t want_one[] = {
+			0xFF, 0xFF, 0xFD, 0x00, 0xFE, 0x0D, 0x00,
+			0x83, 0x74, 0x00, 0x04, 0x00,
+			0x01, 0xFF, 0xFF, 0xFD, 0xFD, 0x00,
+			0x62, 0x86 };
+	// ID 1, 2 Goal Position = 0xFDFFFF00, 0xFFFDFFFF
+	// 두 모터 모두 패턴 1개씩 -> 본문 5 + 2 * 5 + 2 = 17바이트, 길이 = 0x13
+	static const uint8_t want_two[] = {
+			0xFF, 0xFF, 0xFD, 0x00, 0xFE, 0x13, 0x00,
+			0x83, 0x74, 0x00, 0x04, 0x00,
+			0x01, 0x00, 0xFF, 0xFF, 0xFD, 0xFD,
+			0x02, 0xFF, 0xFF, 0xFD, 0xFD, 0xFF,
+			0xFA, 0x7A };
+	const uint8_t ids[2] = { 1, 2 };
+	int32_t one[1] = { 0x00FDFFFF };
+	int32_t two[2] = { (int32_t) 0xFDFFFF00, (int32_t) 0xFFFDFFFF };
+	uint8_t data[8], want[64];
+
+	// 기준 인코더 자체도 손으로 적은 값과 같아야 함
+	le32(&data[0], (uint32_t) one[0]);
+	uint16_t n = ref_sync_write(want, 116, 4, ids, data, 1);
+	host_check_bytes("reference encoder (1)", want, n, want_one, sizeof(want_one));
+	le32(&data[0], (uint32_t) two[0]);
+	le32(&data[4], (uint32_t) two[1]);
+	n = ref_sync_write(want, 116, 4, ids, data, 2);
+	host_check_bytes("reference encoder (2)", want, n, want_two, sizeof(want_two));
+
+	CHECK(dxl_sync_write(DXL_MODEL_MX106, DXL_FIELD_GOAL_POSITION, ids, one, 1) == HAL_OK);
+	expect_one("generic write (1)", want_one, sizeof(want_one));
+	CHECK(dxl_sync_write(DXL_MODEL_MX106, DXL_FIELD_GOAL_POSITION, ids, two, 2) == HAL_OK);
+	expect_one("generic write (2)", want_two, sizeof(want_two));
+
+	// 무작위 ID 수/값 (ID는 0xFC 이하 - FD가 ID 자리에 올 수 없음)
+	for (int r = 0; r < 5000; r++) {
+		uint8_t count = (uint8_t) (1 + next_byte() % 26), rid[26];
+		int32_t v[26];
+		uint8_t d[26 * 4], w[256];
+		for (uint8_t i = 0; i < count; i++) {
+			rid[i] = (uint8_t) (next_byte() % 0xFD);
+			for (int k = 0; k < 4; k++)
+				d[i * 4 + k] = pattern_byte();
+			v[i] = (int32_t) (d[i * 4] | d[i * 4 + 1] << 8 | d[i * 4 + 2] << 16 | (uint32_t) d[i * 4 + 3] << 24);
+		}
+		uint16_t m = ref_sync_write(w, 116, 4, rid, d, count);
+		CHECK(dxl_sync_write(DXL_MODEL_MX106, DXL_FIELD_GOAL_POSITION, rid, v, count) == HAL_OK);
+		expect_one("generic write random", w, m);
+	}
+}
+
+int main(void) {
+	DXL_Init();
+	host_bus_reset();
+
+	test_stuff_copy();
+	test_joint_goals();
+	test_joint_subset();
+	test_profile_boundary();
+	test_generic_reference_bytes();
+
+	printf("test_dxl_stuffing: %s\n", host_test_failures ? "FAIL" : "OK");
+	return host_test_failures != 0;
+}
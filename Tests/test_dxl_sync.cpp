@@ -0,0 +1,178 @@
+/*
+ * test_dxl_sync.cpp
+ * Description: dxl_sync.hpp(C++17)의 SyncWrite<> / SyncRead<>를 실제로 인스턴스화해
+ * C 경로(dxl_2_0.c의 부팅 시 템플릿)와 송신 바이트를 비교 (시간 비교는 bench_dxl_sync.cpp)
+ */
+#include "dxl_sync.hpp"
+#include <cstdio>
+
+extern "C" {
+#include "host_bus.h"
+#include "host_test.h"
+}
+
+using namespace dxl;
+
+static uint32_t rng = 0xACE1u;
+
+static uint32_t next_u32() {
+	rng ^= rng << 13;
+	rng ^= rng >> 17;
+	rng ^= rng << 5;
+	return rng;
+}
+
+// C 경로로 큐에 넣은 바이트를 보관하고, C++ 경로 결과와 비교
+static uint8_t c_frame[HOST_BUS_TX_SIZE];
+static uint16_t c_len;
+
+static void keep_c_frame() {
+	CHECK(host_bus_frames == 1);
+	std::memcpy(c_frame, host_bus_tx, host_bus_tx_len);
+	c_len = host_bus_tx_len;
+	host_bus_reset();
+}
+
+static bool same_as_c(const char *what) {
+	CHECK(host_bus_frames == 1);
+	CHECK(host_bus_slot_overflows == 0);
+	bool ok = host_check_bytes(what, host_bus_tx, host_bus_tx_len, c_frame, c_len);
+	host_bus_reset();
+	return ok;
+}
+
+// 관절 목표 위치: 정상 범위 / 스터핑이 필요한 값 / 무작위 32비트
+static void test_joint_position() {
+	uint32_t goals[JOINT_COUNT];
+	Ticks t[JOINT_COUNT];
+
+	for (int r = 0; r < 20000; r++) {
+		for (int j = 0; j < JOINT_COUNT; j++) {
+			uint32_t v = next_u32();
+			switch (r % 4) {
+			case 0: goals[j] = v % 4096; break;
+			case 1: goals[j] = (v & 1) ? 0x00FDFFFFu : 0xFDFFFF00u | (v >> 24); break;
+			case 2: goals[j] = DXL_STUFF_FREE_LIMIT - 1 - (v % 2); break;
+			default: goals[j] = v; break;
+			}
+			t[j] = Ticks { static_cast<int32_t>(goals[j]) };
+		}
+		send_sync_write_joints(goals);
+		keep_c_frame();
+
+		JointPositionWrite w;
+		w.set_all(t);
+		CHECK(w.queue() == HAL_OK);
+		if (!same_as_c("JointPositionWrite"))
+			break;
+	}
+}
+
+// 바퀴 속도 (1.0 체크섬): Rpm -> 원시값 변환이 clc_speed_1과 같은지까지 포함
+static void test_wheel_speed() {
+	int16_t speeds[LEG_COUNT];
+	Rpm rpm[LEG_COUNT];
+
+	for (int r = 0; r < 20000; r++) {
+		for (int i = 0; i < LEG_COUNT; i++) {
+			speeds[i] = static_cast<int16_t>(static_cast<int32_t>(next_u32() % 2047) - 1023);
+			rpm[i] = Rpm { speeds[i] * 0.111f };
+		}
+		send_sync_write_1_wheel(speeds);
+		keep_c_frame();
+
+		WheelSpeedWrite w;
+		w.set_all(rpm);
+		CHECK(w.queue() == HAL_OK);
+		if (!same_as_c("WheelSpeedWrite"))
+			break;
+	}
+}
+
+// 토크 ON/OFF (관절 2.0 / 바퀴 1.0)
+static void test_torque() {
+	for (int on = 0; on <= 1; on++) {
+		send_sync_torque_mx(static_cast<uint8_t>(on));
+		keep_c_frame();
+		JointTorqueWrite jt;
+		for (std::size_t i = 0; i < JointTorqueWrite::kCount; i++)
+			jt.set(i, Enable { on != 0 });
+		jt.queue();
+		same_as_c("JointTorqueWrite");
+
+		send_sync_torque_ax(static_cast<uint8_t>(on));
+		keep_c_frame();
+		WheelTorqueWrite wt;
+		for (std::size_t i = 0; i < WheelTorqueWrite::kCount; i++)
+			wt.set(i, Enable { on != 0 });
+		wt.queue();
+		same_as_c("WheelTorqueWrite");
+	}
+}
+
+// 관절 상태 Sync Read 요청: 컴파일 시점에 만든 패킷을 손으로 조립한 요청과 비교
+static void test_state_read() {
+	uint8_t want[JointStateRead::kLen];
+	uint16_t k = 0;
+	want[k++] = 0xFF; want[k++] = 0xFF; want[k++] = 0xFD; want[k++] = 0x00;
+	want[k++] = 0xFE;
+	want[k++] = 7 + JOINT_COUNT; want[k++] = 0;
+	want[k++] = 0x82;
+	want[k++] = static_cast<uint8_t>(JointState::addr); want[k++] = static_cast<uint8_t>(JointState::addr >> 8);
+	want[k++] = JointState::size; want[k++] = 0;
+	for (int j = 0; j < JOINT_COUNT; j++)
+		want[k++] = robot_joint_ids[j];
+	uint16_t crc = host_ref_crc(0, want, k);
+	want[k++] = static_cast<uint8_t>(crc);
+	want[k++] = static_cast<uint8_t>(crc >> 8);
+
+	CHECK(JointStateRead::queue() == HAL_OK);
+	CHECK(host_bus_frames == 1);
+	host_check_bytes("JointStateRead", host_bus_tx, host_bus_tx_len, want, k);
+	host_bus_reset();
+}
+
+// 일부 모터만 다시 기록: 이전 queue()에서 기록한 스터핑 필요 값이 버퍼에 남아 있으면 이번에도 스터핑해야 함
+static void test_partial_set() {
+	uint32_t goals[JOINT_COUNT];
+	JointPositionWrite w;
+
+	for (int j = 0; j < JOINT_COUNT; j++) {
+		goals[j] = (j == JOINT_COUNT - 1) ? 0xFDFFFF00u : 2048;
+		w.set(static_cast<std::size_t>(j), Ticks { static_cast<int32_t>(goals[j]) });
+	}
+	CHECK(w.queue() == HAL_OK);
+	host_bus_reset();
+
+	goals[0] = 1024;
+	w.set(0, Ticks { 1024 });
+	send_sync_write_joints(goals);
+	keep_c_frame();
+	CHECK(w.queue() == HAL_OK);
+	same_as_c("JointPositionWrite (일부만 set)");
+}
+
+// 보드용 벤치마크가 같은 코드로 빌드/실행되는지 (반복마다 C/C++ 패킷 1개씩, 호스트 DWT는 0이므로 사이클 값은 의미 없음)
+static void test_bench_entry() {
+	uint32_t goals[JOINT_COUNT];
+	for (int j = 0; j < JOINT_COUNT; j++)
+		goals[j] = 2048 + 10 * j;
+	bench_joint_write(goals, 2);
+	CHECK(host_bus_frames == 4);
+	host_bus_reset();
+}
+
+int main() {
+	DXL_Init();
+	host_bus_reset();
+
+	test_joint_position();
+	test_wheel_speed();
+	test_torque();
+	test_state_read();
+	test_partial_set();
+	test_bench_entry();
+
+	std::printf("test_dxl_sync: %s\n", host_test_failures ? "FAIL" : "OK");
+	return host_test_failures != 0;
+}